@@ -42,6 +42,7 @@ namespace App
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "UIManager Initialized.");
 
         m_gameLauncher.Initialize();
+        m_uiManager.SetGameLauncher(&m_gameLauncher);
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "GameLauncher Initialized.");
 
         m_isRunning = true;
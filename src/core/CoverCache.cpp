@@ -0,0 +1,324 @@
+#include "pch.h"
+#include "Core/CoverCache.h"
+#include "Core/MappedFile.h"
+#include "Core/TextFold.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "../stb_image.h"
+#include "../stb_image_resize2.h"
+
+namespace Core
+{
+
+    static const char *COVER_EXTENSIONS[] = {".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif"};
+    static const char *COVER_STEMS[] = {"cover", "boxart", "box", "front", "folder"}; // Most specific first
+    static const int MAX_SOURCE_DIMENSION = 8192;
+
+    // A game name as a file name: characters Windows rejects become '_'
+    static std::string CoverFileStem(const char *name)
+    {
+        std::string stem(name);
+        for (char &c : stem)
+        {
+            if ((unsigned char)c < 0x20 || std::strchr("<>:\"/\\|?*", c))
+                c = '_';
+        }
+        while (!stem.empty() && (stem.back() == '.' || stem.back() == ' '))
+            stem.pop_back();
+        return stem;
+    }
+
+    CoverCache::~CoverCache()
+    {
+        Stop();
+    }
+
+    // <-- UI Thread -->
+    bool CoverCache::Request(uint64_t id, const char *name, const std::string &folder, CoverRef &out)
+    {
+        Entry &entry = m_entries[id];
+        if (entry.generation == 0 || entry.folder != folder || entry.name != name)
+        {
+            if (entry.texture)
+                m_freeTextures.push_back(entry.texture);
+            entry = Entry();
+            entry.generation = ++m_generation;
+            entry.name = name;
+            entry.folder = folder;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_jobs.push_back(Job{id, entry.generation, m_frame.load(), entry.name, entry.folder});
+            }
+            m_wake.notify_one();
+
+            if (m_workers.empty())
+            {
+                size_t workers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+                for (size_t i = 0; i < workers; ++i)
+                    m_workers.emplace_back(&CoverCache::WorkerMain, this);
+            }
+        }
+
+        entry.lastFrame = m_frame.load();
+        if (entry.state != CoverState::Resident)
+            return false;
+
+        out.texture = (ImTextureID)(intptr_t)entry.texture;
+        // Half a texel short of the edge: a pooled texture may hold a bigger cover beyond it
+        out.uv1 = ImVec2((entry.width - 0.5f) / MAX_WIDTH, (entry.height - 0.5f) / MAX_HEIGHT);
+        out.size = ImVec2((float)entry.width, (float)entry.height);
+        return true;
+    }
+
+    // A pooled texture, a new one while under the budget, or the least recently drawn cover's
+    GLuint CoverCache::TakeTexture()
+    {
+        if (!m_freeTextures.empty())
+        {
+            GLuint texture = m_freeTextures.back();
+            m_freeTextures.pop_back();
+            return texture;
+        }
+
+        if ((m_textures + 1) * TEXTURE_BYTES <= VRAM_BUDGET)
+        {
+            GLuint texture = 0;
+            glGenTextures(1, &texture);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, MAX_WIDTH, MAX_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            m_textures++;
+            return texture;
+        }
+
+        // Anything drawn last frame is likely on screen again this frame
+        uint64_t keepFrom = m_frame.load() - 1;
+        auto victim = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->second.state == CoverState::Resident && it->second.lastFrame < keepFrom &&
+                (victim == m_entries.end() || it->second.lastFrame < victim->second.lastFrame))
+                victim = it;
+        }
+        if (victim == m_entries.end())
+            return 0;
+
+        GLuint texture = victim->second.texture;
+        m_entries.erase(victim);
+        return texture;
+    }
+
+    void CoverCache::Update()
+    {
+        uint64_t frame = ++m_frame;
+
+        std::vector<Result> results;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            results.swap(m_results);
+        }
+
+        for (Result &result : results)
+        {
+            auto it = m_entries.find(result.id);
+            if (it == m_entries.end() || it->second.generation != result.generation)
+                continue;
+
+            Entry &entry = it->second;
+            if (result.skipped)
+            {
+                m_entries.erase(it); // Asked for again if it comes back into view
+                continue;
+            }
+            if (result.pixels.empty())
+            {
+                entry.state = CoverState::Missing;
+                continue;
+            }
+
+            entry.state = CoverState::Decoded;
+            entry.width = result.width;
+            entry.height = result.height;
+            entry.pixels = std::move(result.pixels);
+            m_decoded.push_back(result.id);
+        }
+
+        if (m_decoded.empty())
+            return;
+
+        // Drop what was replaced, or has been off screen too long to be worth a texture
+        size_t kept = 0;
+        for (uint64_t id : m_decoded)
+        {
+            auto it = m_entries.find(id);
+            if (it == m_entries.end() || it->second.state != CoverState::Decoded)
+                continue;
+            if (it->second.lastFrame + STALE_FRAMES < frame)
+            {
+                m_entries.erase(it);
+                continue;
+            }
+            m_decoded[kept++] = id;
+        }
+        m_decoded.resize(kept);
+
+        // Most recently drawn first
+        std::sort(m_decoded.begin(), m_decoded.end(), [this](uint64_t a, uint64_t b)
+                  { return m_entries[a].lastFrame > m_entries[b].lastFrame; });
+
+        GLint previous = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+        size_t uploadedBytes = 0;
+        size_t uploaded = 0;
+        while (uploaded < m_decoded.size() && uploadedBytes < UPLOAD_BYTES_PER_FRAME)
+        {
+            GLuint texture = TakeTexture();
+            if (!texture)
+                break;
+
+            Entry &entry = m_entries[m_decoded[uploaded++]];
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, entry.width, entry.height, GL_RGBA, GL_UNSIGNED_BYTE, entry.pixels.data());
+            uploadedBytes += entry.pixels.size();
+
+            entry.texture = texture;
+            entry.state = CoverState::Resident;
+            std::vector<uint8_t>().swap(entry.pixels);
+        }
+        glBindTexture(GL_TEXTURE_2D, (GLuint)previous);
+        m_decoded.erase(m_decoded.begin(), m_decoded.begin() + uploaded);
+    }
+
+    void CoverCache::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread &worker : m_workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+        m_workers.clear();
+    }
+
+    // <-- Workers -->
+    void CoverCache::WorkerMain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_stop || !m_jobs.empty(); });
+            if (m_stop)
+                return;
+
+            // Newest first: what was just scrolled to matters more than what scrolled past
+            Job job = std::move(m_jobs.back());
+            m_jobs.pop_back();
+            lock.unlock();
+
+            Result result;
+            result.id = job.id;
+            result.generation = job.generation;
+            if (job.frame + STALE_FRAMES < m_frame.load())
+                result.skipped = true;
+            else
+                Decode(job, result);
+
+            lock.lock();
+            m_results.push_back(std::move(result));
+        }
+    }
+
+    bool CoverCache::Decode(const Job &job, Result &result) const
+    {
+        std::vector<fs::path> candidates;
+        std::error_code ec;
+
+        std::string stem = CoverFileStem(job.name.c_str());
+        if (!stem.empty())
+        {
+            for (const char *extension : COVER_EXTENSIONS)
+            {
+                fs::path path = m_coverDirectory / fs::u8path(stem + extension);
+                if (fs::is_regular_file(path, ec))
+                {
+                    candidates.push_back(path);
+                    break;
+                }
+            }
+        }
+
+        // One listing of the game's folder, ranked by how specific the name is
+        if (candidates.empty() && !job.folder.empty())
+        {
+            fs::path best;
+            size_t bestRank = IM_ARRAYSIZE(COVER_STEMS);
+            for (fs::directory_iterator it(fs::u8path(job.folder), fs::directory_options::skip_permission_denied, ec), end;
+                 !ec && it != end; it.increment(ec))
+            {
+                std::string extension = it->path().extension().string();
+                bool isImage = false;
+                for (const char *known : COVER_EXTENSIONS)
+                    isImage = isImage || EqualsNoCase(extension, known);
+                if (!isImage)
+                    continue;
+
+                std::string fileStem = it->path().stem().string();
+                for (size_t rank = 0; rank < bestRank; ++rank)
+                {
+                    if (EqualsNoCase(fileStem, COVER_STEMS[rank]))
+                    {
+                        best = it->path();
+                        bestRank = rank;
+                        break;
+                    }
+                }
+            }
+            if (!best.empty())
+                candidates.push_back(best);
+        }
+
+        for (const fs::path &path : candidates)
+        {
+            MappedFile file;
+            if (!file.Open(path) || file.Size() > (size_t)INT_MAX)
+                continue;
+
+            int width = 0, height = 0, channels = 0;
+            if (!stbi_info_from_memory(file.Data(), (int)file.Size(), &width, &height, &channels) ||
+                width <= 0 || height <= 0 || width > MAX_SOURCE_DIMENSION || height > MAX_SOURCE_DIMENSION)
+                continue;
+
+            unsigned char *pixels = stbi_load_from_memory(file.Data(), (int)file.Size(), &width, &height, &channels, STBI_rgb_alpha);
+            if (!pixels)
+                continue;
+
+            // Fit inside the texture slot, keeping the aspect ratio
+            float scale = std::min({1.0f, (float)MAX_WIDTH / width, (float)MAX_HEIGHT / height});
+            result.width = std::clamp((int)(width * scale + 0.5f), 1, MAX_WIDTH);
+            result.height = std::clamp((int)(height * scale + 0.5f), 1, MAX_HEIGHT);
+            result.pixels.resize((size_t)result.width * result.height * 4);
+            if (result.width == width && result.height == height)
+                std::memcpy(result.pixels.data(), pixels, result.pixels.size());
+            else if (!stbir_resize_uint8_linear(pixels, width, height, 0, result.pixels.data(), result.width, result.height, 0, STBIR_RGBA))
+                result.pixels.clear();
+            stbi_image_free(pixels);
+
+            if (!result.pixels.empty())
+                return true;
+        }
+        return false;
+    }
+
+} // namespace Core
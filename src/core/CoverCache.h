@@ -0,0 +1,138 @@
+#ifndef COVERCACHE_H
+#define COVERCACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // A resident cover: the texture, the part of it holding the image, and the image's size in texels
+    struct CoverRef
+    {
+        ImTextureID texture;
+        ImVec2 uv1;
+        ImVec2 size;
+    };
+
+    // <-- Box Art Cache -->
+    // Cover images for the grid view, found by convention: covers/<game name>.*
+    // beside the launcher, else a cover/box/boxart/folder image in the game's
+    // folder (png, jpg, bmp, tga or gif).
+    //
+    // Workers decode with stb_image and shrink to MAX_WIDTH x MAX_HEIGHT with
+    // stb_image_resize2, newest request first; requests that scrolled out of
+    // view before a worker reached them are dropped. Update() uploads at most
+    // UPLOAD_BYTES_PER_FRAME into a pool of fixed-size textures, so a frame
+    // never waits on a decode and only pays for a few uploads. The pool is
+    // capped at VRAM_BUDGET; past that the least recently drawn cover gives
+    // up its texture (never one drawn this frame).
+    //
+    // UI thread only, except for the workers. The textures go away with the
+    // GL context.
+    class CoverCache
+    {
+    public:
+        static constexpr int MAX_WIDTH = 192;
+        static constexpr int MAX_HEIGHT = 256;
+        static constexpr size_t VRAM_BUDGET = 64u * 1024 * 1024; // 341 covers
+        static constexpr size_t UPLOAD_BYTES_PER_FRAME = 512u * 1024;
+
+        CoverCache() = default;
+        ~CoverCache();
+
+        CoverCache(const CoverCache &) = delete;
+        CoverCache &operator=(const CoverCache &) = delete;
+
+        void SetCoverDirectory(const fs::path &dir) { m_coverDirectory = dir; }
+
+        // Call for each cover on screen; queues a decode the first time. The
+        // folder and name pick the image, so an edited game finds a new one
+        bool Request(uint64_t id, const char *name, const std::string &folder, CoverRef &out);
+
+        // Once per frame: takes decoded covers, uploads within the budget
+        void Update();
+        void Stop();
+
+        size_t TextureCount() const { return m_textures; }
+
+    private:
+        enum class CoverState : uint8_t
+        {
+            Queued,
+            Decoded, // Pixels waiting for a texture
+            Resident,
+            Missing
+        };
+
+        struct Entry
+        {
+            CoverState state = CoverState::Queued;
+            uint32_t generation = 0;
+            std::string name;
+            std::string folder;
+            uint64_t lastFrame = 0;
+            int width = 0;
+            int height = 0;
+            GLuint texture = 0;
+            std::vector<uint8_t> pixels;
+        };
+
+        struct Job
+        {
+            uint64_t id;
+            uint32_t generation;
+            uint64_t frame;
+            std::string name;
+            std::string folder;
+        };
+
+        struct Result
+        {
+            uint64_t id;
+            uint32_t generation;
+            bool skipped = false; // Stale by the time a worker got to it
+            int width = 0;
+            int height = 0;
+            std::vector<uint8_t> pixels;
+        };
+
+        void WorkerMain();
+        bool Decode(const Job &job, Result &result) const;
+        GLuint TakeTexture();
+
+        static constexpr size_t TEXTURE_BYTES = (size_t)MAX_WIDTH * MAX_HEIGHT * 4;
+        static constexpr uint64_t STALE_FRAMES = 30;
+
+        // UI thread
+        std::unordered_map<uint64_t, Entry> m_entries; // By game id
+        std::vector<uint64_t> m_decoded;               // Ids in the Decoded state
+        std::vector<GLuint> m_freeTextures;
+        size_t m_textures = 0; // Allocated, free or not
+        uint32_t m_generation = 0;
+        fs::path m_coverDirectory = "covers";
+
+        // Shared with the workers
+        std::atomic<uint64_t> m_frame{1};
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Job> m_jobs; // Newest at the back
+        std::vector<Result> m_results;
+        bool m_stop = false;
+        std::vector<std::thread> m_workers;
+    };
+
+} // namespace Core
+
+#endif // COVERCACHE_H
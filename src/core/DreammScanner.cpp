@@ -0,0 +1,216 @@
+#include "pch.h"
+#include "Core/DreammScanner.h"
+#include "Core/MappedFile.h"
+#include "Core/PersistenceWorker.h"
+#include "Core/TextFold.h"
+#include "Core/TextTokenizer.h"
+
+#include <chrono>
+#include <unordered_map>
+
+namespace Core
+{
+
+    static const int64_t NO_WRITE_TIME = INT64_MIN;
+
+    DreammScanner::~DreammScanner()
+    {
+        Stop();
+    }
+
+    // <-- UI Thread -->
+    bool DreammScanner::Start(fs::path root, fs::path cacheFile, std::unordered_set<std::string> knownInstalls)
+    {
+        if (m_running)
+            return false;
+
+        if (m_thread.joinable())
+            m_thread.join();
+
+        m_found.clear();
+        m_finished = false;
+        m_stop = false;
+        m_running = true;
+        m_thread = std::thread(&DreammScanner::ThreadMain, this, std::move(root), std::move(cacheFile), std::move(knownInstalls));
+        return true;
+    }
+
+    bool DreammScanner::Poll(std::vector<DreammInstall> &found)
+    {
+        if (!m_running)
+            return false;
+
+        bool finished;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            found.swap(m_found);
+            m_found.clear();
+            finished = m_finished;
+        }
+
+        if (finished)
+        {
+            m_thread.join();
+            m_running = false;
+        }
+        return !finished || !found.empty();
+    }
+
+    void DreammScanner::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        if (m_thread.joinable())
+            m_thread.join();
+        m_running = false;
+    }
+
+    // <-- Worker -->
+    void DreammScanner::Publish(std::vector<DreammInstall> &batch, bool finished)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (DreammInstall &install : batch)
+            m_found.push_back(std::move(install));
+        batch.clear();
+        m_finished = finished;
+    }
+
+    void DreammScanner::ThreadMain(fs::path root, fs::path cacheFile, std::unordered_set<std::string> known)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        std::vector<DreammInstall> batch;
+
+        std::error_code ec;
+        if (!fs::is_directory(root, ec))
+        {
+            Publish(batch, true);
+            return;
+        }
+
+        // Previous scan: one line per game folder, "<folder id>|<write time>|<version>|<version>..."
+        std::unordered_map<std::string, CachedFolder> cache;
+        {
+            MappedFile file;
+            if (file.Open(cacheFile))
+            {
+                TextLineReader reader(std::string_view(reinterpret_cast<const char *>(file.Data()), file.Size()));
+                std::string_view line;
+                while (reader.Next(line))
+                {
+                    size_t sep = line.find('|');
+                    size_t timeEnd = (sep == std::string_view::npos) ? sep : line.find('|', sep + 1);
+                    if (sep == std::string_view::npos || sep == 0)
+                        continue;
+
+                    std::string_view timeField = line.substr(sep + 1, timeEnd == std::string_view::npos ? std::string_view::npos : timeEnd - sep - 1);
+                    CachedFolder folder;
+                    auto result = std::from_chars(timeField.data(), timeField.data() + timeField.size(), folder.writeTime);
+                    if (result.ec != std::errc() || result.ptr != timeField.data() + timeField.size())
+                        continue;
+
+                    while (timeEnd != std::string_view::npos)
+                    {
+                        size_t next = line.find('|', timeEnd + 1);
+                        std::string_view version = line.substr(timeEnd + 1, next == std::string_view::npos ? std::string_view::npos : next - timeEnd - 1);
+                        if (!version.empty())
+                            folder.versions.emplace_back(version);
+                        timeEnd = next;
+                    }
+                    cache.emplace(std::string(line.substr(0, sep)), std::move(folder));
+                }
+            }
+        }
+
+        const size_t cachedFolders = cache.size();
+        std::unordered_map<std::string, CachedFolder> scanned;
+        std::unordered_set<std::string> seen; // Folded paths already reported this scan
+        int folders = 0, unchanged = 0, added = 0;
+
+        fs::directory_iterator it(root, fs::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != fs::directory_iterator(); it.increment(ec))
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stop)
+                    return;
+            }
+
+            const fs::directory_entry &gameDir = *it;
+            std::error_code entryEc;
+            if (!gameDir.is_directory(entryEc))
+                continue;
+
+            std::string folderID = gameDir.path().filename().string();
+            if (folderID.empty() || folderID[0] == '~')
+                continue;
+            folders++;
+
+            // Adding or removing a version folder updates the game folder's write time
+            auto writeTime = fs::last_write_time(gameDir.path(), entryEc);
+            int64_t stamp = entryEc ? NO_WRITE_TIME : (int64_t)writeTime.time_since_epoch().count();
+
+            CachedFolder folder;
+            folder.writeTime = stamp;
+            auto cached = cache.find(folderID);
+            if (stamp != NO_WRITE_TIME && cached != cache.end() && cached->second.writeTime == stamp)
+            {
+                folder.versions = std::move(cached->second.versions);
+                unchanged++;
+            }
+            else
+            {
+                for (fs::directory_iterator versionIt(gameDir.path(), fs::directory_options::skip_permission_denied, entryEc);
+                     !entryEc && versionIt != fs::directory_iterator(); versionIt.increment(entryEc))
+                {
+                    std::error_code versionEc;
+                    if (versionIt->is_directory(versionEc))
+                        folder.versions.push_back(versionIt->path().filename().string());
+                }
+            }
+
+            for (const std::string &versionID : folder.versions)
+            {
+                std::string fullPath = (gameDir.path() / versionID).string();
+                std::string folded = FoldPath(fullPath);
+                if (known.count(folded) || !seen.insert(std::move(folded)).second)
+                    continue;
+
+                batch.push_back(DreammInstall{folderID, versionID, std::move(fullPath)});
+                added++;
+                if (batch.size() >= BATCH_SIZE)
+                    Publish(batch, false);
+            }
+
+            scanned.emplace(std::move(folderID), std::move(folder));
+        }
+
+        // Rewrite the cache for the next startup if anything moved (not after a failed walk)
+        if (!ec && (unchanged != folders || scanned.size() != cachedFolders))
+        {
+            std::string contents;
+            for (const auto &entry : scanned)
+            {
+                if (entry.second.writeTime == NO_WRITE_TIME)
+                    continue;
+                contents += entry.first;
+                contents += '|';
+                contents += std::to_string(entry.second.writeTime);
+                for (const std::string &version : entry.second.versions)
+                {
+                    contents += '|';
+                    contents += version;
+                }
+                contents += '\n';
+            }
+            PersistenceWorker::WriteFileAtomic(cacheFile, contents);
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        SDL_Log("Scanned %d DREAMM folders (%d unchanged) in %.1f ms, %d new installs.", folders, unchanged, seconds * 1000.0, added);
+
+        Publish(batch, true);
+    }
+
+} // namespace Core
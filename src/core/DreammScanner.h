@@ -0,0 +1,76 @@
+#ifndef DREAMMSCANNER_H
+#define DREAMMSCANNER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // One version folder under <DREAMM>/install/<folder id>/
+    struct DreammInstall
+    {
+        std::string folderID;
+        std::string versionID;
+        std::string installPath;
+    };
+
+    // <-- Background DREAMM Scanner -->
+    // Walks <DREAMM>/install on a worker thread and hands back the version
+    // folders that aren't in the library yet, in batches, so the UI merges
+    // them a few at a time instead of waiting on the whole scan.
+    //
+    // Each game folder's last write time and version list are cached in
+    // `cacheFile`. A folder whose time is unchanged (no version added or
+    // removed) is taken from the cache without listing it; its versions are
+    // still checked against the library, so deleted entries don't linger.
+    class DreammScanner
+    {
+    public:
+        DreammScanner() = default;
+        ~DreammScanner();
+
+        DreammScanner(const DreammScanner &) = delete;
+        DreammScanner &operator=(const DreammScanner &) = delete;
+
+        // UI thread. `knownInstalls` are the library's install paths, folded with FoldPath()
+        bool Start(fs::path root, fs::path cacheFile, std::unordered_set<std::string> knownInstalls);
+
+        // Moves installs found since the last call into `found`; returns false
+        // once the scan has finished and everything has been handed over
+        bool Poll(std::vector<DreammInstall> &found);
+        bool IsRunning() const { return m_running; }
+        void Stop();
+
+    private:
+        struct CachedFolder
+        {
+            int64_t writeTime;
+            std::vector<std::string> versions;
+        };
+
+        void ThreadMain(fs::path root, fs::path cacheFile, std::unordered_set<std::string> known);
+        void Publish(std::vector<DreammInstall> &batch, bool finished);
+
+        static constexpr size_t BATCH_SIZE = 64;
+
+        // Shared, under m_mutex
+        std::mutex m_mutex;
+        std::vector<DreammInstall> m_found;
+        bool m_finished = false;
+        bool m_stop = false;
+
+        // UI only
+        std::thread m_thread;
+        bool m_running = false;
+    };
+
+} // namespace Core
+
+#endif // DREAMMSCANNER_H
@@ -0,0 +1,346 @@
+#include "pch.h"
+#include "Core/DreammWatcher.h"
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Core
+{
+
+    static const int WAIT_STEP_MS = 100; // How often the worker checks for settled folders and Stop()
+
+    DreammWatcher::~DreammWatcher()
+    {
+        Stop();
+    }
+
+    // <-- UI Thread -->
+    bool DreammWatcher::Start(fs::path root)
+    {
+        if (m_thread.joinable())
+            return false;
+
+        std::error_code ec;
+        if (!fs::is_directory(root, ec))
+            return false;
+
+        m_root = std::move(root);
+        m_stop = false;
+        m_thread = std::thread(&DreammWatcher::ThreadMain, this);
+        return true;
+    }
+
+    void DreammWatcher::Stop()
+    {
+        m_stop = true;
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    bool DreammWatcher::TakeSettled(std::vector<DreammFolderListing> &out)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_settled.empty())
+            return false;
+        out.swap(m_settled);
+        m_settled.clear();
+        return true;
+    }
+
+    // <-- Worker -->
+    void DreammWatcher::ThreadMain()
+    {
+        if (!WatchNative() && !Stopping())
+        {
+            SDL_Log("Watching %s by polling.", m_root.string().c_str());
+            m_polling = true;
+            WatchPolling();
+        }
+    }
+
+    void DreammWatcher::Touch(const std::string &folderID)
+    {
+        if (folderID.empty() || folderID[0] == '~')
+            return;
+        m_pending[folderID] = Clock::now();
+    }
+
+    // After a lost event queue: every game folder may have changed
+    void DreammWatcher::TouchAll()
+    {
+        std::error_code ec;
+        for (fs::directory_iterator it(m_root, fs::directory_options::skip_permission_denied, ec);
+             !ec && it != fs::directory_iterator(); it.increment(ec))
+        {
+            std::error_code entryEc;
+            if (it->is_directory(entryEc))
+                Touch(it->path().filename().string());
+        }
+    }
+
+    // Lists the folders that have been quiet for QUIET and publishes them
+    void DreammWatcher::Settle()
+    {
+        if (m_pending.empty())
+            return;
+
+        std::vector<DreammFolderListing> settled;
+        Clock::time_point now = Clock::now();
+        for (auto it = m_pending.begin(); it != m_pending.end();)
+        {
+            if (now - it->second < QUIET)
+            {
+                ++it;
+                continue;
+            }
+
+            DreammFolderListing listing;
+            listing.folderID = it->first;
+            std::error_code ec;
+            for (fs::directory_iterator versionIt(m_root / it->first, fs::directory_options::skip_permission_denied, ec);
+                 !ec && versionIt != fs::directory_iterator(); versionIt.increment(ec))
+            {
+                std::error_code entryEc;
+                if (versionIt->is_directory(entryEc))
+                    listing.versions.push_back(versionIt->path().filename().string());
+            }
+            settled.push_back(std::move(listing));
+            it = m_pending.erase(it);
+        }
+
+        if (settled.empty())
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (DreammFolderListing &listing : settled)
+            m_settled.push_back(std::move(listing));
+    }
+
+#if defined(_WIN32)
+    // One subtree watch on the root; only the first path component matters
+    bool DreammWatcher::WatchNative()
+    {
+        HANDLE dir = CreateFileW(m_root.wstring().c_str(), FILE_LIST_DIRECTORY,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                                 FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+        if (dir == INVALID_HANDLE_VALUE)
+            return false;
+
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        std::vector<DWORD> buffer(16 * 1024); // DWORD-aligned, as ReadDirectoryChangesW requires
+        const DWORD filter = FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_FILE_NAME;
+
+        if (!overlapped.hEvent || !ReadDirectoryChangesW(dir, buffer.data(), (DWORD)(buffer.size() * sizeof(DWORD)), TRUE, filter, NULL, &overlapped, NULL))
+        {
+            if (overlapped.hEvent)
+                CloseHandle(overlapped.hEvent);
+            CloseHandle(dir);
+            return false;
+        }
+
+        bool ok = true;
+        bool pending = true; // A read is outstanding
+        while (!Stopping())
+        {
+            if (WaitForSingleObject(overlapped.hEvent, WAIT_STEP_MS) == WAIT_OBJECT_0)
+            {
+                DWORD bytes = 0;
+                pending = false;
+                if (!GetOverlappedResult(dir, &overlapped, &bytes, FALSE))
+                {
+                    ok = false;
+                    break;
+                }
+
+                // Zero bytes means the buffer overflowed and events were dropped
+                if (bytes == 0)
+                    TouchAll();
+
+                for (DWORD offset = 0; bytes != 0;)
+                {
+                    const FILE_NOTIFY_INFORMATION *info = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(reinterpret_cast<const uint8_t *>(buffer.data()) + offset);
+                    std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                    size_t sep = name.find(L'\\');
+                    Touch(fs::path(name.substr(0, sep)).string());
+
+                    if (info->NextEntryOffset == 0)
+                        break;
+                    offset += info->NextEntryOffset;
+                }
+
+                ResetEvent(overlapped.hEvent);
+                if (!ReadDirectoryChangesW(dir, buffer.data(), (DWORD)(buffer.size() * sizeof(DWORD)), TRUE, filter, NULL, &overlapped, NULL))
+                {
+                    ok = false;
+                    break;
+                }
+                pending = true;
+            }
+            Settle();
+        }
+
+        if (pending)
+        {
+            CancelIoEx(dir, &overlapped);
+            DWORD ignored;
+            GetOverlappedResult(dir, &overlapped, &ignored, TRUE);
+        }
+        CloseHandle(overlapped.hEvent);
+        CloseHandle(dir);
+
+        // A watch that died part way is picked up by polling
+        if (!ok)
+            TouchAll();
+        return ok;
+    }
+#elif defined(__linux__)
+    // inotify isn't recursive: one watch on the root and one per game folder,
+    // which is exactly the two levels version folders live at
+    bool DreammWatcher::WatchNative()
+    {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+        int rootWatch = inotify_add_watch(fd, m_root.c_str(), mask | IN_DELETE_SELF | IN_MOVE_SELF);
+        if (rootWatch < 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        std::unordered_map<int, std::string> folderOf;
+        auto watchFolder = [&](const std::string &folderID)
+        {
+            int wd = inotify_add_watch(fd, (m_root / folderID).c_str(), mask);
+            if (wd >= 0)
+                folderOf[wd] = folderID;
+        };
+
+        std::error_code ec;
+        for (fs::directory_iterator it(m_root, fs::directory_options::skip_permission_denied, ec);
+             !ec && it != fs::directory_iterator(); it.increment(ec))
+        {
+            std::error_code entryEc;
+            if (it->is_directory(entryEc))
+                watchFolder(it->path().filename().string());
+        }
+
+        alignas(inotify_event) char buffer[16 * 1024];
+        bool ok = true;
+        while (!Stopping())
+        {
+            pollfd pfd = {fd, POLLIN, 0};
+            if (poll(&pfd, 1, WAIT_STEP_MS) > 0)
+            {
+                ssize_t bytes;
+                while ((bytes = read(fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (char *p = buffer; p < buffer + bytes;)
+                    {
+                        const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+                        p += sizeof(inotify_event) + event->len;
+
+                        if (event->mask & IN_Q_OVERFLOW)
+                        {
+                            TouchAll();
+                            continue;
+                        }
+                        if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+                        {
+                            ok = false; // Root went away; polling notices if it comes back
+                            continue;
+                        }
+                        if (event->mask & IN_IGNORED)
+                        {
+                            folderOf.erase(event->wd);
+                            continue;
+                        }
+
+                        if (event->wd == rootWatch)
+                        {
+                            if (event->len == 0)
+                                continue;
+                            std::string folderID(event->name);
+                            if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                                watchFolder(folderID);
+                            Touch(folderID);
+                            continue;
+                        }
+
+                        auto folder = folderOf.find(event->wd);
+                        if (folder != folderOf.end())
+                            Touch(folder->second);
+                    }
+                }
+            }
+            if (!ok)
+                break;
+            Settle();
+        }
+
+        close(fd);
+        return ok;
+    }
+#else
+    bool DreammWatcher::WatchNative()
+    {
+        return false;
+    }
+#endif
+
+    // Compares the game folders' write times every POLL_INTERVAL; adding or
+    // removing a version folder updates its parent's
+    void DreammWatcher::WatchPolling()
+    {
+        std::unordered_map<std::string, fs::file_time_type> stamps;
+        bool first = true;
+        Clock::time_point nextPoll = Clock::now();
+
+        while (!Stopping())
+        {
+            if (Clock::now() >= nextPoll)
+            {
+                std::unordered_map<std::string, fs::file_time_type> current;
+                std::error_code ec;
+                for (fs::directory_iterator it(m_root, fs::directory_options::skip_permission_denied, ec);
+                     !ec && it != fs::directory_iterator(); it.increment(ec))
+                {
+                    std::error_code entryEc;
+                    if (!it->is_directory(entryEc))
+                        continue;
+                    auto time = fs::last_write_time(it->path(), entryEc);
+                    if (entryEc)
+                        continue;
+
+                    std::string folderID = it->path().filename().string();
+                    auto old = stamps.find(folderID);
+                    if (!first && (old == stamps.end() || old->second != time))
+                        Touch(folderID);
+                    current.emplace(std::move(folderID), time);
+                }
+
+                if (!ec)
+                {
+                    for (const auto &old : stamps)
+                    {
+                        if (!current.count(old.first))
+                            Touch(old.first);
+                    }
+                    stamps.swap(current);
+                    first = false;
+                }
+                nextPoll = Clock::now() + POLL_INTERVAL;
+            }
+
+            Settle();
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP_MS));
+        }
+    }
+
+} // namespace Core
@@ -0,0 +1,83 @@
+#ifndef DREAMMWATCHER_H
+#define DREAMMWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // The version folders of one game folder once it stopped changing
+    struct DreammFolderListing
+    {
+        std::string folderID;
+        std::vector<std::string> versions; // Empty if the game folder was removed
+    };
+
+    // <-- DREAMM Install Watcher -->
+    // Watches <DREAMM>/install for version folders being created, renamed or
+    // deleted, so new installs show up without a restart. Events only mark
+    // their game folder as changed; once a folder has been quiet for QUIET
+    // (DREAMM extracts an install as a burst of writes) it is listed on the
+    // worker and handed to the UI, which diffs it against the library. Nothing
+    // outside the changed folders is ever read again.
+    //
+    // Uses ReadDirectoryChangesW on Windows and inotify on Linux, and falls
+    // back to polling the game folders' write times every POLL_INTERVAL when
+    // neither is available (e.g. some network drives).
+    class DreammWatcher
+    {
+    public:
+        DreammWatcher() = default;
+        ~DreammWatcher();
+
+        DreammWatcher(const DreammWatcher &) = delete;
+        DreammWatcher &operator=(const DreammWatcher &) = delete;
+
+        // UI thread
+        bool Start(fs::path root);
+        void Stop();
+        bool IsPolling() const { return m_polling; }
+
+        // Moves the settled folders into `out`; returns true if there were any
+        bool TakeSettled(std::vector<DreammFolderListing> &out);
+
+        static constexpr std::chrono::milliseconds QUIET{1000};
+        static constexpr std::chrono::milliseconds POLL_INTERVAL{2000};
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void ThreadMain();
+        bool WatchNative();
+        void WatchPolling();
+
+        // Worker only
+        void Touch(const std::string &folderID);
+        void TouchAll();
+        void Settle();
+        bool Stopping() const { return m_stop.load(std::memory_order_relaxed); }
+
+        fs::path m_root;
+        std::unordered_map<std::string, Clock::time_point> m_pending; // Folder -> last event
+
+        // Shared, under m_mutex
+        std::mutex m_mutex;
+        std::vector<DreammFolderListing> m_settled;
+
+        std::atomic<bool> m_stop{false};
+        std::atomic<bool> m_polling{false};
+        std::thread m_thread;
+    };
+
+} // namespace Core
+
+#endif // DREAMMWATCHER_H
@@ -0,0 +1,738 @@
+#include "pch.h"
+#include "Core/ExecutableInfo.h"
+#include "Core/MappedFile.h"
+#include "Core/TextFold.h"
+
+#include "../stb_image.h"
+#include "../stb_image_resize2.h"
+
+namespace Core
+{
+
+    static const uint16_t RT_ICON_ID = 3;
+    static const uint16_t RT_GROUP_ICON_ID = 14;
+    static const uint16_t RT_VERSION_ID = 16;
+    static const int MAX_ICON_DIMENSION = 256;
+    static const uint16_t LANG_EN_US = 0x0409;
+    static const uint32_t MAX_SECTIONS = 96;          // The PE loader's own limit
+    static const uint32_t MAX_RESOURCE_ENTRIES = 4096; // Per directory, against garbage counts
+    static const size_t MAX_VERSION_STRING = 256;      // UTF-16 units
+
+    // <-- Bounds-Checked Little-Endian Reads -->
+    struct ByteView
+    {
+        const uint8_t *data;
+        size_t size;
+
+        bool Has(size_t offset, size_t bytes) const { return offset <= size && size - offset >= bytes; }
+
+        bool U8(size_t offset, uint8_t &out) const
+        {
+            if (!Has(offset, 1))
+                return false;
+            out = data[offset];
+            return true;
+        }
+
+        bool U16(size_t offset, uint16_t &out) const
+        {
+            if (!Has(offset, 2))
+                return false;
+            out = (uint16_t)(data[offset] | (data[offset + 1] << 8));
+            return true;
+        }
+
+        bool U32(size_t offset, uint32_t &out) const
+        {
+            if (!Has(offset, 4))
+                return false;
+            out = (uint32_t)data[offset] | ((uint32_t)data[offset + 1] << 8) |
+                  ((uint32_t)data[offset + 2] << 16) | ((uint32_t)data[offset + 3] << 24);
+            return true;
+        }
+
+        bool Tag(size_t offset, const char *tag, size_t bytes) const
+        {
+            return Has(offset, bytes) && memcmp(data + offset, tag, bytes) == 0;
+        }
+    };
+
+    static size_t Align4(size_t offset)
+    {
+        return (offset + 3) & ~(size_t)3;
+    }
+
+    // NUL-terminated UTF-16LE at `offset`, stopping at `end`, as trimmed UTF-8
+    static std::string ReadUtf16(const ByteView &view, size_t offset, size_t end)
+    {
+        std::string out;
+        for (size_t count = 0; offset + 2 <= end && count < MAX_VERSION_STRING; offset += 2, ++count)
+        {
+            uint16_t unit;
+            if (!view.U16(offset, unit) || unit == 0)
+                break;
+
+            uint32_t cp = unit;
+            if (unit >= 0xD800 && unit < 0xDC00)
+            {
+                uint16_t low;
+                if (offset + 4 > end || !view.U16(offset + 2, low) || low < 0xDC00 || low >= 0xE000)
+                    break;
+                cp = 0x10000 + (((uint32_t)unit - 0xD800) << 10) + (low - 0xDC00);
+                offset += 2;
+            }
+
+            if (cp < 0x80)
+                out += (char)cp;
+            else if (cp < 0x800)
+            {
+                out += (char)(0xC0 | (cp >> 6));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                out += (char)(0xE0 | (cp >> 12));
+                out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                out += (char)(0xF0 | (cp >> 18));
+                out += (char)(0x80 | ((cp >> 12) & 0x3F));
+                out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+        }
+
+        size_t first = out.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos)
+            return std::string();
+        return out.substr(first, out.find_last_not_of(" \t\r\n") - first + 1);
+    }
+
+    // <-- Version Resource -->
+    // VS_VERSIONINFO is a tree of blocks: wLength, wValueLength, wType, a
+    // UTF-16 key, then the value and the children, each DWORD-aligned
+    struct VersionBlock
+    {
+        size_t start = 0;
+        size_t end = 0;
+        size_t key = 0;
+        size_t value = 0;
+        size_t children = 0;
+    };
+
+    static bool ReadVersionBlock(const ByteView &view, size_t offset, size_t limit, VersionBlock &block)
+    {
+        uint16_t length, valueLength, type;
+        if (!view.U16(offset, length) || !view.U16(offset + 2, valueLength) || !view.U16(offset + 4, type))
+            return false;
+        if (length < 6 || offset + length > limit)
+            return false;
+
+        block.start = offset;
+        block.end = offset + length;
+        block.key = offset + 6;
+
+        size_t keyEnd = block.key;
+        uint16_t unit = 1;
+        while (keyEnd + 2 <= block.end && view.U16(keyEnd, unit) && unit != 0)
+            keyEnd += 2;
+        keyEnd += 2;
+
+        // Text values count UTF-16 units, binary ones bytes
+        block.value = std::min(Align4(keyEnd), block.end);
+        block.children = std::min(Align4(block.value + (type == 1 ? valueLength * 2u : valueLength)), block.end);
+        return true;
+    }
+
+    static bool KeyIs(const ByteView &view, const VersionBlock &block, const char *key)
+    {
+        size_t offset = block.key;
+        for (; *key; ++key, offset += 2)
+        {
+            uint16_t unit;
+            if (offset + 2 > block.end || !view.U16(offset, unit) || unit != (uint8_t)*key)
+                return false;
+        }
+        uint16_t terminator;
+        return view.U16(offset, terminator) && terminator == 0;
+    }
+
+    static void ReadStringTable(const ByteView &view, const VersionBlock &table, ExecutableInfo &info)
+    {
+        VersionBlock entry;
+        for (size_t offset = table.children; ReadVersionBlock(view, offset, table.end, entry); offset = Align4(entry.end))
+        {
+            if (KeyIs(view, entry, "ProductName"))
+                info.productName = ReadUtf16(view, entry.value, entry.end);
+            else if (KeyIs(view, entry, "FileDescription"))
+                info.fileDescription = ReadUtf16(view, entry.value, entry.end);
+            else if (KeyIs(view, entry, "CompanyName"))
+                info.companyName = ReadUtf16(view, entry.value, entry.end);
+        }
+    }
+
+    static void ReadVersionInfo(const ByteView &view, size_t offset, size_t size, ExecutableInfo &info)
+    {
+        VersionBlock root;
+        if (!view.Has(offset, size) || !ReadVersionBlock(view, offset, offset + size, root) || !KeyIs(view, root, "VS_VERSION_INFO"))
+            return;
+
+        VersionBlock child;
+        for (size_t childOffset = root.children; ReadVersionBlock(view, childOffset, root.end, child); childOffset = Align4(child.end))
+        {
+            if (!KeyIs(view, child, "StringFileInfo"))
+                continue;
+
+            // One table per language/codepage ("040904B0"); prefer US English, else the first
+            VersionBlock table, chosen;
+            bool found = false;
+            for (size_t tableOffset = child.children; ReadVersionBlock(view, tableOffset, child.end, table); tableOffset = Align4(table.end))
+            {
+                std::string key = ReadUtf16(view, table.key, table.end);
+                if (!found || key.compare(0, 4, "0409") == 0)
+                {
+                    chosen = table;
+                    found = true;
+                }
+                if (key.compare(0, 4, "0409") == 0)
+                    break;
+            }
+            if (found)
+                ReadStringTable(view, chosen, info);
+            return;
+        }
+    }
+
+    // <-- PE -->
+    struct PeSections
+    {
+        const ByteView &view;
+        size_t table;
+        uint16_t count;
+
+        bool ToOffset(uint32_t rva, uint32_t length, size_t &offset) const
+        {
+            for (uint16_t i = 0; i < count; ++i)
+            {
+                size_t section = table + i * 40u;
+                uint32_t virtualSize, virtualAddress, rawSize, rawPointer;
+                if (!view.U32(section + 8, virtualSize) || !view.U32(section + 12, virtualAddress) ||
+                    !view.U32(section + 16, rawSize) || !view.U32(section + 20, rawPointer))
+                    return false;
+
+                if (rva >= virtualAddress && rva - virtualAddress < rawSize && length <= rawSize - (rva - virtualAddress))
+                {
+                    offset = (size_t)rawPointer + (rva - virtualAddress);
+                    return view.Has(offset, length);
+                }
+            }
+            return false;
+        }
+    };
+
+    // Looks `id` up in one resource directory (-1 = its first entry). With
+    // `orFirst`, a missing id settles for the first entry instead.
+    static bool FindResourceEntry(const ByteView &view, size_t directory, int id, bool orFirst, uint32_t &data)
+    {
+        uint16_t named, ids;
+        if (!view.U16(directory + 12, named) || !view.U16(directory + 14, ids))
+            return false;
+
+        uint32_t total = std::min<uint32_t>((uint32_t)named + ids, MAX_RESOURCE_ENTRIES);
+        bool found = false;
+        for (uint32_t i = (id < 0) ? 0 : named; i < total; ++i)
+        {
+            uint32_t name, offset;
+            if (!view.U32(directory + 16 + i * 8u, name) || !view.U32(directory + 20 + i * 8u, offset))
+                return found;
+            if (id < 0 || ((name & 0x80000000u) == 0 && name == (uint32_t)id))
+            {
+                data = offset;
+                return true;
+            }
+            if (orFirst && !found)
+            {
+                data = offset;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // Walks type -> name (`name`, or the first) -> language (US English, else the first)
+    static bool FindResource(const ByteView &view, size_t root, uint16_t type, int name, uint32_t &rva, uint32_t &size)
+    {
+        uint32_t entry;
+        if (!FindResourceEntry(view, root, type, false, entry) || !(entry & 0x80000000u))
+            return false;
+        if (!FindResourceEntry(view, root + (entry & 0x7FFFFFFFu), name, false, entry) || !(entry & 0x80000000u))
+            return false;
+        if (!FindResourceEntry(view, root + (entry & 0x7FFFFFFFu), LANG_EN_US, true, entry) || (entry & 0x80000000u))
+            return false;
+
+        return view.U32(root + entry, rva) && view.U32(root + entry + 4, size);
+    }
+
+    // Resource directory of a PE image, and the section table to resolve its RVAs
+    static bool OpenPeResources(const ByteView &view, size_t pe, PeSections &sections, size_t &root)
+    {
+        uint16_t sectionCount = 0, optionalSize = 0, magic = 0;
+        view.U16(pe + 6, sectionCount);
+        view.U16(pe + 20, optionalSize);
+
+        size_t optional = pe + 24;
+        if (!view.U16(optional, magic) || (magic != 0x10B && magic != 0x20B))
+            return false;
+        bool is64Bit = (magic == 0x20B);
+
+        uint32_t directoryCount = 0, resourceRva = 0, resourceSize = 0;
+        size_t directories = optional + (is64Bit ? 112 : 96);
+        view.U32(optional + (is64Bit ? 108 : 92), directoryCount);
+        if (directoryCount <= 2 || !view.U32(directories + 16, resourceRva) || !view.U32(directories + 20, resourceSize) || resourceRva == 0)
+            return false;
+
+        sections.table = optional + optionalSize;
+        sections.count = (uint16_t)std::min<uint32_t>(sectionCount, MAX_SECTIONS);
+        return sections.ToOffset(resourceRva, 16, root);
+    }
+
+    static void ParsePE(const ByteView &view, size_t pe, ExecutableInfo &info)
+    {
+        info.format = ExecutableFormat::PE;
+        info.windows = true;
+
+        uint16_t magic = 0;
+        view.U16(pe + 4, info.machine);
+        if (!view.U16(pe + 24, magic) || (magic != 0x10B && magic != 0x20B))
+            return;
+        info.is64Bit = (magic == 0x20B);
+        view.U16(pe + 24 + 68, info.subsystem);
+
+        PeSections sections{view, 0, 0};
+        size_t resourceRoot;
+        if (!OpenPeResources(view, pe, sections, resourceRoot))
+            return;
+
+        uint32_t versionRva, versionSize;
+        size_t versionOffset;
+        if (FindResource(view, resourceRoot, RT_VERSION_ID, -1, versionRva, versionSize) && sections.ToOffset(versionRva, versionSize, versionOffset))
+            ReadVersionInfo(view, versionOffset, versionSize, info);
+    }
+
+    // e_lfanew of an MZ image, if it points at a new-style header; 0 otherwise
+    static uint32_t NewHeaderOffset(const ByteView &view)
+    {
+        uint16_t headerParagraphs = 0;
+        uint32_t newHeader = 0;
+        view.U16(8, headerParagraphs);
+
+        // Only headers of at least 40h bytes have the field
+        if (headerParagraphs >= 4 && view.U32(0x3C, newHeader) && newHeader >= 0x40 && view.Has(newHeader, 4))
+            return newHeader;
+        return 0;
+    }
+
+    // <-- Entry Points -->
+    bool ExecutableInfo::Read(const fs::path &path)
+    {
+        std::string ext = path.extension().string();
+        for (char &c : ext)
+            c = FoldAscii(c);
+
+        if (ext == ".bat")
+        {
+            *this = ExecutableInfo();
+            format = ExecutableFormat::Batch;
+            return true;
+        }
+
+        MappedFile file;
+        if (!file.Open(path))
+            return false;
+        return Parse(file.Data(), file.Size(), ext == ".com");
+    }
+
+    bool ExecutableInfo::Parse(const uint8_t *data, size_t size, bool comExtension)
+    {
+        *this = ExecutableInfo();
+        ByteView view{data, size};
+
+        if (!view.Tag(0, "MZ", 2) && !view.Tag(0, "ZM", 2))
+        {
+            // A .com is a raw image loaded at 100h; anything else without MZ isn't ours
+            if (!comExtension || size == 0 || size > 0xFF00)
+                return false;
+            format = ExecutableFormat::Com;
+            imageKB = (uint32_t)((size + 0x100 + 1023) / 1024);
+            return true;
+        }
+
+        format = ExecutableFormat::MZ;
+
+        uint16_t lastPageBytes = 0, pages = 0, headerParagraphs = 0, minAlloc = 0;
+        view.U16(2, lastPageBytes);
+        view.U16(4, pages);
+        view.U16(8, headerParagraphs);
+        view.U16(10, minAlloc);
+
+        size_t imageEnd = (size_t)pages * 512;
+        if (pages > 0 && lastPageBytes > 0 && lastPageBytes < 512)
+            imageEnd -= 512 - lastPageBytes;
+        size_t loadBytes = imageEnd > headerParagraphs * 16u ? imageEnd - headerParagraphs * 16u : 0;
+        imageKB = (uint32_t)((loadBytes + minAlloc * 16u + 1023) / 1024);
+
+        uint32_t newHeader = NewHeaderOffset(view);
+        if (newHeader != 0)
+        {
+            if (view.Tag(newHeader, "PE\0\0", 4))
+            {
+                ParsePE(view, newHeader, *this);
+                return true;
+            }
+            if (view.Tag(newHeader, "NE", 2))
+            {
+                // 1 = OS/2, 2 = Windows, 3 = European DOS 4, 4 = Windows 386; 0 = pre-3.0 Windows
+                format = ExecutableFormat::NE;
+                view.U8(newHeader + 0x36, targetOS);
+                windows = (targetOS == 0 || targetOS == 2 || targetOS == 4);
+                return true;
+            }
+            if (view.Tag(newHeader, "LE", 2) || view.Tag(newHeader, "LX", 2))
+            {
+                // Windows 386 means a VxD; everything else here is a DOS extender's payload
+                format = view.Tag(newHeader, "LE", 2) ? ExecutableFormat::LE : ExecutableFormat::LX;
+                view.U8(newHeader + 0x0A, targetOS);
+                windows = (targetOS == 4);
+                dosExtended = !windows;
+                return true;
+            }
+        }
+
+        // Extenders that append their image after the real-mode stub: DOS/16M (BW),
+        // Phar Lap (P2/P3), DJGPP (COFF), or an LE/LX bound without e_lfanew
+        if (imageEnd > 0 && view.Has(imageEnd, 2))
+        {
+            uint16_t coffMachine = 0;
+            view.U16(imageEnd, coffMachine);
+            if (view.Tag(imageEnd, "LE", 2) || view.Tag(imageEnd, "LX", 2))
+            {
+                format = view.Tag(imageEnd, "LE", 2) ? ExecutableFormat::LE : ExecutableFormat::LX;
+                dosExtended = true;
+            }
+            else if (view.Tag(imageEnd, "BW", 2) || view.Tag(imageEnd, "P2", 2) || view.Tag(imageEnd, "P3", 2) || coffMachine == 0x014C)
+            {
+                dosExtended = true;
+            }
+        }
+        return true;
+    }
+
+    const char *ExecutableInfo::FormatName() const
+    {
+        switch (format)
+        {
+        case ExecutableFormat::Batch:
+            return "DOS batch file";
+        case ExecutableFormat::Com:
+            return "DOS .COM program";
+        case ExecutableFormat::MZ:
+            return dosExtended ? "DOS extended program" : "DOS program";
+        case ExecutableFormat::NE:
+            return windows ? "16-bit Windows program" : "16-bit OS/2 program";
+        case ExecutableFormat::LE:
+        case ExecutableFormat::LX:
+            return windows ? "Windows VxD" : "DOS extended program";
+        case ExecutableFormat::PE:
+            return is64Bit ? "64-bit Windows program" : "32-bit Windows program";
+        default:
+            return "Unknown";
+        }
+    }
+
+    // Real mode fits in conventional memory; extenders and Windows want more
+    int ExecutableInfo::SuggestedRamKB() const
+    {
+        if (format == ExecutableFormat::PE)
+            return 65536;
+        if (format == ExecutableFormat::NE || dosExtended || windows)
+            return 16384;
+        return 640;
+    }
+
+    void ExecutableInfo::ApplyTo(GameEntry &game, bool fresh) const
+    {
+        if (format == ExecutableFormat::Unknown)
+            return;
+
+        if (fresh && !productName.empty())
+            game.name = productName;
+
+        if ((fresh || game.description.empty()) && !fileDescription.empty())
+        {
+            game.description = fileDescription;
+            if (!companyName.empty())
+                game.description += " - " + companyName;
+        }
+
+        // Same defaults the editor's platform combo applies; DREAMM-native
+        // entries aren't run from an exe the headers could speak for
+        GamePlatform platform = Platform();
+        if (fresh || (game.platform != platform && game.platform != GamePlatform::DreammNative))
+        {
+            game.platform = platform;
+            game.ramKB = SuggestedRamKB();
+            for (int i = 0; i < 6; i++)
+                game.audioFlags[i] = false;
+            if (platform == GamePlatform::DOS)
+                game.audioFlags[3] = true; // SB16
+            game.audioFlags[5] = true;     // GMIDI
+        }
+    }
+
+    // <-- Icons -->
+    // NE resource table: an alignment shift, then per type an id, a count and
+    // 12-byte name entries (offset and length in alignment units, id)
+    static bool FindNeResource(const ByteView &view, size_t ne, uint16_t type, int id, size_t &offset, size_t &length)
+    {
+        uint16_t tableOffset, shift;
+        if (!view.U16(ne + 0x24, tableOffset) || !view.U16(ne + tableOffset, shift) || shift > 16)
+            return false;
+
+        size_t typeInfo = ne + tableOffset + 2;
+        for (int types = 0; types < 256; ++types)
+        {
+            uint16_t typeId, count;
+            if (!view.U16(typeInfo, typeId) || typeId == 0 || !view.U16(typeInfo + 2, count))
+                return false;
+
+            size_t names = typeInfo + 8;
+            if (typeId == (0x8000 | type))
+            {
+                for (uint16_t i = 0; i < count; ++i)
+                {
+                    uint16_t entryOffset, entryLength, entryId;
+                    size_t entry = names + i * 12u;
+                    if (!view.U16(entry, entryOffset) || !view.U16(entry + 2, entryLength) || !view.U16(entry + 6, entryId))
+                        return false;
+                    if (id < 0 || entryId == (0x8000 | id))
+                    {
+                        offset = (size_t)entryOffset << shift;
+                        length = (size_t)entryLength << shift;
+                        return view.Has(offset, length);
+                    }
+                }
+                return false;
+            }
+            typeInfo = names + count * 12u;
+        }
+        return false;
+    }
+
+    // GRPICONDIR: picks the entry closest to `size`, preferring to scale down
+    // and then more colours; returns its RT_ICON id
+    static int ChooseIcon(const ByteView &view, size_t group, size_t length, int size)
+    {
+        uint16_t type, count;
+        if (!view.U16(group + 2, type) || type != 1 || !view.U16(group + 4, count))
+            return -1;
+
+        int best = -1, bestDistance = INT32_MAX, bestDepth = 0;
+        for (uint16_t i = 0; i < count && 6 + (i + 1) * 14u <= length; ++i)
+        {
+            size_t entry = group + 6 + i * 14u;
+            uint8_t width = 0, colours = 0;
+            uint16_t bitCount = 0, id = 0;
+            view.U8(entry, width);
+            view.U8(entry + 2, colours);
+            view.U16(entry + 6, bitCount);
+            view.U16(entry + 12, id);
+
+            int pixels = width ? width : 256;
+            int depth = bitCount ? bitCount : (colours == 2 ? 1 : colours == 16 ? 4 : 8);
+            int distance = pixels >= size ? pixels - size : (size - pixels) * 4;
+            if (distance < bestDistance || (distance == bestDistance && depth > bestDepth))
+            {
+                best = id;
+                bestDistance = distance;
+                bestDepth = depth;
+            }
+        }
+        return best;
+    }
+
+    // A BITMAPINFOHEADER image (XOR colours, then the 1bpp AND mask), bottom-up
+    static bool DecodeIconBitmap(const ByteView &view, std::vector<uint8_t> &rgba, int &width, int &height)
+    {
+        uint32_t headerSize = 0, compression = 0, paletteUsed = 0;
+        uint32_t rawWidth = 0, rawHeight = 0;
+        uint16_t bitCount = 0;
+        if (!view.U32(0, headerSize) || headerSize < 40 || !view.U32(4, rawWidth) || !view.U32(8, rawHeight) ||
+            !view.U16(14, bitCount) || !view.U32(16, compression) || !view.U32(32, paletteUsed))
+            return false;
+
+        width = (int32_t)rawWidth;
+        height = (int32_t)rawHeight / 2; // Both masks are counted
+        if (compression != 0 || width <= 0 || height <= 0 || width > MAX_ICON_DIMENSION || height > MAX_ICON_DIMENSION)
+            return false;
+        if (bitCount != 1 && bitCount != 4 && bitCount != 8 && bitCount != 24 && bitCount != 32)
+            return false;
+
+        size_t paletteSize = 0;
+        if (bitCount <= 8)
+            paletteSize = (paletteUsed && paletteUsed < (1u << bitCount)) ? paletteUsed : (1u << bitCount);
+
+        size_t palette = headerSize;
+        size_t colourStride = ((width * bitCount + 31) / 32) * 4;
+        size_t colours = palette + paletteSize * 4;
+        size_t maskStride = ((width + 31) / 32) * 4;
+        size_t mask = colours + colourStride * height;
+        if (!view.Has(colours, colourStride * height))
+            return false;
+        bool hasMask = view.Has(mask, maskStride * height);
+
+        rgba.assign((size_t)width * height * 4, 0);
+        bool anyAlpha = false;
+        for (int y = 0; y < height; ++y)
+        {
+            const uint8_t *row = view.data + colours + colourStride * (height - 1 - y);
+            const uint8_t *maskRow = hasMask ? view.data + mask + maskStride * (height - 1 - y) : nullptr;
+            uint8_t *out = rgba.data() + (size_t)y * width * 4;
+
+            for (int x = 0; x < width; ++x, out += 4)
+            {
+                uint8_t b, g, r, a = 255;
+                if (bitCount >= 24)
+                {
+                    const uint8_t *pixel = row + x * (bitCount / 8);
+                    b = pixel[0];
+                    g = pixel[1];
+                    r = pixel[2];
+                    if (bitCount == 32)
+                    {
+                        a = pixel[3];
+                        anyAlpha = anyAlpha || a != 0;
+                    }
+                }
+                else
+                {
+                    int bit = x * bitCount;
+                    uint32_t index = (row[bit / 8] >> (8 - bitCount - bit % 8)) & ((1u << bitCount) - 1);
+                    if (index >= paletteSize)
+                        index = 0;
+                    const uint8_t *entry = view.data + palette + index * 4;
+                    b = entry[0];
+                    g = entry[1];
+                    r = entry[2];
+                }
+
+                // The AND mask marks transparent pixels of icons without an alpha channel
+                if (bitCount != 32 && maskRow && ((maskRow[x / 8] >> (7 - x % 8)) & 1))
+                    a = 0;
+
+                out[0] = r;
+                out[1] = g;
+                out[2] = b;
+                out[3] = a;
+            }
+        }
+
+        // 32bpp icons from before alpha (all zero) still rely on the mask
+        if (bitCount == 32 && !anyAlpha)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                const uint8_t *maskRow = hasMask ? view.data + mask + maskStride * (height - 1 - y) : nullptr;
+                for (int x = 0; x < width; ++x)
+                    rgba[((size_t)y * width + x) * 4 + 3] = (maskRow && ((maskRow[x / 8] >> (7 - x % 8)) & 1)) ? 0 : 255;
+            }
+        }
+        return true;
+    }
+
+    static bool DecodeIconImage(const ByteView &view, int size, std::vector<uint8_t> &rgba)
+    {
+        std::vector<uint8_t> decoded;
+        int width = 0, height = 0;
+
+        // Vista-style icons embed a PNG
+        if (view.Tag(0, "\x89PNG", 4))
+        {
+            int channels;
+            if (view.size > INT32_MAX)
+                return false;
+            unsigned char *pixels = stbi_load_from_memory(view.data, (int)view.size, &width, &height, &channels, STBI_rgb_alpha);
+            if (!pixels)
+                return false;
+            if (width <= 0 || height <= 0 || width > MAX_ICON_DIMENSION || height > MAX_ICON_DIMENSION)
+            {
+                stbi_image_free(pixels);
+                return false;
+            }
+            decoded.assign(pixels, pixels + (size_t)width * height * 4);
+            stbi_image_free(pixels);
+        }
+        else if (!DecodeIconBitmap(view, decoded, width, height))
+        {
+            return false;
+        }
+
+        if (width == size && height == size)
+        {
+            rgba.swap(decoded);
+            return true;
+        }
+
+        rgba.resize((size_t)size * size * 4);
+        return stbir_resize_uint8_linear(decoded.data(), width, height, 0, rgba.data(), size, size, 0, STBIR_RGBA) != nullptr;
+    }
+
+    bool ExecutableInfo::ReadIcon(const fs::path &path, int size, std::vector<uint8_t> &rgba)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+            return false;
+
+        ByteView view{file.Data(), file.Size()};
+        if (!view.Tag(0, "MZ", 2) && !view.Tag(0, "ZM", 2))
+            return false;
+
+        uint32_t newHeader = NewHeaderOffset(view);
+        if (newHeader == 0)
+            return false;
+
+        size_t group = 0, groupLength = 0, image = 0, imageLength = 0;
+        if (view.Tag(newHeader, "PE\0\0", 4))
+        {
+            PeSections sections{view, 0, 0};
+            size_t root;
+            uint32_t rva, length;
+            if (!OpenPeResources(view, newHeader, sections, root) ||
+                !FindResource(view, root, RT_GROUP_ICON_ID, -1, rva, length) || !sections.ToOffset(rva, length, group))
+                return false;
+            groupLength = length;
+
+            int id = ChooseIcon(view, group, groupLength, size);
+            if (id < 0 || !FindResource(view, root, RT_ICON_ID, id, rva, length) || !sections.ToOffset(rva, length, image))
+                return false;
+            imageLength = length;
+        }
+        else if (view.Tag(newHeader, "NE", 2))
+        {
+            if (!FindNeResource(view, newHeader, RT_GROUP_ICON_ID, -1, group, groupLength))
+                return false;
+
+            int id = ChooseIcon(view, group, groupLength, size);
+            if (id < 0 || !FindNeResource(view, newHeader, RT_ICON_ID, id, image, imageLength))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+
+        return DecodeIconImage(ByteView{view.data + image, imageLength}, size, rgba);
+    }
+
+} // namespace Core
@@ -0,0 +1,72 @@
+#ifndef EXECUTABLEINFO_H
+#define EXECUTABLEINFO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Core/GameEntry.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    enum class ExecutableFormat : uint8_t
+    {
+        Unknown = 0,
+        Batch, // *.bat
+        Com,   // Headerless *.com image
+        MZ,    // Plain DOS executable
+        NE,    // 16-bit Windows (or OS/2)
+        LE,    // DOS extender (DOS/4GW & co.) or VxD
+        LX,
+        PE     // Win32 / Win64
+    };
+
+    // <-- Executable Header Analysis -->
+    // Classifies a program from its headers alone: the MZ stub, the NE/LE/LX/PE
+    // header it points at, and for PE the StringFileInfo of the version
+    // resource. The file is memory-mapped and only the pages holding those
+    // structures are ever touched (two or three for a typical game), so whole
+    // folders of executables classify in milliseconds. Every offset is bounds
+    // checked; a truncated or hostile file just reads as less specific.
+    struct ExecutableInfo
+    {
+        ExecutableFormat format = ExecutableFormat::Unknown;
+        bool windows = false;       // Needs a Windows guest rather than DOS
+        bool dosExtended = false;   // DOS program that switches to protected mode
+        bool is64Bit = false;
+        uint16_t machine = 0;       // PE machine type
+        uint16_t subsystem = 0;     // PE subsystem (2 = GUI, 3 = console)
+        uint8_t targetOS = 0;       // NE/LE/LX target OS field
+        uint32_t imageKB = 0;       // MZ load image plus its minimum allocation
+
+        // PE version resource, UTF-8; empty when absent
+        std::string productName;
+        std::string fileDescription;
+        std::string companyName;
+
+        bool Read(const fs::path &path);
+        bool Parse(const uint8_t *data, size_t size, bool comExtension);
+
+        const char *FormatName() const;
+        GamePlatform Platform() const { return windows ? GamePlatform::Windows : GamePlatform::DOS; }
+        int SuggestedRamKB() const;
+
+        // Fills in what the headers tell about `game`. A fresh entry takes the
+        // name, description, platform and hardware defaults; an existing one
+        // only gets its platform corrected (with that platform's defaults if it
+        // changed) and a description if it had none.
+        void ApplyTo(GameEntry &game, bool fresh) const;
+
+        // Decodes the program's first icon group (PE or NE), taking the image
+        // nearest `size` pixels and scaling it to size x size RGBA. False if
+        // there is no icon.
+        static bool ReadIcon(const fs::path &path, int size, std::vector<uint8_t> &rgba);
+    };
+
+} // namespace Core
+
+#endif // EXECUTABLEINFO_H
@@ -0,0 +1,521 @@
+#include "pch.h"
+#include "Core/FilterQuery.h"
+#include "Core/GameLibrary.h"
+#include "Core/RowBitmap.h"
+#include "Core/TextFold.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+namespace Core
+{
+
+    // <-- Field Vocabulary -->
+    // Value names are listed in enum order; index = stored value
+    static const char *PLATFORM_VALUES[] = {"dos", "windows", "dreamm"};
+    static const char *STATUS_VALUES[] = {"unplayable", "playable"};
+    static const char *MACHINE_VALUES[] = {"pc", "tandy"};
+    static const char *VIDEOHW_VALUES[] = {"hercules", "cga", "ega", "mcga", "vga", "svga"};
+
+    struct FieldInfo
+    {
+        const char *name;
+        FilterField field;
+        const char *const *values; // nullptr = numeric or tag
+        int valueCount;
+    };
+
+    static const FieldInfo FIELDS[] = {
+        {"platform", FilterField::Platform, PLATFORM_VALUES, 3},
+        {"status", FilterField::Status, STATUS_VALUES, 2},
+        {"machine", FilterField::Machine, MACHINE_VALUES, 2},
+        {"videohw", FilterField::VideoHw, VIDEOHW_VALUES, 6},
+        {"video", FilterField::VideoHw, VIDEOHW_VALUES, 6},
+        {"ram", FilterField::RamKB, nullptr, 0},
+        {"mips", FilterField::Mips, nullptr, 0},
+        {"tag", FilterField::Tag, nullptr, 0},
+        {"collection", FilterField::Tag, nullptr, 0},
+    };
+
+    enum class CompareOp
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    static std::string Folded(std::string_view s)
+    {
+        std::string out(s);
+        for (char &c : out)
+            c = FoldAscii(c);
+        return out;
+    }
+
+    // "studio" covers "studio" and "studio/LucasArts", not "studios"
+    static bool TagCovers(std::string_view foldedTag, std::string_view name)
+    {
+        if (foldedTag.size() < name.size() || foldedTag.compare(0, name.size(), name) != 0)
+            return false;
+        return foldedTag.size() == name.size() || foldedTag[name.size()] == '/';
+    }
+
+    static const FieldInfo *FindField(std::string_view name)
+    {
+        for (const FieldInfo &info : FIELDS)
+        {
+            if (EqualsNoCase(name, info.name))
+                return &info;
+        }
+        return nullptr;
+    }
+
+    // "16MB", "640kb", "1.5g"; bare numbers are MB. Returns false on junk.
+    static bool ParseRamKB(std::string_view text, int32_t &outKB)
+    {
+        std::string buffer(text);
+        char *end = nullptr;
+        double value = std::strtod(buffer.c_str(), &end);
+        if (end == buffer.c_str() || value < 0.0)
+            return false;
+
+        std::string_view unit(end);
+        double scale = 1024.0;
+        if (unit.empty() || EqualsNoCase(unit, "m") || EqualsNoCase(unit, "mb"))
+            scale = 1024.0;
+        else if (EqualsNoCase(unit, "k") || EqualsNoCase(unit, "kb"))
+            scale = 1.0;
+        else if (EqualsNoCase(unit, "g") || EqualsNoCase(unit, "gb"))
+            scale = 1024.0 * 1024.0;
+        else
+            return false;
+
+        double kb = value * scale;
+        if (kb > (double)INT_MAX)
+            return false;
+        outKB = (int32_t)std::lround(kb);
+        return true;
+    }
+
+    static bool ParseMips(std::string_view text, int32_t &outMips)
+    {
+        if (StartsWithNoCase("unlimited", text) || EqualsNoCase(text, "max"))
+        {
+            outMips = 0; // Stored as 0
+            return true;
+        }
+        std::string buffer(text);
+        char *end = nullptr;
+        long value = std::strtol(buffer.c_str(), &end, 10);
+        if (end == buffer.c_str() || *end != '\0' || value < 0 || value > INT_MAX)
+            return false;
+        outMips = (int32_t)value;
+        return true;
+    }
+
+    // <-- Parsing -->
+    void FilterQuery::Compile(std::string_view text)
+    {
+        m_tests.clear();
+        m_tagTests.clear();
+        m_freeText.clear();
+        m_error.clear();
+        m_never = false;
+
+        size_t pos = 0;
+        while (pos < text.size())
+        {
+            size_t start = text.find_first_not_of(" \t", pos);
+            if (start == std::string_view::npos)
+                break;
+            // Whitespace inside double quotes doesn't split (tag:"tested on dreamm")
+            size_t end = start;
+            bool quoted = false;
+            while (end < text.size() && (quoted || (text[end] != ' ' && text[end] != '\t')))
+            {
+                if (text[end] == '"')
+                    quoted = !quoted;
+                end++;
+            }
+            std::string_view token = text.substr(start, end - start);
+            pos = end;
+
+            if (!ParseClause(token))
+            {
+                if (!m_freeText.empty())
+                    m_freeText += ' ';
+                m_freeText.append(token);
+            }
+        }
+        Finish();
+    }
+
+    // Returns false if the token isn't a clause for a known field (it's free text then)
+    bool FilterQuery::ParseClause(std::string_view token)
+    {
+        bool negate = false;
+        if (token.size() > 1 && (token[0] == '-' || token[0] == '!'))
+        {
+            negate = true;
+            token.remove_prefix(1);
+        }
+
+        // #name is shorthand for tag:name
+        const FieldInfo *info = nullptr;
+        std::string_view rest;
+        if (token.size() > 1 && token[0] == '#')
+        {
+            info = FindField("tag");
+            rest = token; // '#' then reads as the ':' operator below
+        }
+        else
+        {
+            size_t opPos = token.find_first_of(":=<>!");
+            if (opPos == 0 || opPos == std::string_view::npos)
+                return false;
+            info = FindField(token.substr(0, opPos));
+            if (!info)
+                return false;
+            rest = token.substr(opPos);
+        }
+
+        // Operator
+        CompareOp op = CompareOp::Equal;
+        size_t opLength = 1;
+        if (rest.compare(0, 2, "!=") == 0)
+        {
+            op = CompareOp::NotEqual;
+            opLength = 2;
+        }
+        else if (rest.compare(0, 2, "<=") == 0)
+        {
+            op = CompareOp::LessEqual;
+            opLength = 2;
+        }
+        else if (rest.compare(0, 2, ">=") == 0)
+        {
+            op = CompareOp::GreaterEqual;
+            opLength = 2;
+        }
+        else if (rest.compare(0, 2, "==") == 0)
+            opLength = 2;
+        else if (rest[0] == '<')
+            op = CompareOp::Less;
+        else if (rest[0] == '>')
+            op = CompareOp::Greater;
+        else if (rest[0] == '!')
+            return false; // "name!" is text, not a clause
+
+        std::string_view value = rest.substr(opLength);
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            value = value.substr(1, value.size() - 2);
+        auto fail = [&](const std::string &message)
+        {
+            if (!m_error.empty())
+                m_error += "; ";
+            m_error += message;
+            return true; // Consumed: a typo in a clause shouldn't turn into a name search
+        };
+        if (value.empty())
+            return fail(std::string(info->name) + ": missing value");
+
+        if (info->values)
+        {
+            // Enum field: every form becomes a bitmask over the field's values
+            uint32_t all = (1u << info->valueCount) - 1;
+            uint32_t mask = 0;
+            bool ordered = (op != CompareOp::Equal && op != CompareOp::NotEqual);
+
+            size_t partStart = 0;
+            while (partStart <= value.size())
+            {
+                size_t partEnd = value.find(',', partStart);
+                if (partEnd == std::string_view::npos)
+                    partEnd = value.size();
+                std::string_view part = value.substr(partStart, partEnd - partStart);
+                partStart = partEnd + 1;
+                if (part.empty())
+                    continue;
+
+                // Exact name first so "ega" doesn't also pick "vga"-style neighbours by prefix
+                int exact = -1;
+                uint32_t partMask = 0;
+                for (int v = 0; v < info->valueCount; ++v)
+                {
+                    if (EqualsNoCase(part, info->values[v]))
+                        exact = v;
+                    else if (StartsWithNoCase(info->values[v], part))
+                        partMask |= 1u << v;
+                }
+                if (exact >= 0)
+                    partMask = 1u << exact;
+                if (partMask == 0)
+                    return fail(std::string(info->name) + ": unknown value '" + std::string(part) + "'");
+
+                if (ordered)
+                {
+                    // Relative to the first matching value in enum order (videohw>=vga)
+                    int pivot = 0;
+                    while (!(partMask & (1u << pivot)))
+                        pivot++;
+                    uint32_t below = (1u << pivot) - 1;
+                    uint32_t self = 1u << pivot;
+                    switch (op)
+                    {
+                    case CompareOp::Less:
+                        partMask = below;
+                        break;
+                    case CompareOp::LessEqual:
+                        partMask = below | self;
+                        break;
+                    case CompareOp::Greater:
+                        partMask = all & ~(below | self);
+                        break;
+                    default:
+                        partMask = all & ~below;
+                        break;
+                    }
+                }
+                mask |= partMask;
+            }
+
+            if (op == CompareOp::NotEqual)
+                mask = all & ~mask;
+            if (negate)
+                mask = all & ~mask;
+            Require(info->field, mask);
+            return true;
+        }
+
+        if (info->field == FilterField::Tag)
+        {
+            if (op != CompareOp::Equal && op != CompareOp::NotEqual)
+                return fail(std::string(info->name) + ": use ':' or '!='");
+
+            TagTest test;
+            test.exclude = negate != (op == CompareOp::NotEqual);
+            size_t partStart = 0;
+            while (partStart <= value.size())
+            {
+                size_t partEnd = value.find(',', partStart);
+                if (partEnd == std::string_view::npos)
+                    partEnd = value.size();
+                std::string_view part = value.substr(partStart, partEnd - partStart);
+                partStart = partEnd + 1;
+                if (!part.empty())
+                    test.names.push_back(Folded(part));
+            }
+            if (test.names.empty())
+                return fail(std::string(info->name) + ": missing value");
+            m_tagTests.push_back(std::move(test));
+            return true;
+        }
+
+        // Numeric field: one value, one range
+        if (value.find(',') != std::string_view::npos)
+            return fail(std::string(info->name) + ": lists need ':' on named values only");
+
+        int32_t number = 0;
+        bool parsed = (info->field == FilterField::RamKB) ? ParseRamKB(value, number) : ParseMips(value, number);
+        if (!parsed)
+            return fail(std::string(info->name) + ": can't read '" + std::string(value) + "'");
+
+        int32_t lo = INT_MIN;
+        int32_t hi = INT_MAX;
+        bool exclude = negate;
+        switch (op)
+        {
+        case CompareOp::Equal:
+            lo = hi = number;
+            break;
+        case CompareOp::NotEqual:
+            lo = hi = number;
+            exclude = !exclude;
+            break;
+        case CompareOp::Less:
+            hi = (number == INT_MIN) ? INT_MIN : number - 1;
+            break;
+        case CompareOp::LessEqual:
+            hi = number;
+            break;
+        case CompareOp::Greater:
+            lo = (number == INT_MAX) ? INT_MAX : number + 1;
+            break;
+        case CompareOp::GreaterEqual:
+            lo = number;
+            break;
+        }
+        AddRange(info->field, lo, hi, exclude);
+        return true;
+    }
+
+    // <-- Compilation -->
+    void FilterQuery::Require(FilterField field, uint32_t valueMask)
+    {
+        for (Test &test : m_tests)
+        {
+            if (test.field == field && !test.isRange)
+            {
+                test.mask &= valueMask;
+                Finish();
+                return;
+            }
+        }
+        m_tests.push_back(Test{field, false, false, valueMask, 0, 0});
+        Finish();
+    }
+
+    void FilterQuery::RequireTag(std::string_view tag)
+    {
+        m_tagTests.push_back(TagTest{{Folded(tag)}, false});
+    }
+
+    void FilterQuery::AddRange(FilterField field, int32_t lo, int32_t hi, bool exclude)
+    {
+        if (!exclude)
+        {
+            for (Test &test : m_tests)
+            {
+                if (test.field == field && test.isRange && !test.exclude)
+                {
+                    test.lo = std::max(test.lo, lo);
+                    test.hi = std::min(test.hi, hi);
+                    return;
+                }
+            }
+        }
+        m_tests.push_back(Test{field, true, exclude, 0, lo, hi});
+    }
+
+    // Flags clauses that can never match, so Select() can skip the bitmaps
+    void FilterQuery::Finish()
+    {
+        m_never = false;
+        for (const Test &test : m_tests)
+        {
+            if (test.isRange ? (!test.exclude && test.lo > test.hi) : (test.mask == 0))
+                m_never = true;
+        }
+    }
+
+    // <-- Evaluation -->
+    void FilterQuery::Select(const GameLibrary &library, RowBitmap &out) const
+    {
+        out.Clear();
+        if (m_never)
+            return;
+
+        const LibraryBitmaps &bitmaps = library.Bitmaps();
+        out = bitmaps.all;
+
+        // Enum fields: Or the value rows within a field, And across fields
+        bool hasRanges = false;
+        for (const Test &test : m_tests)
+        {
+            if (test.isRange)
+            {
+                hasRanges = true;
+                continue;
+            }
+
+            const RowBitmap *values = nullptr;
+            int count = 0;
+            switch (test.field)
+            {
+            case FilterField::Platform:
+                values = bitmaps.platform;
+                count = 3;
+                break;
+            case FilterField::Status:
+                values = bitmaps.status;
+                count = 2;
+                break;
+            case FilterField::Machine:
+                values = bitmaps.machine;
+                count = 2;
+                break;
+            case FilterField::VideoHw:
+                values = bitmaps.videoHw;
+                count = 6;
+                break;
+            default:
+                continue;
+            }
+
+            uint32_t all = (1u << count) - 1;
+            if ((test.mask & all) == all)
+                continue;
+
+            int single = -1;
+            int selected = 0;
+            for (int v = 0; v < count; ++v)
+            {
+                if (test.mask & (1u << v))
+                {
+                    single = v;
+                    selected++;
+                }
+            }
+            if (selected == 1)
+            {
+                out.And(values[single]);
+                continue;
+            }
+
+            RowBitmap any;
+            for (int v = 0; v < count; ++v)
+            {
+                if (test.mask & (1u << v))
+                    any.Or(values[v]);
+            }
+            out.And(any);
+        }
+
+        // Tags: the union of every tag each clause covers
+        for (const TagTest &test : m_tagTests)
+        {
+            RowBitmap any;
+            for (size_t t = 0; t < bitmaps.tags.size(); ++t)
+            {
+                std::string tag = Folded(bitmaps.tags[t]);
+                for (const std::string &name : test.names)
+                {
+                    if (TagCovers(tag, name))
+                    {
+                        any.Or(bitmaps.tagRows[t]);
+                        break;
+                    }
+                }
+            }
+            if (test.exclude)
+                out.AndNot(any);
+            else
+                out.And(any);
+        }
+
+        if (!hasRanges || out.Empty())
+            return;
+
+        // Numeric ranges: only the rows still in the set are read
+        RowBitmap kept;
+        out.ForEach([&](uint32_t row)
+                    {
+            for (const Test &test : m_tests)
+            {
+                if (!test.isRange)
+                    continue;
+                int32_t value = (test.field == FilterField::RamKB) ? library.RamKB(row) : library.Mips(row);
+                bool inside = (value >= test.lo && value <= test.hi);
+                if (inside == test.exclude)
+                    return;
+            }
+            kept.Add(row); });
+        out = std::move(kept);
+    }
+
+} // namespace Core
@@ -0,0 +1,94 @@
+#ifndef FILTERQUERY_H
+#define FILTERQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+    class GameLibrary;
+    class RowBitmap;
+
+    // Fields a filter clause can test
+    enum class FilterField : uint8_t
+    {
+        Platform,
+        Status,
+        Machine,
+        VideoHw,
+        RamKB,
+        Mips,
+        Tag,
+        Count
+    };
+
+    // <-- Compiled Filter Query -->
+    // Splits the library filter text into field clauses and free text:
+    //
+    //     platform:win status:playable ram>=16MB videohw:svga machine:tandy monkey
+    //
+    // Clauses are `field op value` with op one of : = != < <= > >=. A leading
+    // '-' negates a clause, ',' lists alternatives (platform:dos,win) and
+    // values may be abbreviated (status:play). RAM takes KB/MB/GB suffixes and
+    // defaults to MB; mips:unlimited is 0. tag:studio (or #studio) matches that
+    // tag and any nested under it ("studio/LucasArts"); quote values with
+    // spaces (tag:"tested on dreamm 4.x"). Anything that isn't a clause for a
+    // known field (including "Star Trek: 25th") stays in the free text, which
+    // goes to the name and full-text searches.
+    //
+    // Compile() folds every clause on a field into one test, a value bitmask
+    // for the enum fields or a [lo, hi] range for the numeric ones. Select()
+    // turns the enum and tag tests into Or/And/AndNot over the library's row
+    // bitmaps and only visits the surviving rows for the numeric ranges.
+    class FilterQuery
+    {
+    public:
+        // Parses and compiles `text`; bad clauses are dropped and reported in Error()
+        void Compile(std::string_view text);
+
+        // Adds "field is one of the values in mask" (the sidebar combos)
+        void Require(FilterField field, uint32_t valueMask);
+        void RequireTag(std::string_view tag);
+
+        // Library positions passing every clause
+        void Select(const GameLibrary &library, RowBitmap &out) const;
+
+        bool Never() const { return m_never; } // Clauses contradict each other
+        bool HasTests() const { return !m_tests.empty() || !m_tagTests.empty(); }
+        const std::string &FreeText() const { return m_freeText; }
+        const std::string &Error() const { return m_error; }
+
+    private:
+        struct Test
+        {
+            FilterField field;
+            bool isRange;
+            bool exclude; // Range tests only: pass when the value is outside [lo, hi]
+            uint32_t mask;
+            int32_t lo;
+            int32_t hi;
+        };
+
+        struct TagTest
+        {
+            std::vector<std::string> names; // Folded; any of them (or a tag nested under one) passes
+            bool exclude;
+        };
+
+        bool ParseClause(std::string_view token);
+        void AddRange(FilterField field, int32_t lo, int32_t hi, bool exclude);
+        void Finish();
+
+        std::vector<Test> m_tests;
+        std::vector<TagTest> m_tagTests;
+        std::string m_freeText;
+        std::string m_error;
+        bool m_never = false;
+    };
+
+} // namespace Core
+
+#endif // FILTERQUERY_H
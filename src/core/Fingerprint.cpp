@@ -0,0 +1,230 @@
+#include "pch.h"
+#include "Core/Fingerprint.h"
+#include "Core/MappedFile.h"
+#include "Core/TextFold.h"
+
+#include <cstring>
+
+namespace Core
+{
+
+    static const char FINGERPRINT_CACHE_MAGIC[8] = {'M', 'O', 'R', 'T', 'F', 'P', 'C', '\0'};
+
+    // <-- XXH64 -->
+    static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+    static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+    static const uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+    static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+    static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+    static inline uint64_t RotateLeft(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static inline uint64_t Read64(const uint8_t *p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value; // Little-endian hosts only, like the file formats
+    }
+
+    static inline uint32_t Read32(const uint8_t *p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static inline uint64_t Round(uint64_t accumulator, uint64_t input)
+    {
+        accumulator += input * PRIME64_2;
+        accumulator = RotateLeft(accumulator, 31);
+        return accumulator * PRIME64_1;
+    }
+
+    static inline uint64_t MergeRound(uint64_t hash, uint64_t accumulator)
+    {
+        hash ^= Round(0, accumulator);
+        return hash * PRIME64_1 + PRIME64_4;
+    }
+
+    uint64_t Xxh64(const uint8_t *data, size_t size, uint64_t seed)
+    {
+        const uint8_t *p = data;
+        const uint8_t *end = data + size;
+        uint64_t hash;
+
+        if (size >= 32)
+        {
+            // Four independent lanes per 32-byte stripe, so the rounds pipeline
+            uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+            uint64_t v2 = seed + PRIME64_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - PRIME64_1;
+            const uint8_t *limit = end - 32;
+            do
+            {
+                v1 = Round(v1, Read64(p));
+                v2 = Round(v2, Read64(p + 8));
+                v3 = Round(v3, Read64(p + 16));
+                v4 = Round(v4, Read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + PRIME64_5;
+        }
+
+        hash += (uint64_t)size;
+
+        for (; p + 8 <= end; p += 8)
+        {
+            hash ^= Round(0, Read64(p));
+            hash = RotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+        }
+        if (p + 4 <= end)
+        {
+            hash ^= (uint64_t)Read32(p) * PRIME64_1;
+            hash = RotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+        {
+            hash ^= (*p) * PRIME64_5;
+            hash = RotateLeft(hash, 11) * PRIME64_1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME64_2;
+        hash ^= hash >> 29;
+        hash *= PRIME64_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    // <-- Hashing -->
+    bool FingerprintCache::HashFile(const fs::path &path, FileFingerprint &out)
+    {
+        std::error_code ec;
+        uint64_t fileSize = fs::file_size(path, ec);
+        if (ec)
+            return false;
+
+        // Mapping an empty file fails; its hash is still well defined
+        if (fileSize == 0)
+        {
+            static const uint8_t EMPTY[1] = {};
+            out.hash = Xxh64(EMPTY, 0);
+            out.fileSize = 0;
+            return true;
+        }
+
+        MappedFile file;
+        if (!file.Open(path))
+            return false;
+        out.hash = Xxh64(file.Data(), file.Size());
+        out.fileSize = file.Size();
+        return true;
+    }
+
+    bool FingerprintCache::Fingerprint(const fs::path &path, FileFingerprint &out)
+    {
+        std::error_code ec;
+        uint64_t fileSize = fs::file_size(path, ec);
+        if (ec)
+            return false;
+        int64_t writeTime = (int64_t)fs::last_write_time(path, ec).time_since_epoch().count();
+        if (ec)
+            return false;
+
+        std::string key = FoldPath(path.u8string());
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(key);
+            if (it != m_entries.end() && it->second.fileSize == fileSize && it->second.writeTime == writeTime)
+            {
+                out.hash = it->second.hash;
+                out.fileSize = fileSize;
+                return true;
+            }
+        }
+
+        // Outside the lock: other threads keep answering from the cache meanwhile
+        if (!HashFile(path, out))
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[key] = Entry{out.fileSize, writeTime, out.hash};
+        m_dirty = true;
+        return true;
+    }
+
+    // <-- Cache File -->
+    bool FingerprintCache::Load(const fs::path &cacheFile)
+    {
+        MappedFile file;
+        if (!file.Open(cacheFile) || file.Size() < sizeof(FingerprintCacheHeader))
+            return false;
+
+        const uint8_t *base = file.Data();
+        FingerprintCacheHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, FINGERPRINT_CACHE_MAGIC, sizeof(FINGERPRINT_CACHE_MAGIC)) != 0 || header.version != VERSION)
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.reserve(header.recordCount);
+        size_t offset = sizeof(header);
+        for (uint32_t i = 0; i < header.recordCount; ++i)
+        {
+            FingerprintCacheRecord record;
+            if (file.Size() - offset < sizeof(record))
+                break;
+            std::memcpy(&record, base + offset, sizeof(record));
+            offset += sizeof(record);
+            if (file.Size() - offset < record.pathLength)
+                break;
+
+            m_entries.emplace(std::string(reinterpret_cast<const char *>(base + offset), record.pathLength),
+                              Entry{record.fileSize, record.writeTime, record.hash});
+            offset += record.pathLength;
+        }
+
+        SDL_Log("Loaded %d cached executable fingerprints.", (int)m_entries.size());
+        return true;
+    }
+
+    std::string FingerprintCache::Serialize() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        FingerprintCacheHeader header = {};
+        std::memcpy(header.magic, FINGERPRINT_CACHE_MAGIC, sizeof(FINGERPRINT_CACHE_MAGIC));
+        header.version = VERSION;
+        header.recordCount = (uint32_t)m_entries.size();
+
+        std::string contents;
+        contents.reserve(sizeof(header) + m_entries.size() * (sizeof(FingerprintCacheRecord) + 64));
+        contents.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (const auto &it : m_entries)
+        {
+            FingerprintCacheRecord record = {};
+            record.fileSize = it.second.fileSize;
+            record.writeTime = it.second.writeTime;
+            record.hash = it.second.hash;
+            record.pathLength = (uint32_t)it.first.size();
+            contents.append(reinterpret_cast<const char *>(&record), sizeof(record));
+            contents.append(it.first);
+        }
+        return contents;
+    }
+
+} // namespace Core
@@ -0,0 +1,79 @@
+#ifndef FINGERPRINT_H
+#define FINGERPRINT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // XXH64 (the reference algorithm, so catalogues can be built with `xxhsum -H1`)
+    uint64_t Xxh64(const uint8_t *data, size_t size, uint64_t seed = 0);
+
+    struct FileFingerprint
+    {
+        uint64_t hash = 0; // XXH64 of the whole file
+        uint64_t fileSize = 0;
+    };
+
+    // <-- On-Disk Layout (fingerprints.cache, little-endian) -->
+    // [Header][Records: record + folded path bytes]
+    struct FingerprintCacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordCount;
+    };
+
+    struct FingerprintCacheRecord
+    {
+        uint64_t fileSize;
+        int64_t writeTime;
+        uint64_t hash;
+        uint32_t pathLength;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(FingerprintCacheHeader) == 16, "FingerprintCacheHeader layout changed");
+    static_assert(sizeof(FingerprintCacheRecord) == 32, "FingerprintCacheRecord layout changed");
+
+    // <-- Executable Fingerprints -->
+    // Content hashes of executables, remembered by path, size and write
+    // time so a file is only ever read once until it changes. Safe to use
+    // from any thread; discovery workers and the UI share one cache.
+    class FingerprintCache
+    {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        bool Load(const fs::path &cacheFile);
+        std::string Serialize() const;
+        bool TakeDirty() { return m_dirty.exchange(false); }
+
+        // Stats the file; hashes it only if the cache has no match
+        bool Fingerprint(const fs::path &path, FileFingerprint &out);
+
+        static bool HashFile(const fs::path &path, FileFingerprint &out);
+
+    private:
+        struct Entry
+        {
+            uint64_t fileSize;
+            int64_t writeTime;
+            uint64_t hash;
+        };
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries; // By folded path
+        std::atomic<bool> m_dirty{false};
+    };
+
+} // namespace Core
+
+#endif // FINGERPRINT_H
@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "Core/FranchiseIndex.h"
+#include "Core/GameDatabase.h"
+#include "Core/GameLibrary.h"
+#include "Core/TextFold.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace Core
+{
+
+    // Parenthesised suffixes that mark a variant rather than part of the title
+    static const char *VARIANT_WORDS[] = {
+        "windows", "win", "dos", "mac", "fm towns", "fm-towns", "amiga", "demo", "cd", "cd-rom",
+        "floppy", "ega", "vga", "talkie", "enhanced", "english", "german", "french", "spanish", "italian"};
+
+    static const size_t VARIANT_WORD_MAX = 8;
+
+    // <-- Keys -->
+    std::string_view FranchiseIndex::BaseTitle(std::string_view name)
+    {
+        for (;;)
+        {
+            while (!name.empty() && name.back() == ' ')
+                name.remove_suffix(1);
+
+            // " - DE", as ResolveDreammGameName appends for languages
+            if (name.size() > 5 && name.compare(name.size() - 5, 3, " - ") == 0 &&
+                ::isupper((unsigned char)name[name.size() - 2]) && ::isupper((unsigned char)name[name.size() - 1]))
+            {
+                name.remove_suffix(5);
+                continue;
+            }
+
+            // " (Windows)", " (Demo)" and friends
+            if (!name.empty() && name.back() == ')')
+            {
+                size_t open = name.rfind('(');
+                if (open != std::string_view::npos && open > 0 && name.size() - open - 2 <= VARIANT_WORD_MAX)
+                {
+                    std::string_view word = name.substr(open + 1, name.size() - open - 2);
+                    bool variant = false;
+                    for (const char *known : VARIANT_WORDS)
+                        variant = variant || EqualsNoCase(word, known);
+                    if (variant)
+                    {
+                        name = name.substr(0, open);
+                        continue;
+                    }
+                }
+            }
+            return name;
+        }
+    }
+
+    std::string_view FranchiseIndex::DreammFolderId(std::string_view installPath)
+    {
+        while (!installPath.empty() && (installPath.back() == '\\' || installPath.back() == '/'))
+            installPath.remove_suffix(1);
+
+        // Peel <version>, <folder id> and check the parent is "install"
+        std::string_view parts[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            size_t sep = installPath.find_last_of("\\/");
+            parts[i] = (sep == std::string_view::npos) ? installPath : installPath.substr(sep + 1);
+            if (sep == std::string_view::npos)
+            {
+                if (i < 2)
+                    return std::string_view();
+                break;
+            }
+            installPath = installPath.substr(0, sep);
+        }
+        if (!EqualsNoCase(parts[2], "install") || parts[1].empty() || parts[1][0] == '~')
+            return std::string_view();
+        return parts[1];
+    }
+
+    // <-- Build -->
+    bool FranchiseIndex::Update(const GameLibrary &library)
+    {
+        if (m_revision == library.Revision())
+            return false;
+        m_revision = library.Revision();
+
+        const size_t count = library.Size();
+
+        m_groups.clear();
+        m_groupOf.assign(count, 0);
+        std::unordered_map<std::string, uint32_t> groupOfKey;
+        groupOfKey.reserve(count / 2);
+        std::vector<uint32_t> sizes;
+        std::string install;
+        std::string key;
+        std::string previousKey;
+        uint32_t previousGroup = 0;
+
+        for (size_t row = 0; row < count; ++row)
+        {
+            // Titles are only resolved for the first member of a group
+            library.PeekPath(row, GamePath::Install, install);
+            std::string_view folderId = DreammFolderId(install);
+            std::string_view baseTitle;
+            if (!folderId.empty())
+            {
+                key.assign("dreamm:");
+                key += folderId;
+            }
+            else
+            {
+                baseTitle = BaseTitle(library.Name(row));
+                key.assign("title:");
+                key += baseTitle;
+            }
+            for (size_t i = 6; i < key.size(); ++i)
+                key[i] = FoldAscii(key[i]);
+
+            // Rows are in name order, so variants named after one title are mostly adjacent
+            if (row > 0 && key == previousKey)
+            {
+                m_groupOf[row] = previousGroup;
+                sizes[previousGroup]++;
+                continue;
+            }
+
+            auto found = groupOfKey.find(key);
+            if (found == groupOfKey.end())
+            {
+                std::string title(baseTitle);
+                if (!folderId.empty())
+                {
+                    std::string_view known = GameDatabase::FindDreammTitle(folderId);
+                    title = known.empty() ? std::string(folderId) : std::string(known);
+                }
+                found = groupOfKey.emplace(key, (uint32_t)m_groups.size()).first;
+                m_groups.push_back(FranchiseGroup{key, std::move(title), 0, 0});
+                sizes.push_back(0);
+            }
+            m_groupOf[row] = found->second;
+            sizes[found->second]++;
+            previousKey.swap(key);
+            previousGroup = found->second;
+        }
+
+        // Title order (case-insensitive, folded once up front), then renumber so group ids follow it
+        std::vector<std::string> folded(m_groups.size());
+        for (size_t g = 0; g < m_groups.size(); ++g)
+        {
+            folded[g] = m_groups[g].title;
+            for (char &c : folded[g])
+                c = FoldAscii(c);
+        }
+        std::vector<uint32_t> order(m_groups.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                  {
+            int cmp = folded[a].compare(folded[b]);
+            return cmp != 0 ? cmp < 0 : m_groups[a].key < m_groups[b].key; });
+
+        std::vector<uint32_t> renumber(m_groups.size());
+        std::vector<FranchiseGroup> sorted;
+        sorted.reserve(m_groups.size());
+        uint32_t first = 0;
+        for (uint32_t g : order)
+        {
+            renumber[g] = (uint32_t)sorted.size();
+            sorted.push_back(std::move(m_groups[g]));
+            sorted.back().first = first;
+            first += sizes[g];
+        }
+        m_groups.swap(sorted);
+
+        // Counting sort of rows into their groups keeps each group in name order
+        m_members.assign(count, 0);
+        for (FranchiseGroup &group : m_groups)
+            group.count = 0;
+        for (size_t row = 0; row < count; ++row)
+        {
+            uint32_t g = renumber[m_groupOf[row]];
+            m_groupOf[row] = g;
+            FranchiseGroup &group = m_groups[g];
+            m_members[group.first + group.count++] = (uint32_t)row;
+        }
+        return true;
+    }
+
+} // namespace Core
@@ -0,0 +1,57 @@
+#ifndef FRANCHISEINDEX_H
+#define FRANCHISEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+    class GameLibrary;
+
+    struct FranchiseGroup
+    {
+        std::string key;   // "dreamm:<folder id>" or "title:<folded base title>"
+        std::string title; // From GameDatabase::FindDreammTitle, else the base title
+        uint32_t first;    // Into the member array
+        uint32_t count;
+    };
+
+    // <-- Franchise Grouping -->
+    // Groups every variant of a game (versions, platforms, demos, languages)
+    // under one node. DREAMM installs (<root>/install/<folder id>/<version>)
+    // group by folder id and take the title from the DREAMM id map; other
+    // entries group by their name with variant suffixes such as "(Windows)",
+    // "(Demo)" or " - DE" removed.
+    //
+    // Built in one pass per library revision: groups sorted by title, members
+    // stored contiguously in library (name) order, plus a row -> group table.
+    class FranchiseIndex
+    {
+    public:
+        // Rebuilds if the library changed since the last call; returns true if it did
+        bool Update(const GameLibrary &library);
+
+        size_t GroupCount() const { return m_groups.size(); }
+        const FranchiseGroup &Group(size_t group) const { return m_groups[group]; }
+        const uint32_t *Members(size_t group) const { return m_members.data() + m_groups[group].first; }
+        uint32_t GroupOf(size_t row) const { return m_groupOf[row]; }
+
+        // "Day of the Tentacle (Windows) (Demo) - DE" -> "Day of the Tentacle"
+        static std::string_view BaseTitle(std::string_view name);
+
+        // Folder id of a path shaped like .../install/<folder id>/<version>, or empty
+        static std::string_view DreammFolderId(std::string_view installPath);
+
+    private:
+        std::vector<FranchiseGroup> m_groups;
+        std::vector<uint32_t> m_members;
+        std::vector<uint32_t> m_groupOf;
+        uint64_t m_revision = 0;
+    };
+
+} // namespace Core
+
+#endif // FRANCHISEINDEX_H
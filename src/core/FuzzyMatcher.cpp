@@ -0,0 +1,410 @@
+#include "pch.h"
+#include "Core/FuzzyMatcher.h"
+#include "Core/GameLibrary.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define FUZZY_SSE2 1
+#endif
+
+namespace Core
+{
+
+    // <-- Scoring Constants (fzf's v2 scheme, lightly simplified) -->
+    static const int SCORE_MATCH = 16;
+    static const int SCORE_GAP_START = -3;
+    static const int SCORE_GAP_EXTENSION = -1;
+    static const int BONUS_BOUNDARY = 8;     // After a space, punctuation or the start
+    static const int BONUS_CAMEL = 7;        // lower -> Upper, letter -> digit
+    static const int BONUS_CONSECUTIVE = 4;  // Continuing a run
+    static const int BONUS_FIRST_CHAR = 2;   // Multiplier on the first term character's bonus
+
+    static const size_t MAX_NAME_CHARS = 256;
+    static const size_t MAX_TERM_CHARS = 64;
+    static const int NO_MATCH = -1000000;
+
+    enum CharClass : uint8_t
+    {
+        ClassOther,
+        ClassLower,
+        ClassUpper,
+        ClassDigit
+    };
+
+    // Bonus for a character of class [cur] following one of class [prev]
+    static const int8_t TRANSITION_BONUS[4][4] = {
+        // Other, Lower, Upper, Digit
+        {0, BONUS_BOUNDARY, BONUS_BOUNDARY, BONUS_BOUNDARY}, // after Other
+        {0, 0, BONUS_CAMEL, BONUS_CAMEL},                    // after Lower
+        {0, 0, 0, BONUS_CAMEL},                              // after Upper
+        {0, 0, 0, 0},                                        // after Digit
+    };
+
+    // ASCII fold and class, one lookup per byte on the hot path
+    struct AsciiTable
+    {
+        uint8_t fold[128];
+        CharClass cls[128];
+
+        AsciiTable()
+        {
+            for (int c = 0; c < 128; ++c)
+            {
+                fold[c] = (uint8_t)c;
+                cls[c] = ClassOther;
+                if (c >= 'a' && c <= 'z')
+                    cls[c] = ClassLower;
+                else if (c >= 'A' && c <= 'Z')
+                {
+                    fold[c] = (uint8_t)(c + 0x20);
+                    cls[c] = ClassUpper;
+                }
+                else if (c >= '0' && c <= '9')
+                    cls[c] = ClassDigit;
+            }
+        }
+    };
+    static const AsciiTable ASCII;
+
+    // <-- UTF-8 & Folding -->
+    // Decodes one code point; invalid bytes come back as themselves
+    static char32_t DecodeUtf8(std::string_view s, size_t &i)
+    {
+        uint8_t c = (uint8_t)s[i++];
+        if (c < 0x80)
+            return c;
+
+        int extra = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : 0;
+        char32_t cp = c & (0x3F >> extra);
+        if (extra == 0 || i + extra > s.size())
+            return c;
+        for (int k = 0; k < extra; ++k)
+        {
+            uint8_t next = (uint8_t)s[i];
+            if ((next & 0xC0) != 0x80)
+                return c;
+            cp = (cp << 6) | (next & 0x3F);
+            i++;
+        }
+        return cp;
+    }
+
+    // Latin-1 Supplement letters (U+00C0..U+00FF) to their unaccented lowercase base
+    static const char LATIN1_BASE[64] = {
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+        'd', 'n', 'o', 'o', 'o', 'o', 'o', 0, 'o', 'u', 'u', 'u', 'u', 'y', 0, 's',
+        'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+        'd', 'n', 'o', 'o', 'o', 'o', 'o', 0, 'o', 'u', 'u', 'u', 'u', 'y', 0, 'y'};
+
+    // Case-folded, accent-stripped code point plus the class of the original
+    static char32_t Fold(char32_t cp, CharClass &cls)
+    {
+        if (cp < 0x80)
+        {
+            if (cp >= 'a' && cp <= 'z')
+                cls = ClassLower;
+            else if (cp >= 'A' && cp <= 'Z')
+            {
+                cls = ClassUpper;
+                cp += 0x20;
+            }
+            else if (cp >= '0' && cp <= '9')
+                cls = ClassDigit;
+            else
+                cls = ClassOther;
+            return cp;
+        }
+
+        if (cp >= 0xC0 && cp <= 0xFF && LATIN1_BASE[cp - 0xC0] != 0)
+        {
+            cls = (cp < 0xE0) ? ClassUpper : ClassLower;
+            return (char32_t)LATIN1_BASE[cp - 0xC0];
+        }
+
+        // Latin Extended-A alternates upper/lower in pairs
+        if (cp >= 0x100 && cp <= 0x17F)
+        {
+            bool upper = ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) ? (cp & 1) : !(cp & 1);
+            cls = upper ? ClassUpper : ClassLower;
+            return upper ? cp + 1 : cp;
+        }
+
+        // Greek and Cyrillic capitals
+        if ((cp >= 0x391 && cp <= 0x3A9) || (cp >= 0x410 && cp <= 0x42F))
+        {
+            cls = ClassUpper;
+            return cp + 0x20;
+        }
+        if (cp >= 0x400 && cp <= 0x40F)
+        {
+            cls = ClassUpper;
+            return cp + 0x50;
+        }
+
+        cls = ClassLower; // Other scripts: treat as letters so word bonuses still apply
+        return cp;
+    }
+
+    static uint32_t MaskBit(char32_t folded)
+    {
+        if (folded >= 'a' && folded <= 'z')
+            return 1u << (folded - 'a');
+        if (folded >= '0' && folded <= '9')
+            return 1u << (26 + (folded - '0') / 2);
+        if (folded == ' ' || folded == '\t')
+            return 0;
+        return 1u << 31;
+    }
+
+    uint32_t FuzzyPattern::CharMask(std::string_view utf8)
+    {
+        uint32_t mask = 0;
+        size_t i = 0;
+        while (i < utf8.size())
+        {
+            CharClass cls;
+            mask |= MaskBit(Fold(DecodeUtf8(utf8, i), cls));
+        }
+        return mask;
+    }
+
+    // <-- Pattern -->
+    FuzzyPattern::FuzzyPattern(std::string_view query)
+    {
+        std::u32string term;
+        size_t i = 0;
+        while (i <= query.size())
+        {
+            char32_t cp = (i < query.size()) ? DecodeUtf8(query, i) : (i++, U' ');
+            CharClass cls;
+            char32_t folded = Fold(cp, cls);
+            if (folded == ' ' || folded == '\t')
+            {
+                if (!term.empty())
+                {
+                    if (term.size() > MAX_TERM_CHARS)
+                        term.resize(MAX_TERM_CHARS);
+                    m_terms.push_back(term);
+                    term.clear();
+                }
+                continue;
+            }
+            term.push_back(folded);
+            m_required |= MaskBit(folded);
+        }
+    }
+
+    int FuzzyPattern::Score(std::string_view name) const
+    {
+        // Decode once into folded code points, each with its position bonus
+        char32_t text[MAX_NAME_CHARS];
+        int8_t bonus[MAX_NAME_CHARS];
+        size_t n = 0;
+        CharClass prev = ClassOther;
+        size_t i = 0;
+        while (i < name.size() && n < MAX_NAME_CHARS)
+        {
+            CharClass cls;
+            uint8_t c = (uint8_t)name[i];
+            if (c < 0x80)
+            {
+                i++;
+                text[n] = ASCII.fold[c];
+                cls = ASCII.cls[c];
+            }
+            else
+            {
+                text[n] = Fold(DecodeUtf8(name, i), cls);
+            }
+            bonus[n] = TRANSITION_BONUS[prev][cls];
+            prev = cls;
+            n++;
+        }
+
+        int total = 0;
+        int rowPrev[MAX_NAME_CHARS];
+        int row[MAX_NAME_CHARS];
+        for (const std::u32string &term : m_terms)
+        {
+            size_t m = term.size();
+
+            // Greedy subsequence check; also bounds the DP to [first, last]
+            size_t first = n;
+            size_t k = 0;
+            for (size_t j = 0; j < n && k < m; ++j)
+            {
+                if (text[j] == term[k])
+                {
+                    if (k == 0)
+                        first = j;
+                    k++;
+                }
+            }
+            if (k < m)
+                return -1;
+
+            size_t last = n - 1;
+            while (text[last] != term[m - 1])
+                last--;
+
+            if (m == 1)
+            {
+                int best = 0;
+                for (size_t j = first; j <= last; ++j)
+                {
+                    if (text[j] == term[0])
+                        best = std::max(best, SCORE_MATCH + bonus[j] * BONUS_FIRST_CHAR);
+                }
+                total += best;
+                continue;
+            }
+
+            // row[j] = best score with term[t] matched at text[j]
+            for (size_t j = first; j <= last; ++j)
+                rowPrev[j] = (text[j] == term[0]) ? SCORE_MATCH + bonus[j] * BONUS_FIRST_CHAR : NO_MATCH;
+
+            for (size_t t = 1; t < m; ++t)
+            {
+                int gapBest = NO_MATCH; // Best rowPrev[k] + gap penalty over k <= j - 2
+                row[first] = NO_MATCH;
+                for (size_t j = first + 1; j <= last; ++j)
+                {
+                    if (j >= first + 2 && rowPrev[j - 2] > NO_MATCH)
+                        gapBest = std::max(gapBest + SCORE_GAP_EXTENSION, rowPrev[j - 2] + SCORE_GAP_START);
+                    else if (gapBest > NO_MATCH)
+                        gapBest += SCORE_GAP_EXTENSION;
+
+                    if (text[j] != term[t])
+                    {
+                        row[j] = NO_MATCH;
+                        continue;
+                    }
+
+                    int best = NO_MATCH;
+                    if (rowPrev[j - 1] > NO_MATCH)
+                        best = rowPrev[j - 1] + SCORE_MATCH + std::max<int>(bonus[j], BONUS_CONSECUTIVE);
+                    if (gapBest > NO_MATCH)
+                        best = std::max(best, gapBest + SCORE_MATCH + bonus[j]);
+                    row[j] = best;
+                }
+                std::copy(row + first, row + last + 1, rowPrev + first);
+            }
+
+            int termBest = NO_MATCH;
+            for (size_t j = first; j <= last; ++j)
+                termBest = std::max(termBest, rowPrev[j]);
+            if (termBest <= NO_MATCH)
+                return -1;
+            total += termBest;
+        }
+        return total;
+    }
+
+    // <-- Ranked Search -->
+    void FuzzySearch::Prefilter(const uint32_t *masks, size_t count, uint32_t required, std::vector<uint32_t> &out)
+    {
+        size_t i = 0;
+#ifdef FUZZY_SSE2
+        // Four names per step: (mask & required) == required
+        const __m128i need = _mm_set1_epi32((int)required);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i m = _mm_loadu_si128((const __m128i *)(masks + i));
+            __m128i hit = _mm_cmpeq_epi32(_mm_and_si128(m, need), need);
+            int bits = _mm_movemask_ps(_mm_castsi128_ps(hit));
+            if (bits == 0)
+                continue;
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if (bits & (1 << lane))
+                    out.push_back((uint32_t)(i + lane));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            if ((masks[i] & required) == required)
+                out.push_back((uint32_t)i);
+        }
+    }
+
+    NameList NameList::From(const GameLibrary &library)
+    {
+        NameList names;
+        names.revision = library.Revision();
+        names.ends.reserve(library.Size());
+        names.text.reserve(library.Size() * 24);
+        for (size_t i = 0; i < library.Size(); ++i)
+        {
+            names.text += library.Name(i);
+            names.ends.push_back((uint32_t)names.text.size());
+        }
+        return names;
+    }
+
+    const std::vector<FuzzyMatch> &FuzzySearch::Rank(const NameList &names, std::string_view query, size_t limit)
+    {
+        uint64_t revision = names.revision;
+        if (revision == m_revision && query == m_query)
+            return m_matches;
+
+        if (m_maskRevision != revision)
+        {
+            m_masks.resize(names.Size());
+            for (size_t i = 0; i < names.Size(); ++i)
+                m_masks[i] = FuzzyPattern::CharMask(names.Name(i));
+            m_maskRevision = revision;
+        }
+
+        FuzzyPattern pattern(query);
+        if (pattern.Empty())
+        {
+            // Nothing to narrow from next time
+            m_query.clear();
+            m_revision = revision;
+            m_matches.clear();
+            return m_matches;
+        }
+
+        // Every term of a query that contains the previous one covers a previous term,
+        // so only previous matches can still match
+        m_candidates.clear();
+        bool narrowing = (revision == m_revision && !m_query.empty() && query.find(m_query) != std::string_view::npos);
+        if (narrowing)
+        {
+            uint32_t required = pattern.RequiredMask();
+            for (const FuzzyMatch &match : m_matches)
+            {
+                if ((m_masks[match.idx] & required) == required)
+                    m_candidates.push_back(match.idx);
+            }
+            std::sort(m_candidates.begin(), m_candidates.end());
+        }
+        else
+        {
+            Prefilter(m_masks.data(), m_masks.size(), pattern.RequiredMask(), m_candidates);
+        }
+
+        // A capped ranking is incomplete, so nothing may narrow from it
+        bool capped = m_candidates.size() > limit;
+        if (capped)
+            m_candidates.resize(limit);
+
+        m_query.assign(capped ? std::string_view() : query);
+        m_revision = revision;
+        m_matches.clear();
+        for (uint32_t idx : m_candidates)
+        {
+            int score = pattern.Score(names.Name(idx));
+            if (score >= 0)
+                m_matches.push_back({idx, score});
+        }
+
+        std::stable_sort(m_matches.begin(), m_matches.end(), [](const FuzzyMatch &a, const FuzzyMatch &b)
+                         { return a.score > b.score; });
+        return m_matches;
+    }
+
+} // namespace Core
@@ -0,0 +1,97 @@
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+    class GameLibrary;
+
+    struct FuzzyMatch
+    {
+        uint32_t idx; // Library position
+        int score;
+    };
+
+    // Library names by position, packed into one buffer; immutable once built,
+    // so the search thread and the UI can share one copy
+    struct NameList
+    {
+        uint64_t revision = 0;      // GameLibrary::Revision() the positions belong to
+        std::string text;           // Every name, back to back
+        std::vector<uint32_t> ends; // Per position, where its name ends in text
+
+        size_t Size() const { return ends.size(); }
+        std::string_view Name(size_t idx) const
+        {
+            uint32_t start = idx ? ends[idx - 1] : 0;
+            return std::string_view(text).substr(start, ends[idx] - start);
+        }
+
+        static NameList From(const GameLibrary &library);
+    };
+
+    // <-- Fuzzy Pattern -->
+    // fzf-style matching: every whitespace-separated term must appear in the
+    // name as a subsequence (so "monky" finds "Monkey"), terms in any order.
+    // Case and Latin accents are ignored and names are decoded as UTF-8.
+    // Matches are scored with a small alignment DP that rewards word starts,
+    // camelCase humps and consecutive runs and charges for gaps.
+    class FuzzyPattern
+    {
+    public:
+        explicit FuzzyPattern(std::string_view query);
+
+        bool Empty() const { return m_terms.empty(); }
+
+        // Characters every matching name must contain (see CharMask)
+        uint32_t RequiredMask() const { return m_required; }
+
+        // Sum of the per-term scores, or -1 if some term doesn't match
+        int Score(std::string_view name) const;
+
+        // Folds a name into the 32-bit set of character classes it contains:
+        // a-z one bit each, digit pairs 26-30, anything else bit 31
+        static uint32_t CharMask(std::string_view utf8);
+
+    private:
+        std::vector<std::u32string> m_terms;
+        uint32_t m_required = 0;
+    };
+
+    // <-- Ranked Name Search -->
+    // Ranks every library name against a query. A cached character mask per
+    // name lets a SIMD pass throw out names missing any required character
+    // before the DP runs. A query that contains the previous one only
+    // rescores the previous matches.
+    //
+    // LibrarySearch runs the full ranking on its thread; the UI uses a
+    // `limit` to rank just the first candidates while it waits for that.
+    class FuzzySearch
+    {
+    public:
+        // Best first; ties keep library (name) order. With a limit, only the first
+        // `limit` names past the prefilter (in name order) are scored
+        const std::vector<FuzzyMatch> &Rank(const NameList &names, std::string_view query, size_t limit = SIZE_MAX);
+
+        // Rejects masks missing any `required` bit; appends survivors' indices
+        static void Prefilter(const uint32_t *masks, size_t count, uint32_t required, std::vector<uint32_t> &out);
+
+    private:
+        std::vector<uint32_t> m_masks;
+        uint64_t m_maskRevision = 0;
+
+        std::string m_query;
+        uint64_t m_revision = 0;
+        std::vector<FuzzyMatch> m_matches;
+        std::vector<uint32_t> m_candidates;
+    };
+
+} // namespace Core
+
+#endif // FUZZYMATCHER_H
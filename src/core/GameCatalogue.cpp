@@ -0,0 +1,272 @@
+#include "pch.h"
+#include "Core/GameCatalogue.h"
+#include "Core/PersistenceWorker.h"
+#include "Core/TextTokenizer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+
+    static const char CATALOGUE_MAGIC[8] = {'M', 'O', 'R', 'T', 'C', 'A', 'T', '\0'};
+
+    // DREAMM property values, in GameEntry's videoHwIdx / audioFlags order
+    static const char *VIDEOHW_NAMES[] = {"hercules", "cga", "ega", "mcga", "vga", "svga"};
+    static const char *AUDIOHW_NAMES[] = {"speaker", "cms", "adlib", "sb16", "mt32", "gmidi"};
+    static const uint8_t UNKNOWN_VIDEOHW = 0xFF;
+
+    static bool ParseUnsigned(std::string_view field, uint64_t &out, int base)
+    {
+        auto result = std::from_chars(field.data(), field.data() + field.size(), out, base);
+        return !field.empty() && result.ec == std::errc() && result.ptr == field.data() + field.size();
+    }
+
+    static int FindName(std::string_view name, const char *const *names, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (name == names[i])
+                return i;
+        }
+        return -1;
+    }
+
+    void CatalogueMatch::ApplyTo(GameEntry &game, bool fresh) const
+    {
+        if (fresh)
+        {
+            if (!title.empty())
+                game.name = title;
+            if (ramKB > 0)
+                game.ramKB = ramKB;
+            if (mips > 0)
+                game.mips = mips;
+            if (videoHwIdx >= 0)
+                game.videoHwIdx = videoHwIdx;
+            if (audioMask != 0)
+            {
+                for (int i = 0; i < 6; i++)
+                    game.audioFlags[i] = (audioMask & (1 << i)) != 0;
+            }
+        }
+
+        if (year > 0)
+        {
+            std::string tag = "year/" + std::to_string(year);
+            if (std::find(game.tags.begin(), game.tags.end(), tag) == game.tags.end())
+                game.tags.push_back(std::move(tag));
+        }
+    }
+
+    // <-- Lookup -->
+    bool GameCatalogue::Open(const fs::path &binFile)
+    {
+        m_records = nullptr;
+        m_count = 0;
+        if (!m_file.Open(binFile) || m_file.Size() < sizeof(CatalogueHeader))
+            return false;
+
+        CatalogueHeader header;
+        std::memcpy(&header, m_file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, CATALOGUE_MAGIC, sizeof(CATALOGUE_MAGIC)) != 0 || header.version != VERSION ||
+            header.recordSize != sizeof(CatalogueRecord))
+        {
+            SDL_Log("Catalogue %s has an unknown format.", binFile.string().c_str());
+            return false;
+        }
+
+        // By subtraction, so a corrupt offset can't wrap the sum past the check
+        uint64_t tableSize = (uint64_t)header.recordCount * sizeof(CatalogueRecord);
+        if (header.recordsOffset > m_file.Size() || tableSize > m_file.Size() - header.recordsOffset ||
+            header.stringsOffset > m_file.Size() || header.stringsSize > m_file.Size() - header.stringsOffset)
+        {
+            SDL_Log("Catalogue %s is truncated.", binFile.string().c_str());
+            return false;
+        }
+
+        m_records = m_file.Data() + header.recordsOffset;
+        m_count = header.recordCount;
+        m_strings = reinterpret_cast<const char *>(m_file.Data() + header.stringsOffset);
+        m_stringsSize = header.stringsSize;
+        SDL_Log("Catalogue: %d known executables.", (int)m_count);
+        return true;
+    }
+
+    CatalogueRecord GameCatalogue::RecordAt(size_t idx) const
+    {
+        CatalogueRecord record;
+        std::memcpy(&record, m_records + idx * sizeof(CatalogueRecord), sizeof(record));
+        return record;
+    }
+
+    bool GameCatalogue::Find(const FileFingerprint &fingerprint, CatalogueMatch &out) const
+    {
+        // First record with this hash; only the 8-byte key is read per probe
+        size_t low = 0;
+        size_t high = m_count;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            uint64_t hash;
+            std::memcpy(&hash, m_records + mid * sizeof(CatalogueRecord), sizeof(hash));
+            if (hash < fingerprint.hash)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        // Same hash: an exact size wins over a record for any size
+        bool found = false;
+        CatalogueRecord match = {};
+        for (size_t i = low; i < m_count; ++i)
+        {
+            CatalogueRecord record = RecordAt(i);
+            if (record.hash != fingerprint.hash)
+                break;
+            if (record.fileSize == fingerprint.fileSize || (record.fileSize == 0 && !found))
+            {
+                match = record;
+                found = true;
+            }
+        }
+        if (!found || (uint64_t)match.titleOffset + match.titleLength > m_stringsSize)
+            return false;
+
+        out.title.assign(m_strings + match.titleOffset, match.titleLength);
+        out.year = match.year;
+        out.ramKB = (int)match.ramKB;
+        out.mips = match.mips;
+        out.videoHwIdx = match.videoHwIdx < IM_ARRAYSIZE(VIDEOHW_NAMES) ? match.videoHwIdx : -1;
+        out.audioMask = match.audioMask;
+        return true;
+    }
+
+    bool GameCatalogue::Identify(const fs::path &exe, FingerprintCache &fingerprints, CatalogueMatch &out) const
+    {
+        // Without a catalogue there is nothing to hash for
+        FileFingerprint fingerprint;
+        return IsOpen() && fingerprints.Fingerprint(exe, fingerprint) && Find(fingerprint, out);
+    }
+
+    // <-- Compile -->
+    bool GameCatalogue::NeedsCompile(const fs::path &sourceFile, const fs::path &binFile)
+    {
+        std::error_code ec;
+        auto sourceTime = fs::last_write_time(sourceFile, ec);
+        if (ec)
+            return false;
+        auto binTime = fs::last_write_time(binFile, ec);
+        return ec || sourceTime > binTime;
+    }
+
+    bool GameCatalogue::Compile(const fs::path &sourceFile, const fs::path &binFile)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        MappedFile source;
+        if (!source.Open(sourceFile))
+            return false;
+
+        std::vector<CatalogueRecord> records;
+        std::string strings;
+        std::unordered_map<std::string, uint32_t> titleOffsets; // Many executables share a title
+        std::string title;
+        int skipped = 0;
+
+        TextLineReader reader(std::string_view(reinterpret_cast<const char *>(source.Data()), source.Size()));
+        std::string_view line;
+        while (reader.Next(line))
+        {
+            std::string_view trimmed = FieldTokenizer::Trimmed(line);
+            if (trimmed.empty() || trimmed[0] == '#')
+                continue;
+
+            FieldTokenizer fields(trimmed);
+            CatalogueRecord record = {};
+            record.videoHwIdx = UNKNOWN_VIDEOHW;
+
+            std::string_view sizeField = FieldTokenizer::Trimmed(fields.Field(1));
+            AssignUnescapedField(title, FieldTokenizer::Trimmed(fields.Field(2)));
+            if (!ParseUnsigned(FieldTokenizer::Trimmed(fields.Field(0)), record.hash, 16) ||
+                (!sizeField.empty() && !ParseUnsigned(sizeField, record.fileSize, 10)) ||
+                title.empty() || title.size() > UINT16_MAX)
+            {
+                if (skipped++ < 5)
+                    SDL_Log("%s:%d: expected xxh64|size|title|...", sourceFile.string().c_str(), reader.LineNumber());
+                continue;
+            }
+
+            // Optional fields stay unknown when missing or malformed
+            int year = 0, ramKB = 0, mips = 0;
+            fields.Int(3, year);
+            fields.Int(4, ramKB);
+            fields.Int(5, mips);
+            record.year = (uint16_t)std::clamp(year, 0, (int)UINT16_MAX);
+            record.ramKB = (uint32_t)std::max(ramKB, 0);
+            record.mips = (uint16_t)std::clamp(mips, 0, (int)UINT16_MAX);
+
+            int video = FindName(FieldTokenizer::Trimmed(fields.Field(6)), VIDEOHW_NAMES, IM_ARRAYSIZE(VIDEOHW_NAMES));
+            if (video >= 0)
+                record.videoHwIdx = (uint8_t)video;
+
+            std::string_view audio = FieldTokenizer::Trimmed(fields.Field(7));
+            while (!audio.empty())
+            {
+                size_t plus = audio.find('+');
+                int device = FindName(FieldTokenizer::Trimmed(audio.substr(0, plus)), AUDIOHW_NAMES, IM_ARRAYSIZE(AUDIOHW_NAMES));
+                if (device >= 0)
+                    record.audioMask |= (uint8_t)(1 << device);
+                audio = (plus == std::string_view::npos) ? std::string_view() : audio.substr(plus + 1);
+            }
+
+            auto pooled = titleOffsets.find(title);
+            if (pooled == titleOffsets.end())
+            {
+                pooled = titleOffsets.emplace(title, (uint32_t)strings.size()).first;
+                strings += title;
+                strings += '\0';
+            }
+            record.titleOffset = pooled->second;
+            record.titleLength = (uint16_t)title.size();
+            records.push_back(record);
+        }
+
+        // The first line for an executable wins
+        std::stable_sort(records.begin(), records.end(), [](const CatalogueRecord &a, const CatalogueRecord &b)
+                         { return a.hash != b.hash ? a.hash < b.hash : a.fileSize < b.fileSize; });
+        records.erase(std::unique(records.begin(), records.end(), [](const CatalogueRecord &a, const CatalogueRecord &b)
+                                  { return a.hash == b.hash && a.fileSize == b.fileSize; }),
+                      records.end());
+
+        CatalogueHeader header = {};
+        std::memcpy(header.magic, CATALOGUE_MAGIC, sizeof(CATALOGUE_MAGIC));
+        header.version = VERSION;
+        header.recordSize = sizeof(CatalogueRecord);
+        header.recordCount = (uint32_t)records.size();
+        header.recordsOffset = sizeof(CatalogueHeader);
+        header.stringsOffset = header.recordsOffset + records.size() * sizeof(CatalogueRecord);
+        header.stringsSize = strings.size();
+
+        std::string contents;
+        contents.reserve(header.stringsOffset + strings.size());
+        contents.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        contents.append(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(CatalogueRecord));
+        contents.append(strings);
+
+        // Unmap the source before replacing anything next to it
+        source.Close();
+        if (!PersistenceWorker::WriteFileAtomic(binFile, contents))
+            return false;
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        SDL_Log("Compiled %s: %d executables, %d titles, %d lines skipped (%lld ms).", sourceFile.string().c_str(),
+                (int)records.size(), (int)titleOffsets.size(), skipped, (long long)elapsed.count());
+        return true;
+    }
+
+} // namespace Core
@@ -0,0 +1,114 @@
+#ifndef GAMECATALOGUE_H
+#define GAMECATALOGUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "Core/Fingerprint.h"
+#include "Core/GameEntry.h"
+#include "Core/MappedFile.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // <-- On-Disk Layout (catalogue.bin, little-endian) -->
+    // [Header][Records sorted by (hash, fileSize)][Title pool]
+    struct CatalogueHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t recordCount;
+        uint32_t reserved;
+        uint64_t recordsOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    struct CatalogueRecord
+    {
+        uint64_t hash;     // XXH64 of the executable
+        uint64_t fileSize; // 0 = any size
+        uint32_t titleOffset;
+        uint16_t titleLength;
+        uint16_t year; // 0 = unknown, as are the fields below
+        uint32_t ramKB;
+        uint16_t mips;
+        uint8_t videoHwIdx; // 0xFF = unknown
+        uint8_t audioMask;  // Bit per audio device, in the launcher's order
+    };
+
+    static_assert(sizeof(CatalogueHeader) == 48, "CatalogueHeader layout changed");
+    static_assert(sizeof(CatalogueRecord) == 32, "CatalogueRecord layout changed");
+
+    // What the catalogue knows about one executable
+    struct CatalogueMatch
+    {
+        std::string title;
+        int year = 0;
+        int ramKB = 0;
+        int mips = 0;
+        int videoHwIdx = -1;
+        uint8_t audioMask = 0;
+
+        // A fresh entry takes the title and every known setting; an existing
+        // one keeps its own and only gains the year tag ("year/1993")
+        void ApplyTo(GameEntry &game, bool fresh) const;
+    };
+
+    // <-- External Game Catalogue -->
+    // Known executables by content, for naming and configuring games that
+    // aren't DREAMM installs. The source is a text file, one executable per
+    // line:
+    //
+    //   xxh64|size|title|year|ramKB|mips|videohw|audiohw
+    //   e.g. 5e1f0c9a3b7d2468|715493|DOOM|1993|8192|40|vga|sb16+gmidi
+    //
+    // (xxh64 in hex as printed by `xxhsum -H1`; empty or 0 size, year, RAM
+    // and MIPS mean unknown; audiohw joins device names with '+'). It is
+    // compiled once into a sorted binary file, which is memory-mapped and
+    // binary-searched in place: opening costs nothing however many entries
+    // it has, and a lookup touches about log2(n) records.
+    //
+    // Read-only once open, so any thread may look things up.
+    class GameCatalogue
+    {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        GameCatalogue() = default;
+
+        GameCatalogue(const GameCatalogue &) = delete;
+        GameCatalogue &operator=(const GameCatalogue &) = delete;
+
+        bool Open(const fs::path &binFile);
+        bool IsOpen() const { return m_count > 0; }
+        size_t Size() const { return m_count; }
+
+        bool Find(const FileFingerprint &fingerprint, CatalogueMatch &out) const;
+
+        // Fingerprints `exe` through the cache, then looks it up
+        bool Identify(const fs::path &exe, FingerprintCache &fingerprints, CatalogueMatch &out) const;
+
+        // Text source to binary file; skips malformed lines (logging the first few)
+        static bool Compile(const fs::path &sourceFile, const fs::path &binFile);
+
+        // Compiles when the source is newer than the binary (or there is no binary yet)
+        static bool NeedsCompile(const fs::path &sourceFile, const fs::path &binFile);
+
+    private:
+        CatalogueRecord RecordAt(size_t idx) const;
+
+        MappedFile m_file;
+        const uint8_t *m_records = nullptr;
+        size_t m_count = 0;
+        const char *m_strings = nullptr;
+        uint64_t m_stringsSize = 0;
+    };
+
+} // namespace Core
+
+#endif // GAMECATALOGUE_H
@@ -1,216 +1,151 @@
 #ifndef GAMEDATABASE_H
 #define GAMEDATABASE_H
 
-#include <string>
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "Core/GameEntry.h"
+#include "Core/TextFold.h"
+#include "DreammIdTable.h" // Generated from data/dreamm_ids.txt by tools/gen_dreamm_ids.py
 
 namespace Core
 {
-    struct GameDatabase
+    // What a DREAMM version ID (e.g. "win-cd-demo-de") says about the release
+    struct DreammVersion
     {
-        static const std::map<std::string, std::string> &GetDreammMap()
-        {
-            static const std::map<std::string, std::string> idToName = {
-
-                // Afterlife
-                {"lec-alife", "Afterlife"},
-
-                // Battlehawks: 1942
-                {"lec-battlehawks", "Battlehawks: 1942"},
-
-                // Star Wars: Behind the Magic
-                {"lec-behindmagic", "Star Wars: Behind the Magic"},
-
-                // Ben’s Game
-                {"lec-bensgame", "Ben's Game"},
-
-                // Curse of Monkey Island
-                {"lec-comi", "Curse of Monkey Island"},
-
-                // FM Towns Multi‑Game Demos
-                {"lec-demos-fmtowns", "Star Wars: Dark Forces"},
-
-                // Star Wars: Dark Forces
-                {"lec-darkforces", "Star Wars: Dark Forces"},
-
-                // Day of the Tentacle
-                {"lec-dott", "Day of the Tentacle"},
-
-                // Escape from Monkey Island
-                {"lec-efmi", "Escape from Monkey Island"},
-
-                // Star Wars: Episode I Insider's Guide
-                {"lec-ep1insider", "Star Wars: Episode I Insider's Guide"},
-
-                // Their Finest Hour: Battle of Britain
-                {"lec-finest", "Their Finest Hour: Battle of Britain"},
-
-                // Grim Fandango
-                {"lec-grim", "Grim Fandango"},
-
-                // Indiana Jones and the Last Crusade
-                {"lec-indy3", "Indiana Jones and the Last Crusade"},
-
-                // Indiana Jones and the Last Crusade: The Action Game
-                {"lec-indy3-action", "Indiana Jones and the Last Crusade: The Action Game"},
-
-                // Indiana Jones and the Fate of Atlantis
-                {"lec-indy4", "Indiana Jones and the Fate of Atlantis"},
-
-                // Indiana Jones and the Fate of Atlantis: The Action Game
-                {"lec-indy4-action", "Indiana Jones and the Fate of Atlantis: The Action Game"},
-
-                // Indiana Jones and His Desktop Adventures
-                {"lec-indydesk", "Indiana Jones and His Desktop Adventures"},
-
-                // Indiana Jones and the Infernal Machine
-                {"lec-infernal", "Indiana Jones and the Infernal Machine"},
-
-                // Star Wars: Jedi Knight
-                {"lec-jedi", "Star Wars: Jedi Knight"},
-
-                // Loom
-                {"lec-loom", "Loom"},
-
-                // LucasArts Collection
-                {"lec-collections", "Loom"},
-
-                // Star Wars: Making Magic
-                {"lec-makingmagic", "Star Wars: Making Magic"},
-
-                // Maniac Mansion
-                {"lec-maniac", "Maniac Mansion"},
-
-                // Masterblazer
-                {"lec-masterblazer", "Masterblazer"},
-
-                // Monkey Island 2: LeChuck's Revenge
-                {"lec-monkey2", "Monkey Island 2: LeChuck's Revenge"},
-
-                // Monopoly Star Wars
-                {"has-swmonopoly", "Monopoly Star Wars"},
-
-                // Mortimer and the Riddles of the Medallion
-                {"lec-mortimer", "Mortimer and the Riddles of the Medallion"},
-
-                // Star Wars: Jedi Knight: Mysteries of the Sith
-                {"lec-mots", "Star Wars: Jedi Knight: Mysteries of the Sith"},
-
-                // Night Shift
-                {"lec-nightshift", "Night Shift"},
-
-                // Outlaws
-                {"lec-outlaws", "Outlaws"},
-
-                // Passport to Adventure
-                {"lec-passport", "Passport to Adventure"},
-
-                // Star Wars: Episode I The Phantom Menace
-                {"lec-phantom", "Star Wars: Episode I The Phantom Menace"},
-
-                // PHM Pegasus
-                {"lec-phmpegasus", "PHM Pegasus"},
-
-                // Pipe Dream
-                {"lec-pipedream", "Pipe Dream"},
-
-                // Star Wars: Episode I Racer
-                {"lec-racer", "Star Wars: Episode I Racer"},
-
-                // Star Wars: Rebel Assault
-                {"lec-rebelassault", "Star Wars: Rebel Assault"},
-
-                // Star Wars: Rebel Assault II
-                {"lec-rebel2", "Star Wars: Rebel Assault II"},
-
-                // Star Wars: Rebellion
-                {"lec-rebellion", "Star Wars: Rebellion"},
-
-                // Star Wars: Rogue Squadron
-                {"lec-roguesq", "Star Wars: Rogue Squadron"},
-
-                // Sam & Max Hit the Road
-                {"lec-samnmax", "Sam & Max Hit the Road"},
-
-                // Star Wars: Shadows of the Empire
-                {"lec-shadows", "Star Wars: Shadows of the Empire"},
-
-                // The Secret of Monkey Island
-                {"lec-somi", "The Secret of Monkey Island"},
-
-                // Super Star Wars (Prototype)
-                {"lec-sswproto", "Super Star Wars (Prototype)"},
-
-                // Strike Fleet
-                {"lec-strikefleet", "Strike Fleet"},
-
-                // Secret Weapons of the Luftwaffe
-                {"lec-swotl", "Secret Weapons of the Luftwaffe"},
-
-                // Star Wars: Screen Entertainment
-                {"lec-swse", "Star Wars: Screen Entertainment"},
-
-                // The Dig
-                {"lec-thedig", "The Dig"},
-
-                // Full Throttle
-                {"lec-throttle", "Full Throttle"},
-
-                // Star Wars: TIE Fighter
-                {"lec-tie", "Star Wars: TIE Fighter"},
-
-                // Star Wars: X-Wing vs. TIE Fighter
-                {"lec-xvt", "Star Wars: X-Wing vs. TIE Fighter"},
-
-                // Star Wars: X-Wing Alliance
-                {"lec-xwa", "Star Wars: X-Wing Alliance"},
-
-                // Star Wars: X-Wing
-                {"lec-xwing", "Star Wars: X-Wing"},
-
-                // Yoda Stories
-                {"lec-yoda", "Yoda Stories"},
-
-                // Zak McKracken and the Alien Mindbenders
-                {"lec-zak", "Zak McKracken and the Alien Mindbenders"},
-
-                // Star Wars: Anakin's Speedway
-                {"lll-anakin", "Star Wars: Anakin's Speedway"},
-
-                // Star Wars: DroidWorks
-                {"lll-droidworks", "Star Wars: DroidWorks"},
-
-                // Star Wars: Early Learning Activity Center
-                {"lll-elac", "Star Wars: Early Learning Activity Center"},
-
-                // Star Wars: Episode I The Gungan Frontier
-                {"lll-gungan", "Star Wars: Episode I The Gungan Frontier"},
+        GamePlatform platform = GamePlatform::DOS;
+        const char *platformLabel = ""; // " (Windows)" etc.; empty when not stated
+        bool demo = false;
+        const char *languageLabel = ""; // " - DE" etc.; empty when not stated
+    };
 
-                // Star Wars: Jar Jar's Journey
-                {"lll-jarjar", "Star Wars: Jar Jar's Journey"},
+    // Version ID words, matched as token prefixes; earlier entries win
+    struct DreammPlatformWord
+    {
+        std::string_view prefix;
+        GamePlatform platform;
+        const char *label;
+    };
 
-                // Star Wars: Pit Droids
-                {"lll-pitdroids", "Star Wars: Pit Droids"},
+    inline constexpr DreammPlatformWord DREAMM_PLATFORM_WORDS[] = {
+        {"win", GamePlatform::Windows, " (Windows)"},
+        {"fmtowns", GamePlatform::DreammNative, " (FM Towns)"},
+        {"mac", GamePlatform::DreammNative, " (Mac)"},
+        {"dos", GamePlatform::DOS, " (DOS)"}};
 
-                // Star Wars Math: Jabba's Game Galaxy
-                {"lll-swmath", "Star Wars Math: Jabba's Game Galaxy"},
+    inline constexpr std::string_view DREAMM_LANGUAGE_CODES[] = {"de", "fr", "es", "it", "jp", "pt", "br", "kr", "zh", "tw"};
+    inline constexpr const char *DREAMM_LANGUAGE_LABELS[] = {" - DE", " - FR", " - ES", " - IT", " - JP", " - PT", " - BR", " - KR", " - ZH", " - TW"};
 
-                // Star Wars: Yoda's Challenge Activity Center
-                {"lll-yoda", "Star Wars: Yoda's Challenge Activity Center"},
+    struct GameDatabase
+    {
+        // Must match hash_dreamm_id in tools/gen_dreamm_ids.py
+        static constexpr uint32_t HashDreammId(std::string_view key, uint32_t seed)
+        {
+            uint32_t h = 2166136261u ^ seed;
+            for (char c : key)
+                h = (h ^ (uint8_t)c) * 16777619u;
+            h ^= h >> 15;
+            h *= 0x2C1B3C6Du;
+            h ^= h >> 12;
+            return h;
+        }
 
-                // Indiana Jones and the Temple of Doom
-                {"mind-indy2", "Indiana Jones and the Temple of Doom"},
+        // Title for a DREAMM install folder ID; empty when unknown.
+        // One seed, one hash, one compare: the table is a perfect hash
+        static constexpr std::string_view FindDreammTitle(std::string_view id)
+        {
+            uint32_t seed = DREAMM_ID_SEEDS[HashDreammId(id, 0) % DREAMM_ID_BUCKETS];
+            const DreammIdSlot &slot = DREAMM_ID_TABLE[HashDreammId(id, seed) % DREAMM_ID_SLOTS];
+            return (!id.empty() && slot.id == id) ? slot.title : std::string_view();
+        }
 
-                // Willow
-                {"mind-willow", "Willow"},
+        // One pass over the version ID's words (split at anything not a
+        // letter or digit). Platform: a word starting win / fmtowns (or
+        // "fm-towns") / mac / dos, in that order of precedence. Demo: a
+        // word containing "demo". Language: a word after a '-' of up to three
+        // letters starting with a known code, the earliest code listed
+        // winning (so "-demo" is no longer read as German).
+        static constexpr DreammVersion ParseDreammVersion(std::string_view versionID)
+        {
+            const size_t platformWords = sizeof(DREAMM_PLATFORM_WORDS) / sizeof(DREAMM_PLATFORM_WORDS[0]);
+            const size_t languageCodes = sizeof(DREAMM_LANGUAGE_CODES) / sizeof(DREAMM_LANGUAGE_CODES[0]);
+            size_t platform = platformWords;
+            size_t language = languageCodes;
+
+            DreammVersion version;
+            std::string_view previous;
+            size_t start = 0;
+            while (start < versionID.size())
+            {
+                size_t end = start;
+                while (end < versionID.size() && IsWordChar(versionID[end]))
+                    end++;
+                if (end == start)
+                {
+                    start++;
+                    continue;
+                }
+
+                std::string_view word = versionID.substr(start, end - start);
+                for (size_t p = 0; p < platform; ++p)
+                {
+                    if (StartsWithNoCase(word, DREAMM_PLATFORM_WORDS[p].prefix))
+                        platform = p;
+                }
+                if (platform > 1 && EqualsNoCase(word, "towns") && EqualsNoCase(previous, "fm") && versionID[start - 1] == '-')
+                    platform = 1;
+
+                for (size_t i = 0; i + 4 <= word.size() && !version.demo; ++i)
+                    version.demo = EqualsNoCase(word.substr(i, 4), "demo");
+
+                if (word.size() <= 3 && start > 0 && versionID[start - 1] == '-')
+                {
+                    for (size_t l = 0; l < language; ++l)
+                    {
+                        if (StartsWithNoCase(word, DREAMM_LANGUAGE_CODES[l]))
+                            language = l;
+                    }
+                }
+
+                previous = word;
+                start = end;
+            }
+
+            if (platform < platformWords)
+            {
+                version.platform = DREAMM_PLATFORM_WORDS[platform].platform;
+                version.platformLabel = DREAMM_PLATFORM_WORDS[platform].label;
+            }
+            if (language < languageCodes)
+                version.languageLabel = DREAMM_LANGUAGE_LABELS[language];
+            return version;
+        }
 
-                // Star Wars Chess
-                {"swt-swchess", "Star Wars Chess"},
+        // Every generated slot must be found again by the lookup above
+        static constexpr bool DreammIdTableConsistent()
+        {
+            uint32_t found = 0;
+            for (const DreammIdSlot &slot : DREAMM_ID_TABLE)
+            {
+                if (slot.id.empty())
+                    continue;
+                if (FindDreammTitle(slot.id) != slot.title)
+                    return false;
+                found++;
+            }
+            return found == DREAMM_ID_COUNT;
+        }
 
-            };
-            return idToName;
+    private:
+        static constexpr bool IsWordChar(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
         }
     };
+
+    static_assert(GameDatabase::DreammIdTableConsistent(), "DreammIdTable.h does not match GameDatabase::HashDreammId");
+
 } // namespace Core
 
-#endif // GAMEDATABASE_H
\ No newline at end of file
+#endif // GAMEDATABASE_H
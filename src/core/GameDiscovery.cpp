@@ -0,0 +1,327 @@
+#include "pch.h"
+#include "Core/GameDiscovery.h"
+#include "Core/ExecutableInfo.h"
+#include "Core/TextFold.h"
+
+namespace Core
+{
+
+    // Stems (folded) that configure or install a game rather than run it, best first
+    static const char *SETUP_NAMES[] = {"setup", "install", "instal", "setsound", "sndsetup", "soundset", "config", "configur", "setup32"};
+
+    // Runnables that are never the game itself
+    static const char *IGNORED_PREFIXES[] = {"unins", "unwise", "uninst", "dos4gw", "dos32a", "pmodew", "cwsdpmi", "dxsetup", "vcredist", "readme", "directx"};
+
+    // Folders not worth descending into
+    static const char *SKIPPED_DIRS[] = {"$recycle.bin", "system volume information", "windows", ".git", "node_modules", "__macosx"};
+
+    static std::string FoldedStem(const fs::path &path)
+    {
+        std::string stem = path.stem().string();
+        for (char &c : stem)
+            c = FoldAscii(c);
+        return stem;
+    }
+
+    // Extension test on the native string, so files that don't match cost no allocation
+    static int ProgramKind(const fs::path &path)
+    {
+        const auto &name = path.native();
+        size_t n = name.size();
+        if (n < 5 || name[n - 4] != '.')
+            return 0;
+
+        char ext[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            auto c = name[n - 3 + i];
+            if (static_cast<uint32_t>(c) > 0x7F)
+                return 0;
+            ext[i] = FoldAscii((char)c);
+        }
+        if (ext[0] == 'e' && ext[1] == 'x' && ext[2] == 'e')
+            return 3;
+        if (ext[0] == 'c' && ext[1] == 'o' && ext[2] == 'm')
+            return 2;
+        if (ext[0] == 'b' && ext[1] == 'a' && ext[2] == 't')
+            return 1;
+        return 0;
+    }
+
+    GameDiscovery::~GameDiscovery()
+    {
+        Cancel();
+    }
+
+    // <-- UI Thread -->
+    void GameDiscovery::SetCatalogue(const GameCatalogue *catalogue, FingerprintCache *fingerprints)
+    {
+        m_catalogue = fingerprints ? catalogue : nullptr;
+        m_fingerprints = fingerprints;
+    }
+
+    bool GameDiscovery::Start(const std::vector<std::string> &roots)
+    {
+        if (IsRunning())
+            return false;
+
+        size_t workers = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+        m_queues.clear();
+        for (size_t i = 0; i < workers; ++i)
+            m_queues.push_back(std::make_unique<WorkQueue>());
+
+        m_cancel = false;
+        m_outstanding = 0;
+        m_directories = 0;
+        m_files = 0;
+        m_proposals = 0;
+
+        // Roots are dealt out round-robin so each worker starts with something
+        size_t next = 0;
+        for (const std::string &root : roots)
+        {
+            std::error_code ec;
+            if (root.empty() || !fs::is_directory(root, ec))
+                continue;
+            Push(next++ % workers, Work{fs::path(root), 0});
+        }
+        if (m_outstanding == 0)
+            return false;
+
+        m_startTime = std::chrono::steady_clock::now();
+        m_activeWorkers = (int)workers;
+        for (size_t i = 0; i < workers; ++i)
+            m_threads.emplace_back(&GameDiscovery::WorkerMain, this, i);
+        return true;
+    }
+
+    void GameDiscovery::Cancel()
+    {
+        m_cancel = true;
+        Join();
+    }
+
+    void GameDiscovery::Join()
+    {
+        for (std::thread &thread : m_threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+        m_threads.clear();
+    }
+
+    bool GameDiscovery::Poll(std::vector<GameEntry> &out)
+    {
+        if (IsRunning() && m_activeWorkers == 0)
+            Join();
+
+        std::lock_guard<std::mutex> lock(m_foundMutex);
+        if (m_found.empty())
+            return false;
+        out.swap(m_found);
+        m_found.clear();
+        return true;
+    }
+
+    DiscoveryProgress GameDiscovery::Progress() const
+    {
+        DiscoveryProgress progress;
+        progress.directories = m_directories;
+        progress.files = m_files;
+        progress.proposals = m_proposals;
+        progress.queued = m_outstanding;
+        progress.running = IsRunning();
+        return progress;
+    }
+
+    // <-- Workers -->
+    void GameDiscovery::Push(size_t self, Work work)
+    {
+        m_outstanding.fetch_add(1);
+        WorkQueue &queue = *m_queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(std::move(work));
+    }
+
+    bool GameDiscovery::Take(size_t self, Work &work)
+    {
+        {
+            WorkQueue &own = *m_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.items.empty())
+            {
+                work = std::move(own.items.back());
+                own.items.pop_back();
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < m_queues.size(); ++i)
+        {
+            WorkQueue &victim = *m_queues[(self + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty())
+            {
+                work = std::move(victim.items.front());
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void GameDiscovery::WorkerMain(size_t self)
+    {
+        int idle = 0;
+        Work work;
+        while (!m_cancel)
+        {
+            if (Take(self, work))
+            {
+                Visit(self, work);
+                m_outstanding.fetch_sub(1);
+                idle = 0;
+                continue;
+            }
+
+            // Nothing to take: finished once nobody holds a directory either
+            if (m_outstanding == 0)
+                break;
+            if (++idle < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // The last worker out reports the walk
+        if (m_activeWorkers.fetch_sub(1) == 1 && !m_cancel)
+        {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+            SDL_Log("Searched %llu folders (%llu files) on %zu workers in %.1f ms, %llu candidate games.",
+                    (unsigned long long)m_directories.load(), (unsigned long long)m_files.load(), m_queues.size(), seconds * 1000.0,
+                    (unsigned long long)m_proposals.load());
+        }
+    }
+
+    void GameDiscovery::Visit(size_t self, const Work &work)
+    {
+        std::vector<fs::path> programs;
+        uint64_t files = 0;
+
+        std::error_code ec;
+        for (fs::directory_iterator it(work.dir, fs::directory_options::skip_permission_denied, ec);
+             !ec && it != fs::directory_iterator(); it.increment(ec))
+        {
+            if (m_cancel)
+                return;
+
+            const fs::directory_entry &entry = *it;
+            std::error_code typeEc;
+            if (entry.is_directory(typeEc))
+            {
+                if (work.depth >= MAX_DEPTH || entry.is_symlink(typeEc))
+                    continue;
+
+                std::string name = entry.path().filename().string();
+                for (char &c : name)
+                    c = FoldAscii(c);
+                bool skip = false;
+                for (const char *skipped : SKIPPED_DIRS)
+                    skip = skip || name == skipped;
+                if (!skip)
+                    Push(self, Work{entry.path(), work.depth + 1});
+                continue;
+            }
+
+            files++;
+            if (ProgramKind(entry.path()))
+                programs.push_back(entry.path());
+        }
+
+        m_directories.fetch_add(1, std::memory_order_relaxed);
+        m_files.fetch_add(files, std::memory_order_relaxed);
+
+        GameEntry game;
+        if (!programs.empty() && Propose(work.dir, programs, game))
+        {
+            CatalogueMatch match;
+            if (m_catalogue && m_catalogue->Identify(game.exePath, *m_fingerprints, match))
+                match.ApplyTo(game, true);
+
+            m_proposals.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(m_foundMutex);
+            m_found.push_back(std::move(game));
+        }
+    }
+
+    // <-- Proposals -->
+    bool GameDiscovery::Propose(const fs::path &dir, const std::vector<fs::path> &programs, GameEntry &out)
+    {
+        std::string dirName = dir.filename().string();
+        std::string folderKey = dirName;
+        for (char &c : folderKey)
+            c = FoldAscii(c);
+
+        const fs::path *main = nullptr;
+        const fs::path *setup = nullptr;
+        int mainScore = -1;
+        size_t setupRank = IM_ARRAYSIZE(SETUP_NAMES);
+
+        for (const fs::path &program : programs)
+        {
+            std::string stem = FoldedStem(program);
+
+            bool ignored = false;
+            for (const char *prefix : IGNORED_PREFIXES)
+                ignored = ignored || stem.compare(0, strlen(prefix), prefix) == 0;
+            if (ignored)
+                continue;
+
+            size_t rank = 0;
+            while (rank < IM_ARRAYSIZE(SETUP_NAMES) && stem != SETUP_NAMES[rank])
+                rank++;
+            if (rank < IM_ARRAYSIZE(SETUP_NAMES))
+            {
+                if (rank < setupRank || (rank == setupRank && ProgramKind(program) > ProgramKind(*setup)))
+                {
+                    setup = &program;
+                    setupRank = rank;
+                }
+                continue;
+            }
+
+            // Named after the folder beats a prefix match beats anything else; .exe > .com > .bat
+            int score = ProgramKind(program);
+            if (stem == folderKey)
+                score += 100;
+            else if (stem.size() >= 3 && (folderKey.compare(0, stem.size(), stem) == 0 || stem.compare(0, folderKey.size(), folderKey) == 0))
+                score += 50;
+
+            if (score > mainScore || (score == mainScore && program.filename() < main->filename()))
+            {
+                main = &program;
+                mainScore = score;
+            }
+        }
+
+        // A folder with only installers or tools isn't a game
+        if (!main)
+            return false;
+
+        out = GameEntry();
+        out.name = dirName.empty() ? main->stem().string() : dirName;
+        out.exePath = main->string();
+        if (setup)
+            out.setupPath = setup->string();
+        out.platform = GamePlatform::DOS;
+        out.description = "Found by a library scan.";
+
+        // Platform, hardware defaults and (for Windows programs) name from the headers
+        ExecutableInfo info;
+        if (info.Read(*main))
+            info.ApplyTo(out, true);
+        return true;
+    }
+
+} // namespace Core
@@ -0,0 +1,103 @@
+#ifndef GAMEDISCOVERY_H
+#define GAMEDISCOVERY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/GameCatalogue.h"
+#include "Core/GameEntry.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    struct DiscoveryProgress
+    {
+        uint64_t directories = 0; // Listed so far
+        uint64_t files = 0;
+        uint64_t proposals = 0;
+        int64_t queued = 0; // Directories waiting or being listed
+        bool running = false;
+    };
+
+    // <-- Game Discovery -->
+    // Crawls library roots for DOS/Windows games on a pool of workers and
+    // streams back one proposed GameEntry per folder holding a runnable
+    // (*.exe, *.com, *.bat): the folder name, the likeliest main program and
+    // a SETUP/INSTALL program next to it for setupPath.
+    //
+    // Each worker owns a deque of directories: it takes its newest (depth
+    // first, so the deque stays short) and, when it runs dry, steals the
+    // oldest from another worker (the biggest untouched subtrees). A count of
+    // outstanding directories tells the workers when the walk is done.
+    class GameDiscovery
+    {
+    public:
+        GameDiscovery() = default;
+        ~GameDiscovery();
+
+        GameDiscovery(const GameDiscovery &) = delete;
+        GameDiscovery &operator=(const GameDiscovery &) = delete;
+
+        // UI thread
+        bool Start(const std::vector<std::string> &roots);
+        // Names proposals from the catalogue when it knows the main program; set while idle
+        void SetCatalogue(const GameCatalogue *catalogue, FingerprintCache *fingerprints);
+        void Cancel();
+
+        // Moves proposals found since the last call into `out`; returns true if there were any
+        bool Poll(std::vector<GameEntry> &out);
+        DiscoveryProgress Progress() const;
+        bool IsRunning() const { return !m_threads.empty(); }
+
+        // Picks the main program and setup program among one folder's runnables
+        static bool Propose(const fs::path &dir, const std::vector<fs::path> &programs, GameEntry &out);
+
+    private:
+        struct Work
+        {
+            fs::path dir;
+            int depth;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Work> items;
+        };
+
+        void WorkerMain(size_t self);
+        bool Take(size_t self, Work &work);
+        void Visit(size_t self, const Work &work);
+        void Push(size_t self, Work work);
+        void Join();
+
+        static constexpr int MAX_DEPTH = 24; // Guards against junction/symlink loops
+
+        std::vector<std::unique_ptr<WorkQueue>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<int64_t> m_outstanding{0};
+        std::atomic<int> m_activeWorkers{0};
+        std::atomic<bool> m_cancel{false};
+        std::atomic<uint64_t> m_directories{0};
+        std::atomic<uint64_t> m_files{0};
+        std::atomic<uint64_t> m_proposals{0};
+        std::chrono::steady_clock::time_point m_startTime;
+        const GameCatalogue *m_catalogue = nullptr;
+        FingerprintCache *m_fingerprints = nullptr;
+
+        std::mutex m_foundMutex;
+        std::vector<GameEntry> m_found;
+    };
+
+} // namespace Core
+
+#endif // GAMEDISCOVERY_H
@@ -0,0 +1,135 @@
+#ifndef GAMEENTRY_H
+#define GAMEENTRY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/TextFold.h"
+
+namespace Core
+{
+    // Enums
+    enum class GamePlatform
+    {
+        DOS = 0,
+        Windows = 1,
+        DreammNative = 2
+    };
+
+    enum class GameStatus
+    {
+        Unplayable = 0,
+        Playable = 1
+    };
+
+    enum class MachineType
+    {
+        PC = 0,
+        Tandy = 1
+    };
+
+    // Data Structures
+    struct GameEntry
+    {
+        // Identity (persistent, never reused)
+        uint64_t id = 0;
+
+        // Metadata
+        std::string name = "New Game";
+        std::string description = "";
+        GamePlatform platform = GamePlatform::DOS;
+        GameStatus status = GameStatus::Unplayable;
+        std::vector<std::string> tags; // Collections; '/' nests ("studio/LucasArts")
+
+        // Paths
+        std::string exePath;
+        std::string setupPath;
+        std::string installPath;
+        std::string isoPath;
+        std::string rootPathOverride;
+
+        // Window Settings
+        bool forceWindowed = false;
+        bool forceMaximized = false;
+        bool forceFullscreen = false;
+
+        // Hardware Emulation
+        int ramKB = 16384;
+        int mips = 60;
+        MachineType machine = MachineType::PC;
+        bool audioFlags[6] = {false, false, false, true, false, false};
+        int videoHwIdx = 5;
+
+        // Display Settings
+        int width = 800;
+        int height = 600;
+        int depth = 32;
+    };
+
+    inline bool operator==(const GameEntry &a, const GameEntry &b)
+    {
+        return a.id == b.id && a.name == b.name && a.description == b.description && a.platform == b.platform &&
+               a.status == b.status && a.tags == b.tags && a.exePath == b.exePath && a.setupPath == b.setupPath &&
+               a.installPath == b.installPath && a.isoPath == b.isoPath && a.rootPathOverride == b.rootPathOverride &&
+               a.forceWindowed == b.forceWindowed && a.forceMaximized == b.forceMaximized &&
+               a.forceFullscreen == b.forceFullscreen && a.ramKB == b.ramKB && a.mips == b.mips &&
+               a.machine == b.machine && std::equal(a.audioFlags, a.audioFlags + 6, b.audioFlags) &&
+               a.videoHwIdx == b.videoHwIdx && a.width == b.width && a.height == b.height && a.depth == b.depth;
+    }
+
+    inline bool operator!=(const GameEntry &a, const GameEntry &b)
+    {
+        return !(a == b);
+    }
+
+    // <-- Tags -->
+    // Stored as one string, one tag per line; text formats use "; "
+    inline std::string JoinTags(const std::vector<std::string> &tags, std::string_view separator = "\n")
+    {
+        std::string joined;
+        for (const std::string &tag : tags)
+        {
+            if (!joined.empty())
+                joined += separator;
+            joined += tag;
+        }
+        return joined;
+    }
+
+    // Splits on newlines and ';', trims, and drops empty and repeated (case-insensitive) tags
+    inline std::vector<std::string> SplitTags(std::string_view text)
+    {
+        std::vector<std::string> tags;
+        size_t pos = 0;
+        while (pos <= text.size())
+        {
+            size_t end = text.find_first_of("\n;", pos);
+            if (end == std::string_view::npos)
+                end = text.size();
+            std::string_view tag = text.substr(pos, end - pos);
+            pos = end + 1;
+
+            size_t first = tag.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos)
+                continue;
+            tag = tag.substr(first, tag.find_last_not_of(" \t\r") - first + 1);
+
+            bool repeated = false;
+            for (const std::string &seen : tags)
+            {
+                repeated = EqualsNoCase(seen, tag);
+                if (repeated)
+                    break;
+            }
+            if (!repeated)
+                tags.emplace_back(tag);
+        }
+        return tags;
+    }
+
+} // namespace Core
+
+#endif // GAMEENTRY_H
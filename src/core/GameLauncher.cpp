@@ -1,13 +1,23 @@
 #include "pch.h"
 #include "Core/GameLauncher.h"
+#include "Core/ExecutableInfo.h"
 #include "Core/GameDatabase.h"
+#include "Core/LibraryExchange.h"
+#include "Core/LibraryFile.h"
+#include "Core/MappedFile.h"
+#include "Core/TextFold.h"
+#include "Core/TextTokenizer.h"
 #include "Core/Version.h"
 #include "UI/Theme.h"
 #include "UI/UIManager.h"
 #include <iostream>
 #include <sstream>
+#include <chrono>
 #include <cstdlib>
+#include <random>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -18,15 +28,6 @@ namespace Core
 {
 
     // <-- Utilities -->
-    static std::string Trim(const std::string &str)
-    {
-        size_t first = str.find_first_not_of(" \t\n\r");
-        if (std::string::npos == first)
-            return str;
-        size_t last = str.find_last_not_of(" \t\n\r");
-        return str.substr(first, (last - first + 1));
-    }
-
     std::vector<std::string> GetAvailableDrives()
     {
         std::vector<std::string> drives;
@@ -46,6 +47,39 @@ namespace Core
         return drives;
     }
 
+    // <-- Library Files -->
+    static const char *LIBRARY_FILE = "games.bin";
+    static const char *TEXT_DATABASE_FILE = "games.db";
+    static const char *JOURNAL_FILE = "games.journal";
+    static const char *CONFIG_FILE = "launcher_config.txt";
+    static const char *DREAMM_SCAN_CACHE_FILE = "dreamm_scan.cache";
+    static const char *ICON_CACHE_FILE = "icons.cache";
+    static const char *CATALOGUE_FILE = "catalogue.bin";
+    static const char *CATALOGUE_SOURCE_FILE = "catalogue.txt";
+    static const char *FINGERPRINT_CACHE_FILE = "fingerprints.cache";
+
+    // Import / export targets, indexed by m_exchangeFormat
+    static const char *EXCHANGE_FILES[] = {"games.db", "games.csv", "games.jsonl"};
+    static const char *EXCHANGE_FORMAT_NAMES[] = {"games.db (pipe-delimited)", "games.csv (CSV)", "games.jsonl (JSON Lines)"};
+    static const uintmax_t JOURNAL_COMPACT_BYTES = 256 * 1024;
+
+    // Search work done on the UI thread while the search thread answers a new query
+    static const size_t INTERIM_RANKED_NAMES = 1024;  // Names scored, the first past the prefilter
+    static const size_t INTERIM_RECHECKED_HITS = 1024; // Previous full-text hits re-checked
+
+    static uint64_t NewGameId()
+    {
+        static std::mt19937_64 rng(((uint64_t)std::random_device{}() << 32) ^ (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+        uint64_t id = 0;
+        while (id == 0)
+            id = rng();
+        return id;
+    }
+
+    // <-- Library Table Labels -->
+    static const char *PLATFORM_LABELS[] = {"DOS", "Windows", "DREAMM"};
+    static const char *STATUS_LABELS[] = {"Unplayable", "Playable"};
+
     // <-- RAM Options -->
     static const int RAM_VALUES[] = {640, 1024, 4096, 8192, 16384, 32768, 65536, 131072, 262144};
     static const char *RAM_LABELS[] = {"640 KB", "1 MB", "4 MB", "8 MB", "16 MB", "32 MB", "64 MB", "128 MB", "256 MB"};
@@ -98,7 +132,7 @@ namespace Core
         m_showEditWindow = false;
         m_showFileBrowser = false;
         m_pendingBrowserOpen = false;
-        m_selectedGameIdx = -1;
+        m_selectedGameId = 0;
 
         m_triggerNewGamesModal = false;
         m_showNewGamesModal = false;
@@ -107,13 +141,34 @@ namespace Core
 
     GameLauncher::~GameLauncher()
     {
+        m_discovery.Cancel();
+        m_dreammWatcher.Stop();
+        m_dreammScanner.Stop();
+        m_icons.Stop();
+        m_covers.Stop();
+        while (m_export.active)
+            UpdateExport();
+
+        // Write out anything still waiting on the debounce, then drain the worker
+        uint32_t pending = m_persistence.TakeAll();
+        if (pending & PersistConfig)
+            SaveConfig();
+        if ((pending & PersistIcons) || m_icons.TakeDirty())
+            SaveIcons();
+        if ((pending & PersistFingerprints) || m_fingerprints.TakeDirty())
+            SaveFingerprints();
         SaveDatabase();
+        m_persistence.Stop();
+        m_search.Stop();
     }
 
     void GameLauncher::Initialize()
     {
         LoadConfig();
+        ApplyWindowLayout();
         LoadDatabase();
+        m_icons.Load(ICON_CACHE_FILE);
+        LoadCatalogue();
 
         ConvertLegacyDatabase();
 
@@ -141,7 +196,8 @@ namespace Core
                 if (!isDir && !extensions.empty())
                 {
                     std::string ext = entry.path().extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+                    for (char &c : ext)
+                        c = Core::FoldAscii(c);
 
                     bool match = false;
                     for (const auto &allowed : extensions)
@@ -169,11 +225,7 @@ namespace Core
                       {
                           if (a.isDirectory != b.isDirectory)
                               return a.isDirectory;
-                          std::string s1 = a.name;
-                          std::string s2 = b.name;
-                          std::transform(s1.begin(), s1.end(), s1.begin(), ::tolower);
-                          std::transform(s2.begin(), s2.end(), s2.begin(), ::tolower);
-                          return s1 < s2;
+                          return Core::GameLibrary::NameLess(a.name, b.name);
                       });
         }
         catch (...)
@@ -182,176 +234,188 @@ namespace Core
         return entries;
     }
 
-    void GameLauncher::ConvertLegacyDatabase()
+    // <-- Legacy Conversion (games_db.txt) -->
+    // Old File Indices: 0=Name, 1=Exe, 2=Setup, 3=Platform, 4=Status, 5=RAM, 6=Audio,
+    // 7=Video, 8=Width, 9=Height, 10=Depth, 11=MIPS, 12=Machine, 13=Description
+    static bool ParseLegacyRow(std::string_view line, GameEntry &g, uint32_t &errorMask)
     {
-        const std::string legacyFile = "games_db.txt";
-        if (!fs::exists(legacyFile))
-            return;
+        FieldTokenizer parts(line);
+        if (parts.Count() < 13)
+            return false;
 
-        SDL_Log("Legacy DB found. Converting...");
-        std::ifstream file(legacyFile);
-        if (!file.is_open())
-            return;
+        g.name.assign(parts.Field(0));
+        g.exePath.assign(parts.Field(1));
+        g.setupPath.assign(parts.Field(2));
 
-        std::string line;
-        int lineCount = 0;
-        int imported = 0;
+        parts.Int(3, g.platform);
+        parts.Int(4, g.status);
+        if (!parts.Int(5, g.ramKB))
+            g.ramKB = 640;
 
-        while (std::getline(file, line))
+        int audioMask = 0;
+        parts.Int(6, audioMask);
+
+        parts.Int(7, g.videoHwIdx);
+        parts.Int(8, g.width);
+        parts.Int(9, g.height);
+        parts.Int(10, g.depth);
+        parts.Int(11, g.mips);
+        parts.Int(12, g.machine);
+        if (parts.Count() > 13)
+            g.description.assign(parts.Field(13));
+
+        if (g.videoHwIdx < 0 || g.videoHwIdx >= 6)
+            g.videoHwIdx = 5;
+
+        // The exe's headers decide the platform; the name is only a fallback
+        // for entries whose exe isn't there (any more)
+        ExecutableInfo info;
+        if (!g.exePath.empty() && info.Read(g.exePath) && info.format != ExecutableFormat::Batch)
         {
-            line = Trim(line);
-            lineCount++;
+            g.platform = info.Platform();
+        }
+        else if (g.name.find("(win)") != std::string::npos ||
+                 g.name.find("Windows") != std::string::npos)
+        {
+            g.platform = GamePlatform::Windows;
+        }
 
-            // Line 1: Dreamm Path (Legacy)
-            if (lineCount == 1 && m_dreammExePath.empty() && fs::exists(line))
-            {
-                m_dreammExePath = line;
-                SaveConfig();
-                continue;
-            }
-            if (lineCount <= 2 || line.empty())
-                continue;
+        // Set Audio Flags
+        for (int i = 0; i < 6; i++)
+            g.audioFlags[i] = (audioMask & (1 << i));
 
-            // Manual Split
-            std::vector<std::string> parts;
-            size_t start = 0, end = line.find('|');
-            while (end != std::string::npos)
-            {
-                parts.push_back(line.substr(start, end - start));
-                start = end + 1;
-                end = line.find('|', start);
-            }
-            parts.push_back(line.substr(start));
+        // Force GMIDI for Windows
+        if (g.platform == GamePlatform::Windows)
+        {
+            g.audioFlags[5] = true; // GMIDI
+            if (g.ramKB < 16384)
+                g.ramKB = 16384;
+        }
+        else if (audioMask == 0)
+        {
+            // DOS Default
+            g.audioFlags[3] = true; // SB16
+        }
 
-            if (parts.size() < 13)
-                continue;
+        errorMask = parts.ErrorMask();
+        return true;
+    }
 
-            // Skip Duplicates
-            bool dup = false;
-            for (auto &g : m_games)
-                if (g.exePath == parts[1])
-                {
-                    dup = true;
-                    break;
-                }
-            if (dup)
+    struct LegacyChunk
+    {
+        std::vector<GameEntry> games;
+        int badRows = 0;
+    };
+
+    static LegacyChunk ParseLegacyChunk(std::string_view text)
+    {
+        LegacyChunk chunk;
+        TextLineReader reader(text);
+        std::string_view line;
+        while (reader.Next(line))
+        {
+            line = FieldTokenizer::Trimmed(line);
+            if (line.empty())
                 continue;
 
             GameEntry g;
-            g.name = parts[0];
-            g.exePath = parts[1];
-            g.setupPath = parts[2];
-
-            // Old File Indices: 3=Platform, 4=Status, 5=RAM, 6=Audio, 7=Video
-            try
-            {
-                g.platform = (GamePlatform)std::stoi(parts[3]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.status = (GameStatus)std::stoi(parts[4]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.ramKB = std::stoi(parts[5]);
-            }
-            catch (...)
-            {
-                g.ramKB = 640;
-            }
+            uint32_t errorMask = 0;
+            if (!ParseLegacyRow(line, g, errorMask))
+                continue;
+            if (errorMask != 0)
+                chunk.badRows++;
+            chunk.games.push_back(std::move(g));
+        }
+        return chunk;
+    }
 
-            int audioMask = 0;
-            try
-            {
-                audioMask = std::stoi(parts[6]);
-            }
-            catch (...)
-            {
-            }
+    // Cuts `text` into roughly equal pieces that each end on a line boundary
+    static std::vector<std::string_view> SplitIntoLineChunks(std::string_view text, size_t count)
+    {
+        std::vector<std::string_view> chunks;
+        size_t start = 0;
+        for (size_t i = 1; i <= count && start < text.size(); ++i)
+        {
+            size_t end = (i == count) ? text.size() : std::max(start, text.size() * i / count);
+            end = (end >= text.size()) ? text.size() : text.find('\n', end);
+            end = (end == std::string_view::npos) ? text.size() : end + 1;
+            chunks.push_back(text.substr(start, end - start));
+            start = end;
+        }
+        return chunks;
+    }
 
-            try
-            {
-                g.videoHwIdx = std::stoi(parts[7]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.width = std::stoi(parts[8]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.height = std::stoi(parts[9]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.depth = std::stoi(parts[10]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.mips = std::stoi(parts[11]);
-            }
-            catch (...)
-            {
-            }
-            try
-            {
-                g.machine = (MachineType)std::stoi(parts[12]);
-            }
-            catch (...)
-            {
-            }
-            if (parts.size() > 13)
-                g.description = parts[13];
+    void GameLauncher::ConvertLegacyDatabase()
+    {
+        const std::string legacyFile = "games_db.txt";
+        if (!fs::exists(legacyFile))
+            return;
 
-            // Detect Windows strictly
-            if (g.name.find("(win)") != std::string::npos ||
-                g.name.find("Windows") != std::string::npos)
-            {
-                g.platform = GamePlatform::Windows;
-            }
+        SDL_Log("Legacy DB found. Converting...");
+        MappedFile file;
+        if (!file.Open(legacyFile))
+            return;
 
-            // Set Audio Flags
-            for (int i = 0; i < 6; i++)
-                g.audioFlags[i] = (audioMask & (1 << i));
+        auto startTime = std::chrono::steady_clock::now();
+        std::string_view text(reinterpret_cast<const char *>(file.Data()), file.Size());
 
-            // Force GMIDI for Windows
-            if (g.platform == GamePlatform::Windows)
+        // Line 1: Dreamm Path (Legacy), Line 2: unused
+        TextLineReader header(text);
+        std::string_view line;
+        if (header.Next(line))
+        {
+            line = FieldTokenizer::Trimmed(line);
+            if (m_dreammExePath.empty() && !line.empty() && fs::exists(fs::path(line)))
             {
-                g.audioFlags[5] = true; // GMIDI
-                if (g.ramKB < 16384)
-                    g.ramKB = 16384;
+                m_dreammExePath.assign(line);
+                SaveConfig();
             }
-            else if (audioMask == 0)
+        }
+        header.Next(line);
+        std::string_view body = text.substr(header.Offset());
+
+        // Parse the rows in parallel, one chunk per thread
+        const size_t MIN_CHUNK_BYTES = 256 * 1024;
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t chunkCount = std::clamp<size_t>(body.size() / MIN_CHUNK_BYTES, 1, threads);
+
+        std::vector<std::future<LegacyChunk>> jobs;
+        for (std::string_view chunk : SplitIntoLineChunks(body, chunkCount))
+            jobs.push_back(std::async(std::launch::async, ParseLegacyChunk, chunk));
+
+        // Dedupe against every entry's exePath
+        std::unordered_set<std::string> seenExe;
+        seenExe.reserve(m_library.Size() + body.size() / 64);
+        for (size_t i = 0; i < m_library.Size(); ++i)
+        {
+            std::string exePath = m_library.Path(i, GamePath::Exe);
+            if (!exePath.empty())
+                seenExe.insert(FoldPath(exePath));
+        }
+
+        // Chunks are collected in file order so the first occurrence of a path wins
+        std::vector<GameEntry> converted;
+        int badRows = 0;
+        for (auto &job : jobs)
+        {
+            LegacyChunk chunk = job.get();
+            badRows += chunk.badRows;
+            for (auto &g : chunk.games)
             {
-                // DOS Default
-                g.audioFlags[3] = true; // SB16
+                if (!g.exePath.empty() && !seenExe.insert(FoldPath(g.exePath)).second)
+                    continue;
+                converted.push_back(std::move(g));
             }
-
-            m_games.push_back(g);
-            imported++;
         }
-        file.close();
+        file.Close();
+
+        if (badRows > 0)
+            SDL_Log("%s: %d rows had bad numeric fields, using defaults.", legacyFile.c_str(), badRows);
 
+        int imported = (int)converted.size();
         if (imported > 0)
         {
-            SortLibrary();
+            MergeNewGames(std::move(converted));
             SaveDatabase();
             try
             {
@@ -360,89 +424,394 @@ namespace Core
             catch (...)
             {
             }
-            SDL_Log("Converted %d games and deleted legacy file.", imported);
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            SDL_Log("Converted %d games in %.1f ms (%d threads) and deleted legacy file.", imported, seconds * 1000.0, (int)jobs.size());
         }
     }
 
+    // Starts the install scan and the watcher; results arrive through UpdateDreammScan
     void GameLauncher::ScanDreammGames()
     {
         char path[MAX_PATH];
-        if (SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, path)))
+        if (!SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, path)))
+            return;
+
+        m_dreammRoot = fs::path(path) / "Aaron Giles" / "DREAMM" / "install";
+
+        // Dedupe by a hash of the DREAMM installs already in the library
+        m_dreammInstalls.clear();
+        std::string installPath;
+        for (size_t i = 0; i < m_library.Size(); ++i)
         {
-            fs::path dreammRoot = fs::path(path) / "Aaron Giles" / "DREAMM" / "install";
+            m_library.PeekPath(i, GamePath::Install, installPath);
+            if (!FranchiseIndex::DreammFolderId(installPath).empty())
+                m_dreammInstalls.emplace(FoldPath(installPath), m_library.Id(i));
+        }
 
-            if (!fs::exists(dreammRoot))
-                return;
+        std::unordered_set<std::string> known;
+        known.reserve(m_dreammInstalls.size());
+        for (const auto &install : m_dreammInstalls)
+            known.insert(install.first);
+
+        m_newGamesCount = 0;
+        m_dreammScanner.Start(m_dreammRoot, DREAMM_SCAN_CACHE_FILE, std::move(known));
+        m_dreammWatcher.Start(m_dreammRoot);
+    }
+
+    // Merges whatever the scanner has found since the last frame, one batch at a
+    // time, then the folders the watcher saw change
+    void GameLauncher::UpdateDreammScan()
+    {
+        if (m_dreammScanner.IsRunning())
+        {
+            std::vector<DreammInstall> found;
+            m_dreammScanner.Poll(found);
 
-            int addedCount = 0;
+            int before = (int)m_library.Size();
+            AddDreammInstalls(std::move(found));
+            m_newGamesCount += (int)m_library.Size() - before;
 
-            for (const auto &gameDir : fs::directory_iterator(dreammRoot))
+            if (!m_dreammScanner.IsRunning() && m_newGamesCount > 0)
             {
-                if (!gameDir.is_directory())
-                    continue;
+                // Trigger the modal
+                m_triggerNewGamesModal = true;
+                SDL_Log("Scanned and added %d new DREAMM games.", m_newGamesCount);
+            }
+            return; // Watcher changes wait for the scan, so it can't re-add a folder deleted meanwhile
+        }
 
-                std::string folderID = gameDir.path().filename().string();
-                if (folderID.empty() || folderID[0] == '~')
-                    continue;
+        std::vector<DreammFolderListing> changed;
+        if (m_dreammWatcher.TakeSettled(changed))
+        {
+            for (const DreammFolderListing &listing : changed)
+                ApplyDreammListing(listing);
+        }
+    }
 
-                for (const auto &versionDir : fs::directory_iterator(gameDir.path()))
-                {
-                    if (!versionDir.is_directory())
-                        continue;
+    // Adds the version folders that aren't in the library yet, as one sorted merge
+    void GameLauncher::AddDreammInstalls(std::vector<DreammInstall> installs)
+    {
+        std::vector<GameEntry> incoming;
+        incoming.reserve(installs.size());
+        for (DreammInstall &install : installs)
+        {
+            auto inserted = m_dreammInstalls.emplace(FoldPath(install.installPath), 0);
+            if (!inserted.second)
+                continue;
 
-                    std::string fullPath = versionDir.path().string();
-                    std::string folderID = gameDir.path().filename().string();
-                    std::string versionID = versionDir.path().filename().string();
+            GameEntry newGame;
+            newGame.id = NewGameId();
+            newGame.installPath = std::move(install.installPath);
+            newGame.platform = GamePlatform::DreammNative;
 
-                    // We check if any existing game has the same install path
-                    bool exists = false;
-                    for (const auto &g : m_games)
-                    {
-                        if (g.installPath == fullPath)
-                        {
-                            exists = true;
-                            break;
-                        }
-                    }
+            // Use the Resolver to get a nice name
+            newGame.name = ResolveDreammGameName(install.folderID, install.versionID, newGame.platform);
 
-                    // If it exists, SKIP IT. Do not add it again.
-                    if (exists)
-                        continue;
+            // Defaults
+            newGame.status = GameStatus::Playable;
+            newGame.description = "Auto-detected DREAMM installation.";
 
-                    GameEntry newGame;
-                    newGame.installPath = fullPath;
-                    newGame.platform = GamePlatform::DreammNative;
+            inserted.first->second = newGame.id;
+            incoming.push_back(std::move(newGame));
+        }
+
+        if (incoming.empty())
+            return;
+
+        MergeNewGames(std::move(incoming));
+        RequestSave(PersistLibrary);
+    }
+
+    // Brings the library in line with one game folder's version folders: new
+    // ones are added, missing ones removed, and a lone rename repoints the
+    // existing entry so its settings survive
+    void GameLauncher::ApplyDreammListing(const DreammFolderListing &listing)
+    {
+        fs::path folderPath = m_dreammRoot / listing.folderID;
+        std::string prefix = FoldPath(folderPath.string());
+        prefix += '\\';
 
-                    // Use the Resolver to get a nice name
-                    newGame.name = ResolveDreammGameName(folderID, versionID, newGame.platform);
+        std::unordered_set<std::string> present;
+        std::vector<DreammInstall> added;
+        for (const std::string &versionID : listing.versions)
+        {
+            std::string fullPath = (folderPath / versionID).string();
+            std::string folded = FoldPath(fullPath);
+            if (!m_dreammInstalls.count(folded))
+                added.push_back(DreammInstall{listing.folderID, versionID, std::move(fullPath)});
+            present.insert(std::move(folded));
+        }
 
-                    // Defaults
-                    newGame.status = GameStatus::Playable;
-                    newGame.description = "Auto-detected DREAMM installation.";
+        // Entries directly under this folder whose version folder is gone
+        std::vector<std::pair<std::string, uint64_t>> gone;
+        for (const auto &install : m_dreammInstalls)
+        {
+            const std::string &key = install.first;
+            if (key.size() > prefix.size() && key.compare(0, prefix.size(), prefix) == 0 &&
+                key.find('\\', prefix.size()) == std::string::npos && !present.count(key))
+                gone.push_back(install);
+        }
 
-                    m_games.push_back(newGame);
-                    addedCount++;
+        if (gone.size() == 1 && added.size() == 1)
+        {
+            size_t idx = m_library.IndexOf(gone[0].second);
+            if (idx != GameLibrary::npos)
+            {
+                GameEntry game = m_library.Get(idx);
+                game.installPath = added[0].installPath;
+                m_library.Set(idx, game);
+                MarkGameDirty(game.id);
+                m_search.Upsert(game.id, m_library.SearchText(idx));
+
+                m_dreammInstalls.erase(gone[0].first);
+                m_dreammInstalls.emplace(FoldPath(game.installPath), game.id);
+                if (game.id == m_selectedGameId)
+                {
+                    m_selectedGame.installPath = game.installPath;
+                    m_storedSelectedGame.installPath = game.installPath;
                 }
+                RequestSave(PersistLibrary);
+                SDL_Log("DREAMM install moved: %s", game.installPath.c_str());
+                return;
             }
+        }
+
+        for (const auto &install : gone)
+        {
+            // Only if the entry still points there (it may have been edited since)
+            std::string installPath;
+            size_t idx = m_library.IndexOf(install.second);
+            if (idx != GameLibrary::npos)
+                m_library.PeekPath(idx, GamePath::Install, installPath);
+            if (idx != GameLibrary::npos && FoldPath(installPath) == install.first)
+            {
+                SDL_Log("DREAMM install removed: %s", installPath.c_str());
+                RemoveGame(install.second);
+                RequestSave(PersistLibrary);
+            }
+            m_dreammInstalls.erase(install.first);
+        }
+
+        if (!added.empty())
+            SDL_Log("DREAMM installs added in %s: %d", listing.folderID.c_str(), (int)added.size());
+        AddDreammInstalls(std::move(added));
+    }
+
+    // <-- Library Root Discovery -->
+    void GameLauncher::StartDiscovery()
+    {
+        if (m_discovery.IsRunning() || m_configLibraryRoots.empty())
+            return;
+
+        // Programs already in the library (or in the review list) aren't proposed again
+        m_discoveryKnown.clear();
+        m_discoveryKnown.reserve(m_library.Size() + m_discoveryProposals.size());
+        std::string exePath;
+        for (size_t i = 0; i < m_library.Size(); ++i)
+        {
+            m_library.PeekPath(i, GamePath::Exe, exePath);
+            if (!exePath.empty())
+                m_discoveryKnown.insert(FoldPath(exePath));
+        }
+        for (const DiscoveryProposal &proposal : m_discoveryProposals)
+            m_discoveryKnown.insert(FoldPath(proposal.game.exePath));
+
+        m_discovery.Start(m_configLibraryRoots);
+    }
+
+    // Streams whatever the crawl found since the last frame into the review list
+    void GameLauncher::UpdateDiscovery()
+    {
+        std::vector<GameEntry> found;
+        if (!m_discovery.Poll(found))
+            return;
+
+        for (GameEntry &game : found)
+        {
+            if (!m_discoveryKnown.insert(FoldPath(game.exePath)).second)
+                continue;
+            m_discoveryProposals.push_back(DiscoveryProposal{std::move(game), true});
+        }
+    }
 
-            if (addedCount > 0)
+    void GameLauncher::RenderDiscoveryWindow()
+    {
+        if (m_triggerDiscoveryWindow)
+        {
+            ImGui::OpenPopup("Find Games");
+            m_triggerDiscoveryWindow = false;
+            m_showDiscoveryWindow = true;
+        }
+
+        ImVec2 center = ImGui::GetMainViewport()->GetCenter();
+        ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+        ImGui::SetNextWindowSize(ImVec2(820, 560), ImGuiCond_Appearing);
+
+        if (!ImGui::BeginPopupModal("Find Games", &m_showDiscoveryWindow, ImGuiWindowFlags_NoDocking))
+            return;
+
+        // <-- Roots -->
+        ImGui::TextDisabled("LIBRARY FOLDERS");
+        ImGui::Separator();
+
+        bool running = m_discovery.IsRunning();
+        for (size_t i = 0; i < m_configLibraryRoots.size(); ++i)
+        {
+            ImGui::PushID((int)i);
+            ImGui::BeginDisabled(running);
+            bool remove = ImGui::SmallButton("x");
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            ImGui::TextUnformatted(m_configLibraryRoots[i].c_str());
+            ImGui::PopID();
+
+            if (remove)
             {
-                // Sort the list so the new games appear in alphabetical order
-                SortLibrary();
+                m_configLibraryRoots.erase(m_configLibraryRoots.begin() + i);
+                RequestSave(PersistConfig);
+                break;
+            }
+        }
 
-                // Trigger the modal
-                m_newGamesCount = addedCount;
-                m_triggerNewGamesModal = true;
-                SDL_Log("Scanned and added %d new DREAMM games.", addedCount);
+        ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 100.0f);
+        bool submitted = ImGui::InputTextWithHint("##NewRoot", "C:\\Games", m_discoveryRootInput, sizeof(m_discoveryRootInput), ImGuiInputTextFlags_EnterReturnsTrue);
+        ImGui::SameLine();
+        if ((ImGui::Button("Add Folder", ImVec2(-1, 0)) || submitted) && m_discoveryRootInput[0] != '\0')
+        {
+            std::string root(FieldTokenizer::Trimmed(m_discoveryRootInput));
+            std::error_code ec;
+            if (!fs::is_directory(root, ec))
+            {
+                SDL_Log("Not a folder: %s", root.c_str());
+            }
+            else if (std::find(m_configLibraryRoots.begin(), m_configLibraryRoots.end(), root) == m_configLibraryRoots.end())
+            {
+                m_configLibraryRoots.push_back(std::move(root));
+                RequestSave(PersistConfig);
+            }
+            m_discoveryRootInput[0] = '\0';
+        }
+
+        // <-- Crawl -->
+        ImGui::Spacing();
+        if (running)
+        {
+            if (ImGui::Button("Cancel", ImVec2(120, 0)))
+                m_discovery.Cancel();
+        }
+        else
+        {
+            ImGui::BeginDisabled(m_configLibraryRoots.empty());
+            if (ImGui::Button("Scan Folders", ImVec2(120, 0)))
+                StartDiscovery();
+            ImGui::EndDisabled();
+        }
+
+        DiscoveryProgress progress = m_discovery.Progress();
+        ImGui::SameLine();
+        if (progress.running)
+            ImGui::Text("Scanning... %llu folders, %llu files, %lld queued", (unsigned long long)progress.directories,
+                        (unsigned long long)progress.files, (long long)progress.queued);
+        else if (progress.directories > 0)
+            ImGui::TextDisabled("%llu folders, %llu files searched", (unsigned long long)progress.directories, (unsigned long long)progress.files);
+
+        // <-- Review -->
+        ImGui::Spacing();
+        ImGui::TextDisabled("FOUND (%d)", (int)m_discoveryProposals.size());
+        ImGui::Separator();
+
+        float footerHeight = ImGui::GetFrameHeightWithSpacing() + ImGui::GetStyle().ItemSpacing.y;
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable;
+        if (ImGui::BeginTable("##Proposals", 4, tableFlags, ImVec2(0, -footerHeight)))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 24.0f);
+            ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableSetupColumn("Program", ImGuiTableColumnFlags_WidthStretch, 2.0f);
+            ImGui::TableSetupColumn("Setup", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin((int)m_discoveryProposals.size());
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+                {
+                    DiscoveryProposal &proposal = m_discoveryProposals[row];
+                    ImGui::PushID(row);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Checkbox("##Accept", &proposal.accept);
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(proposal.game.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(proposal.game.exePath.c_str());
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("%s", proposal.game.exePath.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(proposal.game.setupPath.empty() ? "-" : fs::path(proposal.game.setupPath).filename().string().c_str());
+                    ImGui::PopID();
+                }
             }
+            clipper.End();
+            ImGui::EndTable();
+        }
+
+        int accepted = 0;
+        for (const DiscoveryProposal &proposal : m_discoveryProposals)
+            accepted += proposal.accept ? 1 : 0;
+
+        if (ImGui::Button("All"))
+        {
+            for (DiscoveryProposal &proposal : m_discoveryProposals)
+                proposal.accept = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("None"))
+        {
+            for (DiscoveryProposal &proposal : m_discoveryProposals)
+                proposal.accept = false;
         }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear List"))
+            m_discoveryProposals.clear();
+
+        ImGui::SameLine();
+        ImGui::BeginDisabled(accepted == 0);
+        char addLabel[64];
+        snprintf(addLabel, sizeof(addLabel), "Add %d to Library", accepted);
+        if (ImGui::Button(addLabel, ImVec2(-1, 0)))
+        {
+            // Accepted ones go in as one sorted merge; the rest stay up for review
+            std::vector<GameEntry> incoming;
+            std::vector<DiscoveryProposal> remaining;
+            for (DiscoveryProposal &proposal : m_discoveryProposals)
+            {
+                if (proposal.accept)
+                {
+                    proposal.game.id = NewGameId();
+                    incoming.push_back(std::move(proposal.game));
+                }
+                else
+                    remaining.push_back(std::move(proposal));
+            }
+            m_discoveryProposals.swap(remaining);
+
+            SDL_Log("Added %d games from library folders.", (int)incoming.size());
+            MergeNewGames(std::move(incoming));
+            RequestSave(PersistLibrary);
+        }
+        ImGui::EndDisabled();
+
+        ImGui::EndPopup();
     }
 
     void GameLauncher::RenderNewGamesModal()
     {
-        // fails to work at the moment -- TODO
-
-        if (m_triggerNewGamesModal)
+        // Raised once the scan has finished, and held back while another popup is
+        // up (Locate DREAMM, settings) so it isn't opened underneath and lost
+        if (m_triggerNewGamesModal && !ImGui::IsPopupOpen("", ImGuiPopupFlags_AnyPopupId | ImGuiPopupFlags_AnyPopupLevel))
         {
             m_showNewGamesModal = true;
             m_triggerNewGamesModal = false;
@@ -478,202 +847,676 @@ namespace Core
     // Helper to look up readable names
     std::string GameLauncher::ResolveDreammGameName(const std::string &folderID, const std::string &versionID, GamePlatform &outPlatform)
     {
-        const auto &idToName = Core::GameDatabase::GetDreammMap();
+        std::string_view title = GameDatabase::FindDreammTitle(folderID);
+        DreammVersion version = GameDatabase::ParseDreammVersion(versionID);
+        outPlatform = version.platform;
+
+        // Combine: Name + (Platform/Demo) + Language
+        std::string name(title.empty() ? std::string_view(folderID) : title);
+        name += version.platformLabel;
+        if (version.demo)
+            name += " (Demo)";
+        name += version.languageLabel;
+        return name;
+    }
+
+    // <-- Helper: Sort Library -->
+    static bool GameNameLess(const GameEntry &a, const GameEntry &b)
+    {
+        return GameLibrary::NameLess(a.name, b.name);
+    }
+
+    void GameLauncher::SortLibrary()
+    {
+        if (m_library.Empty())
+            return;
+
+        m_library.SortByName();
+
+        // Selection follows the id; just bring it back into view
+        if (m_library.IndexOf(m_selectedGameId) != GameLibrary::npos)
+            m_autoScrollFrames = 3;
+    }
+
+    // <-- Persistence -->
+    void GameLauncher::LoadConfig()
+    {
+        MappedFile file;
+        if (!file.Open(CONFIG_FILE))
+        {
+            UI::ThemeManager::ApplyTheme((UI::AppTheme)m_configTheme);
+            return;
+        }
+
+        TextLineReader reader(std::string_view(reinterpret_cast<const char *>(file.Data()), file.Size()));
+        std::string_view line;
+
+        // Settings
+        if (reader.Next(line))
+        {
+            FieldTokenizer fields(line);
+
+            if (fields.Count() >= 3)
+            {
+                fields.Flag(0, m_configEnableBackground);
+                fields.Flag(1, m_configMouseWarp);
+                if (!fields.Int(2, m_configTheme))
+                    m_configTheme = 0;
+            }
+
+            // Check if path is on Line 1 (Format: 1|1|5|C:\Path)
+            if (fields.Count() >= 4)
+            {
+                m_dreammExePath.assign(fields.Field(3));
+            }
+        }
+
+        // --- Path (Fallback) ---
+        // If the path wasn't on line 1, checking if it's on line 2 (Format: 1|1|5 \n C:\Path)
+        if (reader.Next(line))
+        {
+            if (m_dreammExePath.empty() && !line.empty())
+            {
+                m_dreammExePath.assign(line);
+            }
+        }
+
+        // --- Window Layout (Line 3, Format: 1024|768|340) ---
+        if (reader.Next(line))
+        {
+            FieldTokenizer fields(line);
+
+            int width = 0, height = 0, sidebar = 0;
+            if (fields.Int(0, width) && fields.Int(1, height) && fields.Int(2, sidebar))
+            {
+                m_configWindowWidth = width;
+                m_configWindowHeight = height;
+                m_configSidebarWidth = (float)sidebar;
+            }
+        }
+
+        // --- View (Line 4, Format: grouped|grid) ---
+        if (reader.Next(line))
+        {
+            FieldTokenizer fields(line);
+            fields.Flag(0, m_configGroupedView);
+            fields.Flag(1, m_configGridView);
+        }
+
+        // --- Library Roots (Line 5, Format: root|root|...) ---
+        if (reader.Next(line))
+        {
+            FieldTokenizer fields(line);
+            for (int i = 0; i < fields.Count(); ++i)
+            {
+                std::string root;
+                AssignUnescapedField(root, FieldTokenizer::Trimmed(fields.Field(i)));
+                if (!root.empty())
+                    m_configLibraryRoots.push_back(std::move(root));
+            }
+        }
+
+        // Cleanup
+        while (!m_dreammExePath.empty() &&
+               (m_dreammExePath.back() == '\n' || m_dreammExePath.back() == '\r' || m_dreammExePath.back() == ' '))
+        {
+            m_dreammExePath.pop_back();
+        }
+
+        file.Close();
+
+        // Apply Theme
+        UI::ThemeManager::ApplyTheme((UI::AppTheme)m_configTheme);
+    }
+
+    void GameLauncher::SaveConfig()
+    {
+        std::ostringstream file;
+        file << (m_configEnableBackground ? "1" : "0") << "|"
+             << (m_configMouseWarp ? "1" : "0") << "|"
+             << m_configTheme << "\n"
+             << m_dreammExePath << "\n"
+             << m_configWindowWidth << "|"
+             << m_configWindowHeight << "|"
+             << (int)m_configSidebarWidth << "\n"
+             << (m_configGroupedView ? "1" : "0") << "|"
+             << (m_configGridView ? "1" : "0") << "\n";
+
+        std::string roots;
+        for (size_t i = 0; i < m_configLibraryRoots.size(); ++i)
+        {
+            if (i > 0)
+                roots += '|';
+            AppendEscapedField(roots, m_configLibraryRoots[i]);
+        }
+        file << roots;
+
+        m_persistence.Submit([contents = file.str()]
+                             { PersistenceWorker::WriteFileAtomic(CONFIG_FILE, contents); });
+    }
+
+    void GameLauncher::SaveIcons()
+    {
+        m_persistence.Submit([contents = m_icons.Serialize(m_library)]
+                             { PersistenceWorker::WriteFileAtomic(ICON_CACHE_FILE, contents); });
+    }
+
+    void GameLauncher::SaveFingerprints()
+    {
+        m_persistence.Submit([contents = m_fingerprints.Serialize()]
+                             { PersistenceWorker::WriteFileAtomic(FINGERPRINT_CACHE_FILE, contents); });
+    }
+
+    // catalogue.txt is compiled to catalogue.bin once per edit; the binary is only mapped
+    void GameLauncher::LoadCatalogue()
+    {
+        if (GameCatalogue::NeedsCompile(CATALOGUE_SOURCE_FILE, CATALOGUE_FILE))
+            GameCatalogue::Compile(CATALOGUE_SOURCE_FILE, CATALOGUE_FILE);
+        if (m_catalogue.Open(CATALOGUE_FILE))
+            m_fingerprints.Load(FINGERPRINT_CACHE_FILE);
+        m_discovery.SetCatalogue(&m_catalogue, &m_fingerprints);
+    }
+
+    // Debounced save; bursts of changes collapse into one write
+    void GameLauncher::RequestSave(uint32_t targets)
+    {
+        m_persistence.MarkDirty(targets);
+    }
+
+    void GameLauncher::UpdatePersistence()
+    {
+        uint32_t due = m_persistence.TakeDue();
+        if (due & PersistConfig)
+            SaveConfig();
+        if (due & PersistLibrary)
+            SaveDatabase();
+        if (due & PersistIcons)
+            SaveIcons();
+        if (due & PersistFingerprints)
+            SaveFingerprints();
+
+        if (m_journalFailed.exchange(false))
+            CompactDatabase();
+    }
+
+    // <-- Window Layout -->
+    void GameLauncher::ApplyWindowLayout()
+    {
+        SDL_Window *window = SDL_GL_GetCurrentWindow();
+        if (!window || m_configWindowWidth < 640 || m_configWindowHeight < 480)
+            return;
+
+        SDL_SetWindowSize(window, m_configWindowWidth, m_configWindowHeight);
+        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
+    }
+
+    // Polls the window and sidebar size (no I/O) and schedules a save when they change
+    void GameLauncher::TrackWindowLayout(float sidebarWidth)
+    {
+        SDL_Window *window = SDL_GL_GetCurrentWindow();
+        if (!window)
+            return;
+
+        // Only remember the restored size
+        if (SDL_GetWindowFlags(window) & (SDL_WINDOW_MAXIMIZED | SDL_WINDOW_MINIMIZED))
+            return;
+
+        int w = 0, h = 0;
+        SDL_GetWindowSize(window, &w, &h);
+
+        bool changed = false;
+        if (w != m_configWindowWidth || h != m_configWindowHeight)
+        {
+            m_configWindowWidth = w;
+            m_configWindowHeight = h;
+            changed = true;
+        }
+        if (std::fabs(sidebarWidth - m_configSidebarWidth) >= 1.0f)
+        {
+            m_configSidebarWidth = sidebarWidth;
+            changed = true;
+        }
+
+        if (changed)
+            RequestSave(PersistConfig);
+    }
+
+    // Flushes pending per-entry mutations to the journal; the full library is
+    // only rewritten when the journal grows past JOURNAL_COMPACT_BYTES.
+    void GameLauncher::SaveDatabase()
+    {
+        if (m_pendingMutations.empty())
+            return;
+
+        // Materialise only the entries being journaled
+        std::vector<GameEntry> changed;
+        changed.reserve(m_pendingMutations.size());
+
+        std::vector<JournalMutation> mutations;
+        mutations.reserve(m_pendingMutations.size());
+        for (const auto &pending : m_pendingMutations)
+        {
+            JournalMutation m = {pending.second, pending.first, nullptr};
+            if (m.op != JournalOp::Delete)
+            {
+                size_t idx = m_library.IndexOf(pending.first);
+                if (idx == GameLibrary::npos)
+                    continue;
+                changed.push_back(m_library.Get(idx));
+                m.game = &changed.back();
+            }
+            mutations.push_back(m);
+        }
+        m_pendingMutations.clear();
+
+        std::string encoded = LibraryJournal::Encode(mutations);
+        m_journalBytes += encoded.size();
+
+        if (m_journalBytes > JOURNAL_COMPACT_BYTES)
+        {
+            CompactDatabase();
+            return;
+        }
+
+        m_persistence.Submit([this, encoded = std::move(encoded)]
+                             {
+            if (!LibraryJournal::Append(JOURNAL_FILE, encoded))
+            {
+                SDL_Log("Failed to append to %s, rewriting library instead.", JOURNAL_FILE);
+                m_journalFailed = true;
+            } });
+    }
+
+    // Rewrites games.bin from memory and starts a fresh journal
+    void GameLauncher::CompactDatabase()
+    {
+        m_pendingMutations.clear();
+        m_journalBytes = 0;
+
+        // Windows can't rename over a file that is still mapped
+        m_library.ReleaseMapping();
+
+        std::string contents = LibraryFile::Serialize(m_library.Size(), [this](size_t idx, GameEntry &out)
+                                                      { out = m_library.Get(idx); });
+        m_library.Repack();
+
+        m_persistence.Submit([contents = std::move(contents)]
+                             {
+            if (!PersistenceWorker::WriteFileAtomic(LIBRARY_FILE, contents))
+            {
+                SDL_Log("Failed to write %s", LIBRARY_FILE);
+                return;
+            }
+            LibraryJournal::Reset(JOURNAL_FILE); });
+    }
+
+    void GameLauncher::LoadDatabase()
+    {
+        m_library.Clear();
+        m_pendingMutations.clear();
+        m_selectedGame = GameEntry();
+
+        auto startTime = std::chrono::steady_clock::now();
+        if (m_library.Open(LIBRARY_FILE))
+        {
+            // Only names and flags are read here; paths and descriptions wait until an entry is opened
+            bool needsIds = (m_library.MappedVersion() < 2);
+
+            int replayed = m_library.ReplayJournal(JOURNAL_FILE);
+            std::error_code ec;
+            m_journalBytes = replayed > 0 ? fs::file_size(JOURNAL_FILE, ec) : 0;
 
-        std::string baseName = folderID;
-        auto it = idToName.find(folderID);
-        if (it != idToName.end())
-            baseName = it->second;
+            // Version 1 libraries predate ids; assign them and persist right away
+            if (needsIds)
+            {
+                for (size_t i = 0; i < m_library.Size(); ++i)
+                {
+                    if (m_library.Id(i) == 0)
+                        m_library.SetId(i, NewGameId());
+                }
+            }
+
+            SortLibrary();
+            ReindexSearch();
 
-        std::string extraInfo = "";
-        std::string langSuffix = "";
+            m_libraryMemory = m_library.Memory();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            SDL_Log("Loaded %d games from %s in %.1f ms; %.1f MB in memory (%.1f MB as plain entries).",
+                    (int)m_library.Size(), LIBRARY_FILE, seconds * 1000.0,
+                    m_libraryMemory.Total() / 1048576.0, m_libraryMemory.expandedBytes / 1048576.0);
 
-        // Default to DOS unless detected otherwise
-        outPlatform = GamePlatform::DOS;
+            if (needsIds || m_journalBytes > JOURNAL_COMPACT_BYTES)
+                CompactDatabase();
+            return;
+        }
+
+        // First run: migrate the text database into the binary library
+        std::vector<GameEntry> imported;
+        if (fs::exists(TEXT_DATABASE_FILE) && ImportTextDatabase(TEXT_DATABASE_FILE, imported))
+        {
+            m_library.Reserve(imported.size());
+            for (auto &g : imported)
+            {
+                g.id = NewGameId();
+                m_library.Append(g);
+            }
+
+            SortLibrary();
+            ReindexSearch();
+            CompactDatabase();
+            SDL_Log("Migrated %d games from %s to %s.", (int)m_library.Size(), TEXT_DATABASE_FILE, LIBRARY_FILE);
+        }
+    }
+
+    // <-- Library Mutations -->
+    uint64_t GameLauncher::AddGame(GameEntry game)
+    {
+        if (game.id == 0)
+            game.id = NewGameId();
+
+        uint64_t id = game.id;
+        size_t idx = m_library.InsertSorted(game);
+        MarkGameDirty(id, JournalOp::Add);
+        m_search.Upsert(id, m_library.SearchText(idx));
+        return id;
+    }
 
-        // Normalize versionID for easier searching (make lowercase)
-        std::string vID = versionID;
-        std::transform(vID.begin(), vID.end(), vID.begin(), ::tolower);
+    void GameLauncher::RemoveGame(uint64_t id)
+    {
+        size_t idx = m_library.IndexOf(id);
+        if (idx == GameLibrary::npos)
+            return;
 
-        // <-- Detect Platform -->
+        MarkGameDirty(id, JournalOp::Delete);
+        m_library.Remove(idx);
+        m_search.Remove(id);
 
-        if (vID.find("win") != std::string::npos)
+        // Whoever removed it (the Delete button, the DREAMM watcher), nothing may act on it any more
+        if (id == m_selectedGameId)
         {
-            outPlatform = GamePlatform::Windows;
-            extraInfo += " (Windows)";
+            m_selectedGameId = 0;
+            m_selectedGame = GameEntry();
+            m_storedSelectedGame = GameEntry();
         }
-        else if (vID.find("fmtowns") != std::string::npos || vID.find("fm-towns") != std::string::npos)
+    }
+
+    void GameLauncher::MarkGameDirty(uint64_t id, JournalOp op)
+    {
+        auto it = m_pendingMutations.find(id);
+        if (it == m_pendingMutations.end())
         {
-            outPlatform = GamePlatform::DreammNative;
-            extraInfo += " (FM Towns)";
+            m_pendingMutations.emplace(id, op);
+            return;
         }
-        else if (vID.find("mac") != std::string::npos)
+
+        if (op == JournalOp::Delete)
         {
-            outPlatform = GamePlatform::DreammNative;
-            extraInfo += " (Mac)";
+            // Added and removed before ever reaching disk
+            if (it->second == JournalOp::Add)
+                m_pendingMutations.erase(it);
+            else
+                it->second = JournalOp::Delete;
         }
-        else if (vID.find("dos") != std::string::npos)
+        else if (it->second != JournalOp::Add)
         {
-            outPlatform = GamePlatform::DOS;
-            extraInfo += " (DOS)";
+            it->second = op;
         }
+    }
+
+    // Adds a batch of games with a single sort of the batch and one linear merge
+    void GameLauncher::MergeNewGames(std::vector<GameEntry> incoming)
+    {
+        if (incoming.empty())
+            return;
 
-        // <-- Detect Demo -->
-        if (vID.find("demo") != std::string::npos)
+        for (auto &g : incoming)
         {
-            extraInfo += " (Demo)";
+            if (g.id == 0)
+                g.id = NewGameId();
+            MarkGameDirty(g.id, JournalOp::Add);
         }
 
-        // <-- Detect Language -->
-        // Using a simple list to iterate cleaner
-        static const std::vector<std::pair<std::string, std::string>> languages = {
-            {"-de", " - DE"},
-            {"-fr", " - FR"},
-            {"-es", " - ES"},
-            {"-it", " - IT"},
-            {"-jp", " - JP"},
-            {"-pt", " - PT"},
-            {"-br", " - BR"},
-            {"-kr", " - KR"},
-            {"-zh", " - ZH"},
-            {"-tw", " - TW"}};
+        if (!m_library.IsSortedByName())
+            m_library.SortByName();
+        std::stable_sort(incoming.begin(), incoming.end(), GameNameLess);
 
-        for (const auto &lang : languages)
-        {
-            if (vID.find(lang.first) != std::string::npos)
-            {
-                langSuffix = lang.second;
-                break; // Stop after first match
-            }
-        }
+        size_t first = m_library.Size();
+        m_library.Reserve(first + incoming.size());
+        for (const auto &g : incoming)
+            m_library.Append(g);
+        m_library.MergeSortedTail(first);
 
-        // Combine: Name + (Platform/Demo) + Language
-        return baseName + extraInfo + langSuffix;
+        for (const auto &g : incoming)
+            m_search.Upsert(g.id, m_library.SearchText(m_library.IndexOf(g.id)));
     }
 
-    // <-- Helper: Sort Library -->
-    void GameLauncher::SortLibrary()
+    // Hands the whole library to the search thread; SearchText reads lazy entries
+    // straight from games.bin, so this doesn't decode anything
+    void GameLauncher::ReindexSearch()
     {
-        if (m_games.empty())
-            return;
+        std::vector<LibrarySearch::Document> docs;
+        docs.reserve(m_library.Size());
+        for (size_t i = 0; i < m_library.Size(); ++i)
+            docs.emplace_back(m_library.Id(i), m_library.SearchText(i));
+        m_search.Reset(std::move(docs));
+    }
 
-        std::string selectedName = "";
-        if (m_selectedGameIdx >= 0 && m_selectedGameIdx < (int)m_games.size())
-        {
-            selectedName = m_games[m_selectedGameIdx].name;
-        }
+    // <-- Selection -->
+    GameEntry *GameLauncher::SelectedGame()
+    {
+        if (m_selectedGameId == 0)
+            return nullptr;
 
-        std::sort(m_games.begin(), m_games.end(), [](const GameEntry &a, const GameEntry &b)
-                  {
-        std::string s1 = a.name;
-        std::string s2 = b.name;
-        std::transform(s1.begin(), s1.end(), s1.begin(), ::tolower);
-        std::transform(s2.begin(), s2.end(), s2.begin(), ::tolower);
-        return s1 < s2; });
+        // Even a copy already materialised is only handed out while its game exists
+        size_t idx = m_library.IndexOf(m_selectedGameId);
+        if (idx == GameLibrary::npos)
+            return nullptr;
 
-        m_selectedGameIdx = -1;
-        if (!selectedName.empty())
+        if (m_selectedGame.id != m_selectedGameId)
         {
-            for (size_t i = 0; i < m_games.size(); ++i)
-            {
-                if (m_games[i].name == selectedName)
-                {
-                    m_selectedGameIdx = (int)i;
-                    m_autoScrollFrames = 3;
-                    break;
-                }
-            }
+            m_selectedGame = m_library.Get(idx);
+            m_storedSelectedGame = m_selectedGame;
         }
+        return &m_selectedGame;
     }
 
-    // <-- Persistence -->
-    void GameLauncher::LoadConfig()
+    // Writes edits made to the materialised copy back into the library. Called
+    // every frame while editing, so unchanged values cost one comparison and
+    // never re-intern strings or rebuild the search text
+    void GameLauncher::StoreSelectedGame()
     {
-        std::ifstream file("launcher_config.txt");
-        if (!file.is_open())
-        {
-            UI::ThemeManager::ApplyTheme((UI::AppTheme)m_configTheme);
+        if (m_selectedGameId == 0 || m_selectedGame.id != m_selectedGameId || m_selectedGame == m_storedSelectedGame)
             return;
-        }
 
-        std::string line;
+        size_t idx = m_library.IndexOf(m_selectedGameId);
+        if (idx == GameLibrary::npos)
+            return;
 
-        // Settings
-        if (std::getline(file, line))
-        {
-            std::stringstream ss(line);
-            std::string segment;
-            std::vector<std::string> seglist;
+        // A rename moves just this entry; no-op otherwise
+        m_library.Set(idx, m_selectedGame);
+        idx = m_library.Reposition(idx);
+        m_storedSelectedGame = m_selectedGame;
 
-            while (std::getline(ss, segment, '|'))
-            {
-                seglist.push_back(segment);
-            }
+        // Only wake the search thread when the searchable text changed
+        std::string text = m_library.SearchText(idx);
+        if (text != m_indexedSelectedText)
+        {
+            m_indexedSelectedText = text;
+            m_search.Upsert(m_selectedGameId, std::move(text));
+        }
+    }
 
-            if (seglist.size() >= 3)
-            {
-                m_configEnableBackground = (seglist[0] == "1");
-                m_configMouseWarp = (seglist[1] == "1");
-                try
-                {
-                    m_configTheme = std::stoi(seglist[2]);
-                }
-                catch (...)
-                {
-                    m_configTheme = 0;
-                }
-            }
+    // <-- Text Import / Export (games.db) -->
+    void GameLauncher::ImportLibrary()
+    {
+        const char *fileName = EXCHANGE_FILES[m_exchangeFormat];
+        auto startTime = std::chrono::steady_clock::now();
 
-            // Check if path is on Line 1 (Format: 1|1|5|C:\Path)
-            if (seglist.size() >= 4)
-            {
-                m_dreammExePath = seglist[3];
-            }
+        // Dedupe on name + exe + install path, against the library and within the file
+        std::string key;
+        auto makeKey = [&key](std::string_view name, std::string_view exePath, std::string_view installPath)
+        {
+            key.assign(name);
+            key += '\x1f';
+            key += exePath;
+            key += '\x1f';
+            key += installPath;
+        };
+
+        // Library rows are read in place, so lazy entries stay unloaded
+        std::unordered_set<std::string> known;
+        known.reserve(m_library.Size());
+        std::string exePath, installPath;
+        for (size_t i = 0; i < m_library.Size(); ++i)
+        {
+            m_library.PeekPath(i, GamePath::Exe, exePath);
+            m_library.PeekPath(i, GamePath::Install, installPath);
+            makeKey(m_library.Name(i), exePath, installPath);
+            known.insert(key);
         }
 
-        // --- Path (Fallback) ---
-        // If the path wasn't on line 1, checking if it's on line 2 (Format: 1|1|5 \n C:\Path)
-        if (m_dreammExePath.empty() && std::getline(file, line))
+        std::vector<GameEntry> accepted;
+        auto acceptBatch = [&](std::vector<GameEntry> &batch)
         {
-            if (!line.empty())
+            for (auto &g : batch)
             {
-                m_dreammExePath = line;
+                makeKey(g.name, g.exePath, g.installPath);
+                if (!known.insert(key).second)
+                    continue;
+                g.id = 0;
+                accepted.push_back(std::move(g));
             }
+        };
+
+        bool opened = false;
+        if (m_exchangeFormat == 0)
+        {
+            std::vector<GameEntry> imported;
+            opened = ImportTextDatabase(fileName, imported);
+            acceptBatch(imported);
+        }
+        else
+        {
+            ExchangeFormat format = (m_exchangeFormat == 1) ? ExchangeFormat::Csv : ExchangeFormat::JsonLines;
+            LibraryExchange::ImportStats stats;
+            opened = LibraryExchange::Import(fileName, format, acceptBatch, &stats);
+            if (stats.skipped > 0)
+                SDL_Log("%s: skipped %d malformed records.", fileName, stats.skipped);
         }
 
-        // Cleanup
-        while (!m_dreammExePath.empty() &&
-               (m_dreammExePath.back() == '\n' || m_dreammExePath.back() == '\r' || m_dreammExePath.back() == ' '))
+        if (!opened)
         {
-            m_dreammExePath.pop_back();
+            SDL_Log("Could not open %s for import.", fileName);
+            return;
         }
 
-        file.close();
+        // One sort for the whole import
+        int added = (int)accepted.size();
+        MergeNewGames(std::move(accepted));
+        if (added > 0)
+            SaveDatabase();
 
-        // Apply Theme
-        UI::ThemeManager::ApplyTheme((UI::AppTheme)m_configTheme);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        SDL_Log("Imported %d games from %s in %.1f ms.", added, fileName, seconds * 1000.0);
     }
 
-    void GameLauncher::SaveConfig()
+    void GameLauncher::ExportLibrary()
     {
-        std::ofstream file("launcher_config.txt");
-        if (file.is_open())
+        const char *fileName = EXCHANGE_FILES[m_exchangeFormat];
+        int count = (int)m_library.Size();
+        if (m_export.active)
         {
-            file << (m_configEnableBackground ? "1" : "0") << "|"
-                 << (m_configMouseWarp ? "1" : "0") << "|"
-                 << m_configTheme << "\n"
-                 << m_dreammExePath;
+            SDL_Log("Still writing %s; export skipped.", m_export.fileName);
+            return;
+        }
+
+        if (m_exchangeFormat == 0)
+        {
+            m_persistence.Submit([contents = BuildTextDatabase(), fileName, count]
+                                 {
+                if (PersistenceWorker::WriteFileAtomic(fileName, contents))
+                    SDL_Log("Exported %d games to %s.", count, fileName); });
+            return;
         }
+
+        // UpdateExport writes the rows from here on, a batch per frame
+        m_export = PendingExport();
+        m_export.active = true;
+        m_export.format = (m_exchangeFormat == 1) ? ExchangeFormat::Csv : ExchangeFormat::JsonLines;
+        m_export.fileName = fileName;
+        m_export.ids.reserve(m_library.Size());
+        for (size_t i = 0; i < m_library.Size(); ++i)
+            m_export.ids.push_back(m_library.Id(i));
+        m_export.file = std::make_shared<std::ofstream>();
+
+        std::string header;
+        LibraryExchange::AppendHeader(header, m_export.format);
+        m_persistence.Submit([file = m_export.file, fileName, header = std::move(header)]
+                             {
+            file->open(PersistenceWorker::TempPathFor(fileName), std::ios::binary | std::ios::trunc);
+            file->write(header.data(), header.size()); });
     }
 
-    void GameLauncher::SaveDatabase()
+    void GameLauncher::UpdateExport()
     {
-        std::ofstream file("games.db");
-        if (!file.is_open())
+        if (!m_export.active)
+            return;
+
+        // Games removed since the export started are left out
+        std::string batch;
+        size_t end = std::min(m_export.ids.size(), m_export.next + LibraryExchange::BATCH_SIZE);
+        for (; m_export.next < end; ++m_export.next)
+        {
+            size_t idx = m_library.IndexOf(m_export.ids[m_export.next]);
+            if (idx == GameLibrary::npos)
+                continue;
+            m_library.Peek(idx, m_export.row);
+            LibraryExchange::AppendRecord(batch, m_export.format, m_export.row);
+            m_export.written++;
+        }
+        m_persistence.Submit([file = m_export.file, batch = std::move(batch)]
+                             {
+            if (file->is_open())
+                file->write(batch.data(), batch.size()); });
+
+        if (m_export.next < m_export.ids.size())
             return;
 
-        for (const auto &game : m_games)
+        m_persistence.Submit([file = m_export.file, fileName = m_export.fileName, count = m_export.written]
+                             {
+            if (!file->is_open())
+            {
+                SDL_Log("Could not open %s for export.", fileName);
+                return;
+            }
+            file->flush();
+            bool written = file->good();
+            file->close();
+            if (written && PersistenceWorker::ReplaceFile(PersistenceWorker::TempPathFor(fileName), fileName))
+                SDL_Log("Exported %d games to %s.", count, fileName); });
+        m_export = PendingExport();
+    }
+
+    std::string GameLauncher::BuildTextDatabase()
+    {
+        std::string file;
+        file.reserve(m_library.Size() * 160);
+
+        auto field = [&file](const std::string &text)
         {
+            AppendEscapedField(file, text);
+            file += '|';
+        };
+        auto number = [&file](int value)
+        {
+            file += std::to_string(value);
+            file += '|';
+        };
+
+        for (size_t idx = 0; idx < m_library.Size(); ++idx)
+        {
+            const GameEntry game = m_library.Get(idx);
+
             int audioMask = 0;
             for (int i = 0; i < 6; i++)
             {
@@ -681,165 +1524,116 @@ namespace Core
                     audioMask |= (1 << i);
             }
 
-            file << game.name << "|"
-                 << (int)game.platform << "|"
-                 << (int)game.status << "|"
-                 << game.exePath << "|"
-                 << game.setupPath << "|"
-                 << game.installPath << "|"
-                 << (game.forceWindowed ? "1" : "0") << "|"
-                 << (game.forceMaximized ? "1" : "0") << "|"
-                 << (game.forceFullscreen ? "1" : "0") << "|"
-                 << (int)game.machine << "|"
-                 << game.ramKB << "|"
-                 << audioMask << "|"
-                 << game.videoHwIdx << "|"
-                 << game.width << "|"
-                 << game.height << "|"
-                 << game.depth << "|"
-                 << game.mips << "|"
-                 << game.isoPath << "|"
-                 << game.description << "\n";
-        }
-        file.close();
+            field(game.name);
+            number((int)game.platform);
+            number((int)game.status);
+            field(game.exePath);
+            field(game.setupPath);
+            field(game.installPath);
+            number(game.forceWindowed ? 1 : 0);
+            number(game.forceMaximized ? 1 : 0);
+            number(game.forceFullscreen ? 1 : 0);
+            number((int)game.machine);
+            number(game.ramKB);
+            number(audioMask);
+            number(game.videoHwIdx);
+            number(game.width);
+            number(game.height);
+            number(game.depth);
+            number(game.mips);
+            field(game.isoPath);
+            field(game.description);
+            AppendEscapedField(file, JoinTags(game.tags, "; "));
+            file += '\n';
+        }
+        return file;
     }
 
-    void GameLauncher::LoadDatabase()
+    // Parses one games.db row; returns false for rows with no usable fields
+    static bool ParseTextDatabaseRow(std::string_view line, GameEntry &g, uint32_t &errorMask)
     {
-        std::ifstream file("games.db");
-        if (!file.is_open())
-            return;
+        FieldTokenizer fields(line);
+        if (fields.Field(0).empty() && fields.Count() <= 1)
+            return false;
+
+        AssignUnescapedField(g.name, fields.Field(0));
+        fields.Int(1, g.platform);
+        fields.Int(2, g.status);
+        AssignUnescapedField(g.exePath, fields.Field(3));
+        AssignUnescapedField(g.setupPath, fields.Field(4));
+        AssignUnescapedField(g.installPath, fields.Field(5));
+        fields.Flag(6, g.forceWindowed);
+        fields.Flag(7, g.forceMaximized);
+        fields.Flag(8, g.forceFullscreen);
+        fields.Int(9, g.machine);
+        fields.Int(10, g.ramKB);
+
+        int audioMask = 0;
+        if (fields.Has(11))
+        {
+            fields.Int(11, audioMask);
+            for (int i = 0; i < 6; i++)
+                g.audioFlags[i] = (audioMask & (1 << i)) != 0;
+        }
 
-        m_games.clear();
-        std::string line;
-        while (std::getline(file, line))
+        fields.Int(12, g.videoHwIdx);
+        fields.Int(13, g.width);
+        fields.Int(14, g.height);
+        fields.Int(15, g.depth);
+        fields.Int(16, g.mips);
+        AssignUnescapedField(g.isoPath, fields.Field(17));
+        AssignUnescapedField(g.description, fields.Field(18));
+        if (fields.Has(19))
         {
-            if (line.empty())
-                continue;
+            std::string tags;
+            AssignUnescapedField(tags, fields.Field(19));
+            g.tags = SplitTags(tags);
+        }
 
-            std::vector<std::string> parts;
-            size_t start = 0, end = line.find('|');
-            while (end != std::string::npos)
-            {
-                parts.push_back(line.substr(start, end - start));
-                start = end + 1;
-                end = line.find('|', start);
-            }
-            parts.push_back(line.substr(start));
+        if (g.videoHwIdx < 0 || g.videoHwIdx >= 6)
+            g.videoHwIdx = 5;
+
+        errorMask = fields.ErrorMask();
+        return true;
+    }
+
+    bool GameLauncher::ImportTextDatabase(const fs::path &path, std::vector<GameEntry> &outGames)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+            return false;
+
+        auto startTime = std::chrono::steady_clock::now();
+        TextLineReader reader(std::string_view(reinterpret_cast<const char *>(file.Data()), file.Size()));
 
-            if (parts.empty())
+        std::string_view line;
+        int rows = 0;
+        int badRows = 0;
+        while (reader.Next(line))
+        {
+            if (line.empty())
                 continue;
 
             GameEntry g;
-            if (parts.size() > 0)
-                g.name = parts[0];
-            if (parts.size() > 1)
-                try
-                {
-                    g.platform = (GamePlatform)std::stoi(parts[1]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 2)
-                try
-                {
-                    g.status = (GameStatus)std::stoi(parts[2]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 3)
-                g.exePath = parts[3];
-            if (parts.size() > 4)
-                g.setupPath = parts[4];
-            if (parts.size() > 5)
-                g.installPath = parts[5];
-            if (parts.size() > 6)
-                g.forceWindowed = (parts[6] == "1");
-            if (parts.size() > 7)
-                g.forceMaximized = (parts[7] == "1");
-            if (parts.size() > 8)
-                g.forceFullscreen = (parts[8] == "1");
-            if (parts.size() > 9)
-                try
-                {
-                    g.machine = (MachineType)std::stoi(parts[9]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 10)
-                try
-                {
-                    g.ramKB = std::stoi(parts[10]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 11)
+            uint32_t errorMask = 0;
+            if (!ParseTextDatabaseRow(line, g, errorMask))
+                continue;
+
+            if (errorMask != 0)
             {
-                int audioMask = 0;
-                try
-                {
-                    audioMask = std::stoi(parts[11]);
-                }
-                catch (...)
-                {
-                }
-                for (int i = 0; i < 6; i++)
-                    g.audioFlags[i] = (audioMask & (1 << i)) != 0;
+                // Malformed numbers keep their defaults; only the first few get logged
+                if (badRows++ < 10)
+                    SDL_Log("%s line %d: bad numeric fields (mask 0x%x), using defaults.", path.string().c_str(), reader.LineNumber(), errorMask);
             }
-            if (parts.size() > 12)
-                try
-                {
-                    g.videoHwIdx = std::stoi(parts[12]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 13)
-                try
-                {
-                    g.width = std::stoi(parts[13]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 14)
-                try
-                {
-                    g.height = std::stoi(parts[14]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 15)
-                try
-                {
-                    g.depth = std::stoi(parts[15]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 16)
-                try
-                {
-                    g.mips = std::stoi(parts[16]);
-                }
-                catch (...)
-                {
-                }
-            if (parts.size() > 17)
-                g.isoPath = parts[17];
 
-            if (parts.size() > 18)
-                g.description = parts[18];
-
-            m_games.push_back(g);
+            outGames.push_back(std::move(g));
+            rows++;
         }
-        file.close();
-        SortLibrary();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        SDL_Log("Parsed %d rows from %s in %.1f ms (%.0f rows/s, %d with bad fields).",
+                rows, path.string().c_str(), seconds * 1000.0, seconds > 0.0 ? rows / seconds : 0.0, badRows);
+        return true;
     }
 
     // <-- Launch Logic -->
@@ -1320,61 +2114,335 @@ namespace Core
                                         // Reset scroll target (we are going deeper, start at top)
                                         m_autoScrollTarget.clear();
 
-                                        m_browserEntries.clear();
-                                        m_loadingFuture = std::async(std::launch::async, ScanDirectoryAsync, m_browserCurrentPath, m_fileBrowserExtensions);
+                                        m_browserEntries.clear();
+                                        m_loadingFuture = std::async(std::launch::async, ScanDirectoryAsync, m_browserCurrentPath, m_fileBrowserExtensions);
+
+                                        ImGui::PopStyleColor();
+                                        ImGui::EndChild();
+                                        ImGui::EndPopup();
+                                        return;
+                                    }
+                                }
+                            }
+                            ImGui::PopStyleColor();
+                        }
+                        else
+                        {
+                            if (ImGui::Selectable(entry.name.c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
+                            {
+                                if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0))
+                                {
+                                    if (m_fileBrowserTarget)
+                                    {
+                                        *m_fileBrowserTarget = entry.fullPath.string();
+                                        if (m_fileBrowserTarget == &m_selectedGame.exePath)
+                                        {
+                                            bool fresh = (m_selectedGame.name == "New Game");
+                                            if (fresh)
+                                            {
+                                                std::string parentName = entry.fullPath.parent_path().filename().string();
+                                                if (!parentName.empty())
+                                                    m_selectedGame.name = parentName;
+                                            }
+
+                                            ExecutableInfo info;
+                                            if (info.Read(entry.fullPath))
+                                            {
+                                                info.ApplyTo(m_selectedGame, fresh);
+                                                SDL_Log("%s: %s", entry.name.c_str(), info.FormatName());
+                                            }
+
+                                            CatalogueMatch match;
+                                            if (m_catalogue.Identify(entry.fullPath, m_fingerprints, match))
+                                            {
+                                                match.ApplyTo(m_selectedGame, fresh);
+                                                SDL_Log("%s: catalogue entry \"%s\"", entry.name.c_str(), match.title.c_str());
+                                            }
+                                        }
+                                    }
+                                    m_lastGlobalPath = m_browserCurrentPath;
+                                    m_showFileBrowser = false;
+                                    ImGui::CloseCurrentPopup();
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            ImGui::EndChild();
+            if (ImGui::Button("Cancel", ImVec2(120, 0)))
+            {
+                m_showFileBrowser = false;
+                ImGui::CloseCurrentPopup();
+            }
+            ImGui::EndPopup();
+        }
+    }
+
+    // <-- UI Rendering -->
+
+    // <-- Game List Filter -->
+    // Recomputes m_filteredRows only when an input changed. With a query, rows
+    // are ranked fuzzy name matches first (best first), then games whose
+    // description or paths matched the full-text search, in table order. The
+    // full-text query runs on the search thread; until its hits arrive the
+    // previous ones are used, so typing never waits on it.
+    void GameLauncher::UpdateFilteredRows()
+    {
+        // Field clauses are compiled once per edit; only the free text is searched
+        std::string_view text(m_filterName);
+        if (text != m_filteredQuery || m_filterPlatform != m_filteredPlatform || m_filterStatus != m_filteredStatus ||
+            m_filterCollection != m_filteredCollection)
+        {
+            m_filterQuery.Compile(text);
+            if (m_filterPlatform > 0)
+                m_filterQuery.Require(FilterField::Platform, 1u << (m_filterPlatform - 1));
+            if (m_filterStatus > 0)
+                m_filterQuery.Require(FilterField::Status, 1u << (m_filterStatus - 1));
+            if (!m_filterCollection.empty())
+                m_filterQuery.RequireTag(m_filterCollection);
+        }
+
+        const std::string &query = m_filterQuery.FreeText();
+        bool hasQuery = !query.empty();
+
+        // Names are ranked by position on the search thread, so it gets a new list whenever they may have moved
+        if (hasQuery && (!m_searchNames || m_searchNames->revision != m_library.Revision()))
+        {
+            m_searchNames = std::make_shared<const NameList>(NameList::From(m_library));
+            m_search.SetNames(m_searchNames);
+        }
+        if (m_submittedQuery != query)
+        {
+            m_submittedQuery = query;
+            m_search.Query(m_submittedQuery);
+        }
+        m_search.Poll();
+
+        const LibrarySearch::Results &hits = m_search.Current();
+        uint64_t searchGeneration = (hasQuery && !hits.query.empty()) ? hits.generation : 0;
+
+        if (m_library.Revision() == m_filteredRevision &&
+            m_filterPlatform == m_filteredPlatform &&
+            m_filterStatus == m_filteredStatus &&
+            m_filterCollection == m_filteredCollection &&
+            m_sortColumn == m_filteredColumn &&
+            m_sortDescending == m_filteredDescending &&
+            searchGeneration == m_filteredSearchGeneration &&
+            text == m_filteredQuery)
+            return;
+
+        m_filteredQuery.assign(text);
+        m_filteredSearchGeneration = searchGeneration;
+        m_filteredPlatform = m_filterPlatform;
+        m_filteredStatus = m_filterStatus;
+        m_filteredCollection = m_filterCollection;
+        m_filteredColumn = m_sortColumn;
+        m_filteredDescending = m_sortDescending;
+        m_filteredRevision = m_library.Revision();
+        m_filteredStamp++;
+
+        // Field clauses resolve to one row set up front (bitmap And/Or), so walking
+        // the order below is a membership test per row
+        bool restricted = m_filterQuery.HasTests() || m_filterQuery.Never();
+        if (restricted)
+            m_filterQuery.Select(m_library, m_filteredAllowed);
+        auto allowed = [&](uint32_t idx)
+        { return !restricted || m_filteredAllowed.Contains(idx); };
+
+        const std::vector<uint32_t> &order = m_library.Order(m_sortColumn);
+        m_filteredRows.clear();
+        m_filteredRows.reserve(restricted ? m_filteredAllowed.Count() : order.size());
+
+        if (!hasQuery)
+        {
+            for (size_t row = 0; row < order.size(); ++row)
+            {
+                uint32_t idx = order[m_sortDescending ? order.size() - 1 - row : row];
+                if (allowed(idx))
+                    m_filteredRows.push_back(idx);
+            }
+            return;
+        }
+
+        // The search thread's answer, once it is for this query and these positions
+        bool answered = hits.query == query && hits.revision == m_library.Revision();
+
+        // Ranked name matches; until answered, just the first few candidates ranked here
+        m_filteredListed.assign(m_library.Size(), 0);
+        const std::vector<FuzzyMatch> &ranked = answered ? hits.ranked : m_fuzzy.Rank(*m_searchNames, query, INTERIM_RANKED_NAMES);
+        for (const FuzzyMatch &match : ranked)
+        {
+            m_filteredListed[match.idx] = 1;
+            if (allowed(match.idx))
+                m_filteredRows.push_back(match.idx);
+        }
+
+        // Then description & path hits not already listed. Earlier hits only stand
+        // in for a query that narrows theirs, and each is checked against this one
+        bool narrowed = !answered && !hits.query.empty() && query.find(hits.query) != std::string::npos;
+        if (searchGeneration == 0 || hits.ids.empty() || !(answered || narrowed))
+            return;
+
+        if (narrowed)
+            TrigramIndex::Fold(query, m_foldedQuery);
+        size_t rechecked = 0;
+        for (size_t row = 0; row < order.size(); ++row)
+        {
+            uint32_t idx = order[m_sortDescending ? order.size() - 1 - row : row];
+            if (m_filteredListed[idx] || !allowed(idx))
+                continue;
+            if (!std::binary_search(hits.ids.begin(), hits.ids.end(), m_library.Id(idx)))
+                continue;
+            if (narrowed)
+            {
+                if (rechecked++ == INTERIM_RECHECKED_HITS)
+                    break;
+                m_library.PeekSearchText(idx, m_hitText);
+                TrigramIndex::Fold(m_hitText, m_hitText);
+                if (!TrigramIndex::Matches(m_hitText, m_foldedQuery))
+                    continue;
+            }
+            m_filteredRows.push_back(idx);
+        }
+    }
+
+    // <-- Grouped View -->
+    // Folds m_filteredRows under their franchise groups. A group takes the
+    // place of its first filtered member, so the sort column and search ranking
+    // still decide the order; a collapsed group is just its header, and a group
+    // with one passing member is shown as a plain row. Rebuilt only when the
+    // filtered rows change or a group is toggled.
+    void GameLauncher::UpdateTreeRows()
+    {
+        if (m_franchises.Update(m_library))
+            m_treeStamp = 0;
+        if (m_treeStamp == m_filteredStamp)
+            return;
+        m_treeStamp = m_filteredStamp;
+
+        // Counting sort of the filtered rows by group, groups in first-seen order
+        std::vector<uint32_t> groupOrder;
+        m_treeMemberCount.assign(m_franchises.GroupCount(), 0);
+        m_treeMemberStart.assign(m_franchises.GroupCount(), 0);
+        for (uint32_t idx : m_filteredRows)
+        {
+            uint32_t group = m_franchises.GroupOf(idx);
+            if (m_treeMemberCount[group]++ == 0)
+                groupOrder.push_back(group);
+        }
+
+        uint32_t start = 0;
+        for (uint32_t group : groupOrder)
+        {
+            m_treeMemberStart[group] = start;
+            start += m_treeMemberCount[group];
+            m_treeMemberCount[group] = 0;
+        }
+
+        m_treeMembers.resize(m_filteredRows.size());
+        for (uint32_t idx : m_filteredRows)
+        {
+            uint32_t group = m_franchises.GroupOf(idx);
+            m_treeMembers[m_treeMemberStart[group] + m_treeMemberCount[group]++] = idx;
+        }
 
-                                        ImGui::PopStyleColor();
-                                        ImGui::EndChild();
-                                        ImGui::EndPopup();
-                                        return;
-                                    }
-                                }
-                            }
-                            ImGui::PopStyleColor();
-                        }
-                        else
-                        {
-                            if (ImGui::Selectable(entry.name.c_str(), false, ImGuiSelectableFlags_AllowDoubleClick))
-                            {
-                                if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0))
-                                {
-                                    if (m_fileBrowserTarget)
-                                    {
-                                        *m_fileBrowserTarget = entry.fullPath.string();
-                                        if (m_selectedGameIdx >= 0 && m_selectedGameIdx < (int)m_games.size())
-                                        {
-                                            if (m_fileBrowserTarget == &m_games[m_selectedGameIdx].exePath)
-                                            {
-                                                if (m_games[m_selectedGameIdx].name == "New Game")
-                                                {
-                                                    std::string parentName = entry.fullPath.parent_path().filename().string();
-                                                    if (!parentName.empty())
-                                                        m_games[m_selectedGameIdx].name = parentName;
-                                                }
-                                            }
-                                        }
-                                    }
-                                    m_lastGlobalPath = m_browserCurrentPath;
-                                    m_showFileBrowser = false;
-                                    ImGui::CloseCurrentPopup();
-                                }
-                            }
-                        }
-                    }
-                }
+        m_treeRows.clear();
+        m_treeRows.reserve(groupOrder.size());
+        for (uint32_t group : groupOrder)
+        {
+            uint32_t count = m_treeMemberCount[group];
+            const uint32_t *members = m_treeMembers.data() + m_treeMemberStart[group];
+            if (count == 1)
+            {
+                m_treeRows.push_back(TreeRow{group, (int32_t)members[0]});
+                continue;
             }
 
-            ImGui::EndChild();
-            if (ImGui::Button("Cancel", ImVec2(120, 0)))
+            m_treeRows.push_back(TreeRow{group, -1});
+            if (m_expandedGroups.count(m_franchises.Group(group).key))
             {
-                m_showFileBrowser = false;
-                ImGui::CloseCurrentPopup();
+                for (uint32_t k = 0; k < count; ++k)
+                    m_treeRows.push_back(TreeRow{group, (int32_t)members[k]});
             }
-            ImGui::EndPopup();
         }
     }
 
-    // <-- UI Rendering -->
+    // One library row: name (selectable across the row), platform, status, RAM and MIPS
+    void GameLauncher::RenderGameRow(uint32_t i, bool indent)
+    {
+        const GameListItem &item = m_library.Item(i);
+
+        bool isPlayable = (item.status == (uint8_t)GameStatus::Playable);
+        if (!isPlayable)
+            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.6f, 0.6f, 1.0f));
+
+        uint64_t id = m_library.Id(i);
+        bool isSelected = (id == m_selectedGameId);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+
+        // Variants line up with their group's title
+        if (indent)
+            ImGui::Indent(ImGui::GetTreeNodeToLabelSpacing());
+
+        // Icon slot ahead of the name; the Selectable still spans the row
+        ImVec2 iconPos = ImGui::GetCursorScreenPos();
+        float iconSize = ImGui::GetTextLineHeight();
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + iconSize + ImGui::GetStyle().ItemInnerSpacing.x);
+
+        // Selectable Item (keyed by game id, so no per-row label string)
+        ImGui::PushID((int)(id ^ (id >> 32)));
+        if (ImGui::Selectable(m_library.NameCStr(i), isSelected, ImGuiSelectableFlags_AllowDoubleClick | ImGuiSelectableFlags_SpanAllColumns))
+        {
+            m_selectedGameId = id;
+            if (ImGui::IsMouseDoubleClicked(0))
+            {
+                const GameEntry *g = SelectedGame();
+                if (g && (!g->exePath.empty() || !g->installPath.empty()))
+                    LaunchGame(*g, false);
+            }
+        }
+
+        // Drawn over the Selectable's highlight; faded like the text when unplayable
+        IconRef icon;
+        if (m_icons.Lookup(m_library, i, icon))
+        {
+            ImGui::GetWindowDrawList()->AddImage(icon.texture, iconPos, ImVec2(iconPos.x + iconSize, iconPos.y + iconSize),
+                                                 icon.uv0, icon.uv1, isPlayable ? IM_COL32_WHITE : IM_COL32(255, 255, 255, 128));
+        }
+
+        // Run this check if we have pending scroll frames
+        if (m_autoScrollFrames > 0 && isSelected)
+        {
+            ImGui::SetScrollHereY(0.5f);
+            ImGui::SetItemDefaultFocus();
+        }
+
+        if (indent)
+            ImGui::Unindent(ImGui::GetTreeNodeToLabelSpacing());
+
+        if (ImGui::TableNextColumn())
+            ImGui::TextUnformatted(item.platform < IM_ARRAYSIZE(PLATFORM_LABELS) ? PLATFORM_LABELS[item.platform] : "?");
+        if (ImGui::TableNextColumn())
+            ImGui::TextUnformatted(STATUS_LABELS[isPlayable ? 1 : 0]);
+        if (ImGui::TableNextColumn())
+            ImGui::Text("%d KB", m_library.RamKB(i));
+        if (ImGui::TableNextColumn())
+        {
+            int mips = m_library.Mips(i);
+            if (mips > 0)
+                ImGui::Text("%d", mips);
+            else
+                ImGui::TextDisabled("Max");
+        }
+
+        ImGui::PopID();
+        if (!isPlayable)
+            ImGui::PopStyleColor();
+    }
 
     void GameLauncher::RenderGameList()
     {
@@ -1384,86 +2452,225 @@ namespace Core
         ImGui::BeginChild("LeftColumnChild", ImVec2(0, 0), true);
 
         ImGui::TextDisabled("LIBRARY FILTER");
-        ImGui::InputTextWithHint("##filter", "Name search...", m_filterName, 256);
+        ImGui::InputTextWithHint("##filter", "Search, or platform:win ram>=16MB ...", m_filterName, 256);
         if (ImGui::IsItemHovered())
+        {
             ImGui::SetMouseCursor(ImGuiMouseCursor_Arrow);
+            ImGui::SetTooltip("Free text searches names, descriptions and paths.\n"
+                              "Narrow with field:value clauses (prefix with - to negate):\n"
+                              "  platform:dos,win,dreamm   status:playable   machine:tandy\n"
+                              "  videohw:svga  videohw>=vga   ram>=16MB   mips<100");
+        }
+        if (!m_filterQuery.Error().empty())
+            ImGui::TextColored(ImVec4(1, 0.5, 0, 1), "%s", m_filterQuery.Error().c_str());
 
         ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.0f);
 
-        ImGui::Combo("Platform", &m_filterPlatform, "All\0DOS\0Windows\0\0");
+        ImGui::Combo("Platform", &m_filterPlatform, "All\0DOS\0Windows\0DREAMM\0\0");
         ImGui::Combo("Status", &m_filterStatus, "All\0Unplayable\0Playable\0\0");
 
+        // Tags double as collections; picking one also takes in tags nested under it
+        if (ImGui::BeginCombo("Collection", m_filterCollection.empty() ? "All" : m_filterCollection.c_str()))
+        {
+            if (ImGui::Selectable("All", m_filterCollection.empty()))
+                m_filterCollection.clear();
+
+            const LibraryBitmaps &bitmaps = m_library.Bitmaps();
+            for (size_t t = 0; t < bitmaps.tags.size(); ++t)
+            {
+                const std::string &tag = bitmaps.tags[t];
+                std::string label = tag + " (" + std::to_string(bitmaps.tagRows[t].Count()) + ")";
+                ImGui::PushID((int)t);
+                if (ImGui::Selectable(label.c_str(), m_filterCollection == tag))
+                    m_filterCollection = tag;
+                ImGui::PopID();
+            }
+            ImGui::EndCombo();
+        }
+
         ImGui::PopStyleVar();
 
+        ImGui::BeginDisabled(m_configGridView);
+        if (ImGui::Checkbox("Group variants", &m_configGroupedView))
+        {
+            m_autoScrollFrames = 3;
+            RequestSave(PersistConfig);
+        }
+        ImGui::EndDisabled();
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+            ImGui::SetTooltip("Fold versions, platforms, demos and languages of a game under one entry.\n"
+                              "Right-click an entry to pick a variant.");
+
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Covers", &m_configGridView))
+        {
+            m_autoScrollFrames = 3;
+            RequestSave(PersistConfig);
+        }
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Show box art tiles instead of the list.\n"
+                              "Covers come from covers\\<game name>.png (or .jpg) beside the launcher,\n"
+                              "or a cover, boxart, box, front or folder image in the game's folder.");
+
         ImGui::Separator();
 
         // <-- Start List -->
-        ImGui::BeginChild("GameListScroll", ImVec2(0, -40), false);
-
-        for (size_t i = 0; i < m_games.size(); ++i)
+        // Storage stays in name order; other orderings come from cached per-column permutations
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable |
+                                     ImGuiTableFlags_Hideable | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+        if (m_configGridView)
+        {
+            RenderGameGrid();
+        }
+        else if (ImGui::BeginTable("GameListTable", 5, tableFlags, ImVec2(0, -40)))
         {
-            const auto &g = m_games[i];
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_DefaultSort, 0.0f, (ImGuiID)SortColumn::Name);
+            ImGui::TableSetupColumn("Platform", ImGuiTableColumnFlags_WidthFixed, 0.0f, (ImGuiID)SortColumn::Platform);
+            ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultHide, 0.0f, (ImGuiID)SortColumn::Status);
+            ImGui::TableSetupColumn("RAM", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultHide, 0.0f, (ImGuiID)SortColumn::RamKB);
+            ImGui::TableSetupColumn("MIPS", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultHide, 0.0f, (ImGuiID)SortColumn::Mips);
+            ImGui::TableHeadersRow();
 
-            // Filter Logic
-            if (strlen(m_filterName) > 0)
-            {
-                std::string n = g.name;
-                if (n.find(m_filterName) == std::string::npos)
-                    continue;
-            }
-            if (m_filterPlatform > 0)
-            {
-                if (m_filterPlatform == 1 && g.platform != GamePlatform::DOS)
-                    continue;
-                if (m_filterPlatform == 2 && g.platform != GamePlatform::Windows)
-                    continue;
-            }
-            if (m_filterStatus > 0)
+            if (ImGuiTableSortSpecs *sortSpecs = ImGui::TableGetSortSpecs())
             {
-                if (m_filterStatus == 1 && g.status != GameStatus::Unplayable)
-                    continue;
-                if (m_filterStatus == 2 && g.status != GameStatus::Playable)
-                    continue;
+                if (sortSpecs->SpecsDirty)
+                {
+                    if (sortSpecs->SpecsCount > 0)
+                    {
+                        m_sortColumn = (SortColumn)sortSpecs->Specs[0].ColumnUserID;
+                        m_sortDescending = (sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Descending);
+                    }
+                    sortSpecs->SpecsDirty = false;
+                    m_autoScrollFrames = 3; // Keep the selection in view
+                }
             }
 
-            bool isPlayable = (g.status == GameStatus::Playable);
-            if (!isPlayable)
-                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.6f, 0.6f, 1.0f));
+            UpdateFilteredRows();
+            if (m_configGroupedView)
+                UpdateTreeRows();
+            size_t rowCount = m_configGroupedView ? m_treeRows.size() : m_filteredRows.size();
 
-            std::string label = g.name + "##" + std::to_string(i);
+            // The selection's group, for highlighting it on a collapsed header
+            size_t selectedIdx = m_library.IndexOf(m_selectedGameId);
+            uint32_t selectedGroup = (m_configGroupedView && selectedIdx != GameLibrary::npos) ? m_franchises.GroupOf(selectedIdx) : UINT32_MAX;
 
-            // Selectable Item
-            if (ImGui::Selectable(label.c_str(), m_selectedGameIdx == (int)i, ImGuiSelectableFlags_AllowDoubleClick))
+            // Rows are uniform, so the target can be reached even while it's clipped:
+            // jump roughly there, then SetScrollHereY centres it once it is submitted.
+            // In the grouped view a collapsed group's header stands in for its members
+            float rowHeight = ImGui::GetTextLineHeight() + ImGui::GetStyle().CellPadding.y * 2.0f;
+            if (m_autoScrollFrames > 0 && selectedIdx != GameLibrary::npos)
             {
-                m_selectedGameIdx = (int)i;
-                if (ImGui::IsMouseDoubleClicked(0))
+                size_t target = rowCount;
+                for (size_t row = 0; row < rowCount; ++row)
+                {
+                    if (!m_configGroupedView)
+                    {
+                        if (m_filteredRows[row] == selectedIdx)
+                        {
+                            target = row;
+                            break;
+                        }
+                        continue;
+                    }
+                    const TreeRow &tree = m_treeRows[row];
+                    if (tree.idx == (int32_t)selectedIdx)
+                    {
+                        target = row;
+                        break;
+                    }
+                    if (tree.idx < 0 && tree.group == selectedGroup && target == rowCount)
+                        target = row;
+                }
+                if (target < rowCount)
                 {
-                    if (!g.exePath.empty() || !g.installPath.empty())
-                        LaunchGame(g, false);
+                    // + 1 row for the frozen header
+                    float rowCentre = (target + 1.5f) * rowHeight;
+                    ImGui::SetScrollY(rowCentre - ImGui::GetWindowHeight() * 0.5f);
                 }
             }
 
-            // Run this check if we have pending scroll frames
-            if (m_autoScrollFrames > 0 && m_selectedGameIdx == (int)i)
+            // Only the visible rows are submitted; collapsed groups aren't rows at all
+            ImGuiListClipper clipper;
+            clipper.Begin((int)rowCount, rowHeight);
+            while (clipper.Step())
             {
-                ImGui::SetScrollHereY(0.5f);
-                ImGui::SetItemDefaultFocus();
-            }
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    if (!m_configGroupedView)
+                    {
+                        RenderGameRow(m_filteredRows[row], false);
+                        continue;
+                    }
 
-            if (!isPlayable)
-                ImGui::PopStyleColor();
-        }
+                    const TreeRow &tree = m_treeRows[row];
+                    uint32_t memberCount = m_treeMemberCount[tree.group];
+                    if (tree.idx >= 0)
+                    {
+                        RenderGameRow((uint32_t)tree.idx, memberCount > 1);
+                        continue;
+                    }
 
-        // Decrement frame counter (keeps scroll active for 2 frames to catch layout updates)
-        if (m_autoScrollFrames > 0)
-            m_autoScrollFrames--;
+                    const FranchiseGroup &group = m_franchises.Group(tree.group);
+                    const uint32_t *members = m_treeMembers.data() + m_treeMemberStart[tree.group];
+                    bool expanded = m_expandedGroups.count(group.key) != 0;
+                    bool holdsSelection = (tree.group == selectedGroup);
 
-        ImGui::EndChild();
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::PushID(group.key.c_str());
+
+                    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_SpanFullWidth;
+                    if (holdsSelection && !expanded)
+                        flags |= ImGuiTreeNodeFlags_Selected;
+                    ImGui::SetNextItemOpen(expanded);
+                    bool open = ImGui::TreeNodeEx("##group", flags, "%s (%u)", group.title.c_str(), memberCount);
+                    if (open != expanded)
+                    {
+                        if (open)
+                            m_expandedGroups.insert(group.key);
+                        else
+                            m_expandedGroups.erase(group.key);
+                        m_treeStamp = 0; // Rows change from the next frame
+                    }
+
+                    // Pick a variant without expanding the group
+                    if (ImGui::BeginPopupContextItem("##variants"))
+                    {
+                        ImGui::TextDisabled("VARIANTS");
+                        for (uint32_t k = 0; k < memberCount; ++k)
+                        {
+                            ImGui::PushID((int)k);
+                            if (ImGui::Selectable(m_library.NameCStr(members[k]), members[k] == selectedIdx))
+                            {
+                                m_selectedGameId = m_library.Id(members[k]);
+                                m_autoScrollFrames = 3;
+                            }
+                            ImGui::PopID();
+                        }
+                        ImGui::EndPopup();
+                    }
+
+                    if (m_autoScrollFrames > 0 && holdsSelection && !expanded)
+                        ImGui::SetScrollHereY(0.5f);
+
+                    ImGui::PopID();
+                }
+            }
+            clipper.End();
+
+            // Decrement frame counter (keeps scroll active for 2 frames to catch layout updates)
+            if (m_autoScrollFrames > 0)
+                m_autoScrollFrames--;
+
+            ImGui::EndTable();
+        }
 
         float configBtnWidth = 40.0f;
         float spacing = ImGui::GetStyle().ItemSpacing.x;
 
-        float addGameWidth = ImGui::GetContentRegionAvail().x - configBtnWidth - spacing;
+        float findBtnWidth = 60.0f;
+        float addGameWidth = ImGui::GetContentRegionAvail().x - findBtnWidth - configBtnWidth - 2.0f * spacing;
 
         // Add Game Button
         if (ImGui::Button("+ Add Game", ImVec2(addGameWidth, 30)))
@@ -1472,35 +2679,29 @@ namespace Core
             memset(m_filterName, 0, sizeof(m_filterName));
             m_filterPlatform = 0;
             m_filterStatus = 0;
+            m_filterCollection.clear();
 
             // Add the game
             GameEntry g;
             g.name = "New Game";
             g.platform = GamePlatform::DOS;
             g.ramKB = 640;
-            m_games.push_back(g);
-
-            SortLibrary();
-
-            m_selectedGameIdx = -1;
-            for (int i = 0; i < (int)m_games.size(); i++)
-            {
-                if (m_games[i].name == "New Game" && m_games[i].exePath.empty())
-                {
-                    m_selectedGameIdx = i;
-                    break;
-                }
-            }
-
-            if (m_selectedGameIdx == -1)
-                m_selectedGameIdx = (int)m_games.size() - 1;
-
+            m_selectedGameId = AddGame(g);
             m_autoScrollFrames = 3;
             m_showEditWindow = true;
         }
 
         ImGui::SameLine();
 
+        if (ImGui::Button("Find", ImVec2(findBtnWidth, 30)))
+        {
+            m_triggerDiscoveryWindow = true;
+        }
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Find games in your library folders");
+
+        ImGui::SameLine();
+
         if (ImGui::Button(u8"\u2699", ImVec2(configBtnWidth, 30)))
         {
             m_triggerConfigModal = true;
@@ -1513,13 +2714,134 @@ namespace Core
         ImGui::PopStyleVar();
     }
 
+    // Cover tiles for the filtered games, in the list's sort order
+    void GameLauncher::RenderGameGrid()
+    {
+        ImGui::BeginChild("GameGrid", ImVec2(0, -40));
+        UpdateFilteredRows();
+
+        const ImGuiStyle &style = ImGui::GetStyle();
+        const float coverHeight = 160.0f;
+        ImVec2 tileSize(120.0f, coverHeight + ImGui::GetTextLineHeightWithSpacing());
+        int columns = std::max(1, (int)((ImGui::GetContentRegionAvail().x + style.ItemSpacing.x) / (tileSize.x + style.ItemSpacing.x)));
+        int rowCount = (int)((m_filteredRows.size() + columns - 1) / columns);
+        float rowHeight = tileSize.y + style.ItemSpacing.y;
+
+        // Tiles are uniform, so the selection's row can be reached while it's clipped
+        size_t selectedIdx = m_library.IndexOf(m_selectedGameId);
+        if (m_autoScrollFrames > 0 && selectedIdx != GameLibrary::npos)
+        {
+            auto it = std::find(m_filteredRows.begin(), m_filteredRows.end(), (uint32_t)selectedIdx);
+            if (it != m_filteredRows.end())
+            {
+                float rowCentre = ((it - m_filteredRows.begin()) / columns + 0.5f) * rowHeight;
+                ImGui::SetScrollY(rowCentre - ImGui::GetWindowHeight() * 0.5f);
+            }
+        }
+
+        // Only visible tiles ask for covers, so only they get decoded
+        ImGuiListClipper clipper;
+        clipper.Begin(rowCount, rowHeight);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                for (int column = 0; column < columns; ++column)
+                {
+                    size_t k = (size_t)row * columns + column;
+                    if (k >= m_filteredRows.size())
+                        break;
+                    if (column > 0)
+                        ImGui::SameLine();
+                    RenderGameTile(m_filteredRows[k], tileSize, coverHeight);
+                }
+            }
+        }
+        clipper.End();
+
+        if (m_autoScrollFrames > 0)
+            m_autoScrollFrames--;
+
+        ImGui::EndChild();
+    }
+
+    // One grid tile: the cover (or a placeholder) above the name; selects and launches like a row
+    void GameLauncher::RenderGameTile(uint32_t i, const ImVec2 &tileSize, float coverHeight)
+    {
+        const GameListItem &item = m_library.Item(i);
+        bool isPlayable = (item.status == (uint8_t)GameStatus::Playable);
+
+        uint64_t id = m_library.Id(i);
+        bool isSelected = (id == m_selectedGameId);
+
+        ImGui::PushID((int)(id ^ (id >> 32)));
+        ImVec2 pos = ImGui::GetCursorScreenPos();
+        if (ImGui::Selectable("##tile", isSelected, ImGuiSelectableFlags_AllowDoubleClick, tileSize))
+        {
+            m_selectedGameId = id;
+            if (ImGui::IsMouseDoubleClicked(0))
+            {
+                const GameEntry *g = SelectedGame();
+                if (g && (!g->exePath.empty() || !g->installPath.empty()))
+                    LaunchGame(*g, false);
+            }
+        }
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("%s", m_library.NameCStr(i));
+
+        if (m_autoScrollFrames > 0 && isSelected)
+        {
+            ImGui::SetScrollHereY(0.5f);
+            ImGui::SetItemDefaultFocus();
+        }
+
+        // Covers sit in the install folder, or failing that beside the exe
+        m_library.PeekPath(i, GamePath::Install, m_coverFolder);
+        if (m_coverFolder.empty())
+        {
+            m_library.PeekPath(i, GamePath::Exe, m_coverFolder);
+            size_t slash = m_coverFolder.find_last_of("\\/");
+            m_coverFolder.resize(slash == std::string::npos ? 0 : slash);
+        }
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        CoverRef cover;
+        if (m_covers.Request(id, m_library.NameCStr(i), m_coverFolder, cover))
+        {
+            // Fitted and centred, keeping the aspect ratio
+            float scale = std::min(tileSize.x / cover.size.x, coverHeight / cover.size.y);
+            ImVec2 size(cover.size.x * scale, cover.size.y * scale);
+            ImVec2 min(pos.x + (tileSize.x - size.x) * 0.5f, pos.y + (coverHeight - size.y) * 0.5f);
+            drawList->AddImage(cover.texture, min, ImVec2(min.x + size.x, min.y + size.y), ImVec2(0, 0), cover.uv1,
+                               isPlayable ? IM_COL32_WHITE : IM_COL32(255, 255, 255, 128));
+        }
+        else
+        {
+            const char *label = item.platform < IM_ARRAYSIZE(PLATFORM_LABELS) ? PLATFORM_LABELS[item.platform] : "?";
+            ImVec2 labelSize = ImGui::CalcTextSize(label);
+            drawList->AddRectFilled(pos, ImVec2(pos.x + tileSize.x, pos.y + coverHeight), ImGui::GetColorU32(ImGuiCol_FrameBg), 4.0f);
+            drawList->AddText(ImVec2(pos.x + (tileSize.x - labelSize.x) * 0.5f, pos.y + (coverHeight - labelSize.y) * 0.5f),
+                              ImGui::GetColorU32(ImGuiCol_TextDisabled), label);
+        }
+
+        // Name under the cover, cut off at the tile's edge
+        ImVec2 nameMin(pos.x, pos.y + coverHeight);
+        drawList->PushClipRect(nameMin, ImVec2(pos.x + tileSize.x, pos.y + tileSize.y), true);
+        drawList->AddText(ImVec2(nameMin.x, nameMin.y + ImGui::GetStyle().ItemSpacing.y * 0.5f),
+                          ImGui::GetColorU32(isPlayable ? ImGuiCol_Text : ImGuiCol_TextDisabled), m_library.NameCStr(i));
+        drawList->PopClipRect();
+
+        ImGui::PopID();
+    }
+
     void GameLauncher::RenderGameDashboard()
     {
         ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(16.0f, 16.0f));
         ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 8.0f);
         ImGui::BeginChild("RightColumnChild", ImVec2(0, 0), true);
 
-        if (m_selectedGameIdx < 0 || m_selectedGameIdx >= (int)m_games.size())
+        GameEntry *selected = SelectedGame();
+        if (!selected)
         {
             ImGui::TextDisabled("Select a game from the library.");
             ImGui::EndChild();
@@ -1527,7 +2849,7 @@ namespace Core
             return;
         }
 
-        GameEntry &game = m_games[m_selectedGameIdx];
+        GameEntry &game = *selected;
 
         // Title
         bool hasLargeFont = (ImGui::GetIO().Fonts->Fonts.Size > 1);
@@ -1544,6 +2866,30 @@ namespace Core
         else
             ImGui::TextColored(ImVec4(1, 0.5, 0, 1), "[UNPLAYABLE]");
 
+        // Other versions, platforms and languages of this game, one click away
+        size_t selectedIdx = m_library.IndexOf(m_selectedGameId);
+        m_franchises.Update(m_library);
+        uint32_t franchise = selectedIdx != GameLibrary::npos ? m_franchises.GroupOf(selectedIdx) : UINT32_MAX;
+        if (franchise != UINT32_MAX && m_franchises.Group(franchise).count > 1)
+        {
+            const uint32_t *members = m_franchises.Members(franchise);
+            ImGui::SetNextItemWidth(360.0f);
+            if (ImGui::BeginCombo("Variant", game.name.c_str()))
+            {
+                for (uint32_t k = 0; k < m_franchises.Group(franchise).count; ++k)
+                {
+                    ImGui::PushID((int)k);
+                    if (ImGui::Selectable(m_library.NameCStr(members[k]), members[k] == selectedIdx))
+                    {
+                        m_selectedGameId = m_library.Id(members[k]);
+                        m_autoScrollFrames = 3;
+                    }
+                    ImGui::PopID();
+                }
+                ImGui::EndCombo();
+            }
+        }
+
         ImGui::Spacing();
 
         bool canPlay = !game.exePath.empty() || !game.installPath.empty();
@@ -1620,6 +2966,8 @@ namespace Core
         ImGui::TextDisabled("INFO");
         ImGui::Text("Platform: %s", game.platform == GamePlatform::DOS ? "DOS" : "Windows");
         ImGui::Text("Machine: %s", game.machine == MachineType::PC ? "PC" : "Tandy");
+        if (!game.tags.empty())
+            ImGui::Text("Tags: %s", JoinTags(game.tags, ", ").c_str());
         ImGui::Text("File: %s", game.exePath.c_str());
 
         ImGui::EndChild();
@@ -1633,7 +2981,7 @@ namespace Core
             return;
 
         // If index is invalid, force close the window to prevent crash (hack)
-        if (m_selectedGameIdx < 0 || m_selectedGameIdx >= (int)m_games.size())
+        if (!SelectedGame())
         {
             m_showEditWindow = false;
             return;
@@ -1643,6 +2991,9 @@ namespace Core
         if (m_showEditWindow && !ImGui::IsPopupOpen("Edit Game Details"))
         {
             ImGui::OpenPopup("Edit Game Details");
+
+            // Journal whatever gets edited, however the window ends up closed
+            MarkGameDirty(m_selectedGame.id);
         }
 
         ImVec2 center = ImGui::GetMainViewport()->GetCenter();
@@ -1652,10 +3003,11 @@ namespace Core
         // Begin Parent Modal
         if (ImGui::BeginPopupModal("Edit Game Details", &m_showEditWindow, ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoCollapse))
         {
+            bool typing = false; // In a free-text box: stored once it loses focus, not per keystroke
 
-            if (m_selectedGameIdx >= 0 && m_selectedGameIdx < (int)m_games.size())
+            if (SelectedGame())
             {
-                GameEntry &game = m_games[m_selectedGameIdx];
+                GameEntry &game = m_selectedGame;
 
                 if (ImGui::BeginTable("EditForm", 2, ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp))
                 {
@@ -1672,6 +3024,9 @@ namespace Core
                     strncpy(nameBuf, game.name.c_str(), sizeof(nameBuf) - 1);
                     if (ImGui::InputText("##Name", nameBuf, sizeof(nameBuf)))
                         game.name = nameBuf;
+                    typing = ImGui::IsItemActive();
+                    if (ImGui::IsItemDeactivatedAfterEdit())
+                        StoreSelectedGame();
 
                     if (ImGui::IsItemHovered())
                         ImGui::SetMouseCursor(ImGuiMouseCursor_Arrow);
@@ -1685,6 +3040,9 @@ namespace Core
                     strncpy(descBuf, game.description.c_str(), sizeof(descBuf) - 1);
                     if (ImGui::InputTextMultiline("##Desc", descBuf, sizeof(descBuf), ImVec2(-1, 100)))
                         game.description = descBuf;
+                    typing = typing || ImGui::IsItemActive();
+                    if (ImGui::IsItemDeactivatedAfterEdit())
+                        StoreSelectedGame();
 
                     if (ImGui::IsItemHovered())
                         ImGui::SetMouseCursor(ImGuiMouseCursor_Arrow);
@@ -1729,6 +3087,29 @@ namespace Core
                     if (ImGui::Combo("##Status", &status, "Unplayable\0Playable\0\0"))
                         game.status = (GameStatus)status;
 
+                    // Edited as text; only re-read from the game while the box isn't being typed in
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::Text("Tags");
+                    ImGui::TableSetColumnIndex(1);
+                    if (!m_editTagsActive)
+                    {
+                        std::string joined = JoinTags(game.tags, "; ");
+                        strncpy(m_editTags, joined.c_str(), sizeof(m_editTags) - 1);
+                        m_editTags[sizeof(m_editTags) - 1] = '\0';
+                    }
+                    if (ImGui::InputTextWithHint("##Tags", "studio/LucasArts; adventure", m_editTags, sizeof(m_editTags)))
+                        game.tags = SplitTags(m_editTags);
+                    m_editTagsActive = ImGui::IsItemActive();
+                    typing = typing || m_editTagsActive;
+                    if (ImGui::IsItemDeactivatedAfterEdit())
+                        StoreSelectedGame();
+                    if (ImGui::IsItemHovered())
+                    {
+                        ImGui::SetMouseCursor(ImGuiMouseCursor_Arrow);
+                        ImGui::SetTooltip("Separate tags with ';'. Use '/' to nest them in collections.");
+                    }
+
                     // Paths
                     ImGui::TableNextRow();
                     ImGui::TableSetColumnIndex(0);
@@ -1994,9 +3375,10 @@ namespace Core
 
                 if (ImGui::Button("Close / Save", ImVec2(120, 0)))
                 {
-                    SaveDatabase();
+                    StoreSelectedGame();
+                    RequestSave(PersistLibrary);
                     m_showEditWindow = false;
-                    SortLibrary();
+                    m_autoScrollFrames = 3; // Follow the entry if a rename moved it
                     ImGui::CloseCurrentPopup();
                 }
                 ImGui::SameLine();
@@ -2004,9 +3386,8 @@ namespace Core
                 ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.6f, 0, 0, 1));
                 if (ImGui::Button("Delete Game", ImVec2(120, 0)))
                 {
-                    m_games.erase(m_games.begin() + m_selectedGameIdx);
-                    m_selectedGameIdx = -1;
-                    SaveDatabase();
+                    RemoveGame(m_selectedGameId);
+                    RequestSave(PersistLibrary);
                     m_showEditWindow = false;
                     ImGui::CloseCurrentPopup();
                 }
@@ -2021,8 +3402,23 @@ namespace Core
 
             RenderFileBrowser();
 
+            // Other edits (including file browser picks) land in the library as they happen
+            if (!typing)
+                StoreSelectedGame();
+
             ImGui::EndPopup();
         }
+
+        // Closed from the title bar, maybe mid-edit: the body didn't run this frame, so store here
+        if (!m_showEditWindow)
+        {
+            m_editTagsActive = false;
+            if (SelectedGame() && m_selectedGame != m_storedSelectedGame)
+            {
+                StoreSelectedGame();
+                RequestSave(PersistLibrary);
+            }
+        }
     }
 
     void GameLauncher::RenderConfigModal()
@@ -2031,12 +3427,13 @@ namespace Core
         {
             ImGui::OpenPopup("Launcher Configuration");
             m_triggerConfigModal = false;
+            m_libraryMemory = m_library.Memory();
             m_showConfigModal = true;
         }
 
         ImVec2 center = ImGui::GetMainViewport()->GetCenter();
         ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
-        ImGui::SetNextWindowSize(ImVec2(450, 420));
+        ImGui::SetNextWindowSize(ImVec2(450, 530));
 
         // <-- Begin Config Modal -->
         if (ImGui::BeginPopupModal("Launcher Configuration", &m_showConfigModal, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoDocking))
@@ -2048,7 +3445,7 @@ namespace Core
             // Background Shader Toggle
             if (ImGui::Checkbox("Enable Animated Background", &m_configEnableBackground))
             {
-                SaveConfig();
+                RequestSave(PersistConfig);
             }
             if (ImGui::IsItemHovered())
                 ImGui::SetTooltip("Disabling this saves GPU usage (0%% GPU on Idle).");
@@ -2071,7 +3468,7 @@ namespace Core
             {
                 // Apply immediately
                 UI::ThemeManager::ApplyTheme((UI::AppTheme)m_configTheme);
-                SaveConfig();
+                RequestSave(PersistConfig);
             }
 
             ImGui::Spacing();
@@ -2081,7 +3478,7 @@ namespace Core
             // Mouse Warp Toggle
             if (ImGui::Checkbox("Fix Slow Mouse (Warp Mode)", &m_configMouseWarp))
             {
-                SaveConfig();
+                RequestSave(PersistConfig);
             }
             if (ImGui::IsItemHovered())
                 ImGui::SetTooltip("Sets SDL_MOUSE_RELATIVE_MODE_WARP=1.\nFixes sluggish mouse in many DOS/Win9x games.");
@@ -2097,12 +3494,45 @@ namespace Core
                 m_showAboutModal = true;
             }
 
+            // Library Import / Export
+            ImGui::Spacing();
+            ImGui::Text("Library File Format");
+            ImGui::SetNextItemWidth(180 * 2 + ImGui::GetStyle().ItemSpacing.x);
+            ImGui::Combo("##ExchangeFormat", &m_exchangeFormat, EXCHANGE_FORMAT_NAMES, IM_ARRAYSIZE(EXCHANGE_FORMAT_NAMES));
+
+            const char *exchangeFile = EXCHANGE_FILES[m_exchangeFormat];
+            std::string importLabel = std::string("Import ") + exchangeFile;
+            std::string exportLabel = std::string("Export ") + exchangeFile;
+
+            if (ImGui::Button(importLabel.c_str(), ImVec2(180, 0)))
+            {
+                ImportLibrary();
+            }
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Adds the games listed in %s (next to the launcher) to the library.", exchangeFile);
+
+            ImGui::SameLine();
+
+            if (ImGui::Button(exportLabel.c_str(), ImVec2(180, 0)))
+            {
+                ExportLibrary();
+            }
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Writes the library to %s.", exchangeFile);
+
+            ImGui::TextDisabled("Library: %d games, %.1f MB in memory (%.1f MB uncompacted)",
+                                (int)m_libraryMemory.games, m_libraryMemory.Total() / 1048576.0, m_libraryMemory.expandedBytes / 1048576.0);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("List rows: %.1f KB\nRecords: %.1f KB\nText: %.1f KB (%d distinct strings)",
+                                  m_libraryMemory.hotBytes / 1024.0, m_libraryMemory.recordBytes / 1024.0,
+                                  m_libraryMemory.arenaBytes / 1024.0, (int)m_libraryMemory.arenaStrings);
+
             ImGui::Spacing();
             ImGui::Separator();
 
             if (ImGui::Button("Close", ImVec2(120, 0)))
             {
-                SaveConfig();
+                RequestSave(PersistConfig);
                 m_showConfigModal = false;
                 ImGui::CloseCurrentPopup();
             }
@@ -2153,15 +3583,27 @@ namespace Core
 
     void GameLauncher::RenderUI()
     {
+        UpdateDreammScan();
+        UpdateDiscovery();
+        UpdateExport();
+        m_icons.Update();
+        m_covers.Update();
+        if (m_icons.TakeDirty())
+            RequestSave(PersistIcons);
+        if (m_fingerprints.TakeDirty())
+            RequestSave(PersistFingerprints);
+        UpdatePersistence();
+
         ImGui::SetMouseCursor(ImGuiMouseCursor_Arrow);
 
         ImGui::Columns(2, "MainLayout", true);
-        static bool widthSet = false;
-        if (!widthSet)
+        if (!m_layoutApplied)
         {
-            ImGui::SetColumnWidth(0, ImGui::GetWindowWidth() * 0.33f);
-            widthSet = true;
+            float sidebarWidth = m_configSidebarWidth > 0.0f ? m_configSidebarWidth : ImGui::GetWindowWidth() * 0.33f;
+            ImGui::SetColumnWidth(0, sidebarWidth);
+            m_layoutApplied = true;
         }
+        TrackWindowLayout(ImGui::GetColumnWidth(0));
         RenderGameList();
         ImGui::NextColumn();
         RenderGameDashboard();
@@ -2170,6 +3612,7 @@ namespace Core
         RenderConfigModal();
         RenderEditWindow();
         RenderNewGamesModal();
+        RenderDiscoveryWindow();
 
         if (m_dreammExePath.empty() && !m_showFileBrowser)
         {
@@ -2203,7 +3646,6 @@ namespace Core
                 if (ImGui::Button("Save"))
                 {
                     SaveConfig();
-                    SaveDatabase();
                     SortLibrary();
                     ImGui::CloseCurrentPopup();
                 }
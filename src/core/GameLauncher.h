@@ -2,72 +2,37 @@
 #define GAMELAUNCHER_H
 
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <future>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "imgui.h"
+#include "Core/CoverCache.h"
+#include "Core/DreammScanner.h"
+#include "Core/DreammWatcher.h"
+#include "Core/FilterQuery.h"
+#include "Core/FranchiseIndex.h"
+#include "Core/FuzzyMatcher.h"
+#include "Core/GameCatalogue.h"
+#include "Core/GameDiscovery.h"
+#include "Core/GameEntry.h"
+#include "Core/GameLibrary.h"
+#include "Core/IconAtlas.h"
+#include "Core/LibraryExchange.h"
+#include "Core/LibraryJournal.h"
+#include "Core/LibrarySearch.h"
+#include "Core/PersistenceWorker.h"
 
 namespace Core
 {
     namespace fs = std::filesystem;
 
-    // Enums
-    enum class GamePlatform
-    {
-        DOS = 0,
-        Windows = 1,
-        DreammNative = 2
-    };
-
-    enum class GameStatus
-    {
-        Unplayable = 0,
-        Playable = 1
-    };
-
-    enum class MachineType
-    {
-        PC = 0,
-        Tandy = 1
-    };
-
-    // Data Structures
-    struct GameEntry
-    {
-        // Metadata
-        std::string name = "New Game";
-        std::string description = "";
-        GamePlatform platform = GamePlatform::DOS;
-        GameStatus status = GameStatus::Unplayable;
-
-        // Paths
-        std::string exePath;
-        std::string setupPath;
-        std::string installPath;
-        std::string isoPath;
-        std::string rootPathOverride;
-
-        // Window Settings
-        bool forceWindowed = false;
-        bool forceMaximized = false;
-        bool forceFullscreen = false;
-
-        // Hardware Emulation
-        int ramKB = 16384;
-        int mips = 60;
-        MachineType machine = MachineType::PC;
-        bool audioFlags[6] = {false, false, false, true, false, false};
-        int videoHwIdx = 5;
-
-        // Display Settings
-        int width = 800;
-        int height = 600;
-        int depth = 32;
-    };
-
     struct FileBrowserEntry
     {
         std::string name;
@@ -93,12 +58,42 @@ namespace Core
         // Persistence & Data
         void LoadConfig();
         void SaveConfig();
+        void SaveIcons();
+        void SaveFingerprints();
+        void LoadCatalogue();
+        void RequestSave(uint32_t targets);
+        void UpdatePersistence();
+        void ApplyWindowLayout();
+        void TrackWindowLayout(float sidebarWidth);
         void LoadDatabase();
         void SaveDatabase();
+        void CompactDatabase();
         void ConvertLegacyDatabase();
+        void ImportLibrary();
+        void ExportLibrary();
+        void UpdateExport();
+        bool ImportTextDatabase(const fs::path &path, std::vector<GameEntry> &outGames);
+        std::string BuildTextDatabase();
+
+        // Library Mutations (journaled)
+        uint64_t AddGame(GameEntry game);
+        void RemoveGame(uint64_t id);
+        void MarkGameDirty(uint64_t id, JournalOp op = JournalOp::Edit);
+        void MergeNewGames(std::vector<GameEntry> incoming);
+        void ReindexSearch();
+
+        // Selection is tracked by id, so it survives sorts, merges and removals;
+        // m_selectedGame is a materialised copy for the dashboard & editor
+        GameEntry *SelectedGame();
+        void StoreSelectedGame();
 
         // Logic & Operations
         void ScanDreammGames();
+        void UpdateDreammScan();
+        void AddDreammInstalls(std::vector<DreammInstall> installs);
+        void ApplyDreammListing(const DreammFolderListing &listing);
+        void StartDiscovery();
+        void UpdateDiscovery();
         void SortLibrary();
         void LaunchGame(const GameEntry &game, bool runSetup);
         void CreateDreammFile(const GameEntry &game);
@@ -106,10 +101,16 @@ namespace Core
         std::string ResolveDreammGameName(const std::string &folderID, const std::string &versionID, GamePlatform &outPlatform);
 
         // UI Rendering - Components
+        void UpdateFilteredRows();
+        void UpdateTreeRows();
         void RenderGameList();
+        void RenderGameRow(uint32_t idx, bool indent);
+        void RenderGameGrid();
+        void RenderGameTile(uint32_t idx, const ImVec2 &tileSize, float coverHeight);
         void RenderGameDashboard();
         void RenderEditWindow();
         void RenderNewGamesModal();
+        void RenderDiscoveryWindow();
         void RenderConfigModal();
         void RenderAboutModal();
         void RenderFileBrowser();
@@ -121,19 +122,114 @@ namespace Core
 
         // Core Data
         std::string m_dreammExePath;
-        std::vector<GameEntry> m_games;
-        int m_selectedGameIdx = -1;
+        GameLibrary m_library;
+        uint64_t m_selectedGameId = 0; // 0 = nothing selected
+        GameEntry m_selectedGame;
+        GameLibrary::MemoryStats m_libraryMemory;
+        std::unordered_map<uint64_t, JournalOp> m_pendingMutations;
+        uintmax_t m_journalBytes = 0;
+        std::atomic<bool> m_journalFailed{false};
+        LibrarySearch m_search;
+        FuzzySearch m_fuzzy;
+        DreammScanner m_dreammScanner;
+        DreammWatcher m_dreammWatcher;
+        fs::path m_dreammRoot;
+        std::unordered_map<std::string, uint64_t> m_dreammInstalls; // Folded install path -> game id
+        GameEntry m_storedSelectedGame;    // m_selectedGame as last written to the library
+        std::string m_indexedSelectedText; // Last search text sent for the game being edited
+
+        // Library roots crawled for games, and what the crawl proposed for review
+        struct DiscoveryProposal
+        {
+            GameEntry game;
+            bool accept = true;
+        };
+        GameDiscovery m_discovery;
+        std::vector<DiscoveryProposal> m_discoveryProposals;
+        std::unordered_set<std::string> m_discoveryKnown; // Folded exe paths in the library or already proposed
+        char m_discoveryRootInput[512] = "";
+
+        // Known executables by content hash, for naming games added by hand or by a scan
+        GameCatalogue m_catalogue;
+        FingerprintCache m_fingerprints;
+
+        // Executable icons drawn beside each library row
+        IconAtlas m_icons;
+
+        // Box art for the grid view
+        CoverCache m_covers;
+        std::string m_coverFolder; // Scratch for the tile being drawn
 
         // Persisted Settings
         bool m_configEnableBackground = true;
         bool m_configMouseWarp = true;
         int m_configTheme = 0;
+        int m_configWindowWidth = 0;
+        int m_configWindowHeight = 0;
+        float m_configSidebarWidth = 0.0f;
+        bool m_layoutApplied = false;
+        bool m_configGroupedView = false; // Library list grouped by franchise
+        bool m_configGridView = false;    // Library shown as cover art tiles
+        std::vector<std::string> m_configLibraryRoots;
 
         // UI State - Main
         char m_filterName[256] = "";
         int m_filterPlatform = 0;
         int m_filterStatus = 0;
+        std::string m_filterCollection; // "" = all
         int m_autoScrollFrames = 0;
+        SortColumn m_sortColumn = SortColumn::Name; // Library table ordering (from the clicked header)
+        bool m_sortDescending = false;
+
+        // Filtered rows in display order, and the inputs they were computed from
+        std::vector<uint32_t> m_filteredRows;
+        std::vector<uint8_t> m_filteredListed; // Per library position, scratch for merging hits
+        FilterQuery m_filterQuery;             // Compiled from m_filterName and the combos on each edit
+        RowBitmap m_filteredAllowed;           // Rows passing m_filterQuery
+        std::string m_submittedQuery;          // Last text handed to m_search
+        std::shared_ptr<const NameList> m_searchNames; // Last names handed to m_search
+        std::string m_foldedQuery;             // Scratch for re-checking earlier hits against the query
+        std::string m_hitText;                 // ...and for their search text
+        std::string m_filteredQuery;
+        uint64_t m_filteredSearchGeneration = 0;
+        int m_filteredPlatform = -1;
+        int m_filteredStatus = -1;
+        std::string m_filteredCollection;
+        SortColumn m_filteredColumn = SortColumn::Name;
+        bool m_filteredDescending = false;
+        uint64_t m_filteredRevision = 0; // 0 = never computed
+        uint64_t m_filteredStamp = 0;    // Bumped whenever m_filteredRows is recomputed
+
+        // Grouped view: the filtered rows folded under their franchise, flattened
+        // to what is on screen (a header per group, members of expanded ones)
+        struct TreeRow
+        {
+            uint32_t group;
+            int32_t idx; // Library position, or -1 for a group header
+        };
+        FranchiseIndex m_franchises;
+        std::unordered_set<std::string> m_expandedGroups; // By FranchiseGroup::key, so they survive rebuilds
+        std::vector<TreeRow> m_treeRows;
+        std::vector<uint32_t> m_treeMembers;      // Filtered rows grouped, in display order
+        std::vector<uint32_t> m_treeMemberStart;  // Per group, into m_treeMembers
+        std::vector<uint32_t> m_treeMemberCount;  // Per group; 0 = no member passes the filter
+        uint64_t m_treeStamp = 0;                 // m_filteredStamp the tree was built from; 0 = rebuild
+        int m_exchangeFormat = 0; // Index into EXCHANGE_FILES
+
+        // CSV / JSON Lines export in progress: a batch per frame, read in place
+        // from a snapshot of the ids, so only one batch of text is held at a time
+        struct PendingExport
+        {
+            bool active = false;
+            ExchangeFormat format = ExchangeFormat::Csv;
+            const char *fileName = nullptr;
+            std::vector<uint64_t> ids;
+            size_t next = 0;
+            int written = 0;
+            GameEntry row;                       // Reused for every row
+            std::shared_ptr<std::ofstream> file; // Only touched on the persistence worker
+        };
+        PendingExport m_export;
         std::string m_autoScrollTarget;
 
         // UI State - Modals & Windows
@@ -141,11 +237,15 @@ namespace Core
         bool m_showConfigModal = false;
         bool m_showAboutModal = false;
         bool m_showNewGamesModal = false;
+        bool m_showDiscoveryWindow = false;
         bool m_showFileBrowser = false;
+        char m_editTags[512] = "";
+        bool m_editTagsActive = false;
         
         // UI State - Triggers & Flags
         bool m_triggerConfigModal = false;
         bool m_triggerNewGamesModal = false;
+        bool m_triggerDiscoveryWindow = false;
         bool m_pendingAboutOpen = false;
         bool m_pendingBrowserOpen = false;
         int m_newGamesCount = 0;
@@ -159,6 +259,9 @@ namespace Core
         std::vector<FileBrowserEntry> m_browserEntries;
         std::future<std::vector<FileBrowserEntry>> m_loadingFuture;
 
+        // Background Writes (declared last: stopped in the destructor, before members go away)
+        PersistenceWorker m_persistence;
+
         // Constants
         const char *m_audioNames[6] = {"speaker", "cms", "adlib", "sb16", "mt32", "gmidi"};
         const char *m_videoHwOptions[6] = {"hercules", "cga", "ega", "mcga", "vga", "svga"};
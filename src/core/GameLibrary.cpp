@@ -0,0 +1,870 @@
+#include "pch.h"
+#include "Core/GameLibrary.h"
+#include "Core/LibraryJournal.h"
+#include "Core/TextFold.h"
+
+#include <algorithm>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+
+namespace Core
+{
+
+    // Below this many entries per thread a plain stable_sort wins
+    static const size_t PARALLEL_SORT_MIN_CHUNK = 16384;
+
+    // <-- Helpers -->
+    static uint16_t ClampU16(int value)
+    {
+        return (uint16_t)std::clamp(value, 0, 0xFFFF);
+    }
+
+    static uint8_t ClampU8(int value)
+    {
+        return (uint8_t)std::clamp(value, 0, 0xFF);
+    }
+
+    // Heap bytes a std::string of this length would own (15-char small-string buffer)
+    static size_t HeapBytes(size_t length)
+    {
+        return length > 15 ? length + 1 : 0;
+    }
+
+    // splitmix64 finaliser: ids are handed out sequentially, so spread them first
+    static size_t MixId(uint64_t id)
+    {
+        id ^= id >> 30;
+        id *= 0xBF58476D1CE4E5B9ull;
+        id ^= id >> 27;
+        id *= 0x94D049BB133111EBull;
+        id ^= id >> 31;
+        return (size_t)id;
+    }
+
+    static bool SamePath(const PathRef &a, const PathRef &b)
+    {
+        return a.dir == b.dir && a.leaf == b.leaf;
+    }
+
+    // Stable sort of a position vector: sorted chunks on worker threads, then
+    // neighbouring runs merged pairwise (each round's merges also in parallel)
+    template <typename Less>
+    static void ParallelStableSort(std::vector<uint32_t> &order, Less less)
+    {
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t chunks = std::min(threads, order.size() / PARALLEL_SORT_MIN_CHUNK);
+        if (chunks < 2)
+        {
+            std::stable_sort(order.begin(), order.end(), less);
+            return;
+        }
+
+        std::vector<size_t> bounds(chunks + 1);
+        for (size_t i = 0; i <= chunks; ++i)
+            bounds[i] = order.size() * i / chunks;
+
+        std::vector<std::future<void>> jobs;
+        for (size_t i = 0; i < chunks; ++i)
+        {
+            auto first = order.begin() + bounds[i];
+            auto last = order.begin() + bounds[i + 1];
+            jobs.push_back(std::async(std::launch::async, [first, last, &less]
+                                      { std::stable_sort(first, last, less); }));
+        }
+        for (auto &job : jobs)
+            job.get();
+
+        for (size_t width = 1; width < chunks; width *= 2)
+        {
+            jobs.clear();
+            for (size_t i = 0; i + width < chunks; i += 2 * width)
+            {
+                auto first = order.begin() + bounds[i];
+                auto middle = order.begin() + bounds[i + width];
+                auto last = order.begin() + bounds[std::min(i + 2 * width, chunks)];
+                jobs.push_back(std::async(std::launch::async, [first, middle, last, &less]
+                                          { std::inplace_merge(first, middle, last, less); }));
+            }
+            for (auto &job : jobs)
+                job.get();
+        }
+    }
+
+    // <-- Loading -->
+    bool GameLibrary::Open(const fs::path &libraryFile)
+    {
+        Clear();
+        if (!m_file.Open(libraryFile))
+            return false;
+
+        uint32_t count = m_file.RecordCount();
+        Reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const LibraryRecord r = m_file.Record(i);
+
+            GameListItem item = {};
+            item.name = m_strings.Intern(m_file.String(r.name));
+            item.collation = Collate(m_file.String(r.name));
+            item.platform = r.platform;
+            item.status = r.status;
+
+            GameRecord rec = {};
+            rec.id = r.id;
+            rec.tags = m_strings.Intern(m_file.String(r.tags));
+            rec.ramKB = r.ramKB;
+            rec.mips = r.mips;
+            rec.width = ClampU16(r.width);
+            rec.height = ClampU16(r.height);
+            rec.machine = r.machine & 1;
+            rec.windowFlags = r.windowFlags & 7;
+            rec.audioMask = r.audioMask & 0x3F;
+            rec.videoHwIdx = (r.videoHwIdx < 6) ? r.videoHwIdx : 5;
+            rec.depth = ClampU8(r.depth);
+            rec.detailsLoaded = 0;
+            rec.sourceRecord = i;
+
+            m_items.push_back(item);
+            m_records.push_back(rec);
+        }
+        m_revision++;
+        return true;
+    }
+
+    int GameLibrary::ReplayJournal(const fs::path &journalFile)
+    {
+        std::vector<bool> removed(m_records.size(), false);
+
+        // Add and Edit are both upserts, so replaying twice is harmless. Deleted
+        // rows stay in place (and in the index) until the sweep below.
+        int applied = LibraryJournal::Replay(journalFile, [&](JournalOp op, uint64_t id, const GameEntry *game)
+                                             {
+            size_t idx = IndexOf(id);
+            if (op == JournalOp::Delete)
+            {
+                if (idx != npos)
+                    removed[idx] = true;
+                return;
+            }
+
+            if (idx != npos)
+            {
+                removed[idx] = false;
+                Set(idx, *game);
+            }
+            else
+            {
+                Append(*game);
+                removed.push_back(false);
+            } });
+
+        size_t out = 0;
+        for (size_t i = 0; i < m_records.size(); ++i)
+        {
+            if (!removed[i])
+            {
+                m_items[out] = m_items[i];
+                m_records[out] = m_records[i];
+                out++;
+            }
+        }
+        if (out != m_records.size())
+        {
+            m_idIndexStale = true;
+            m_revision++;
+        }
+        m_items.resize(out);
+        m_records.resize(out);
+
+        return applied;
+    }
+
+    // Decodes whatever is still lazy and unmaps games.bin (needed before replacing it)
+    void GameLibrary::ReleaseMapping()
+    {
+        if (!m_file.IsOpen())
+            return;
+
+        for (size_t i = 0; i < m_records.size(); ++i)
+            EnsureDetails(i);
+        m_file.Close();
+    }
+
+    void GameLibrary::Clear()
+    {
+        m_file.Close();
+        m_items.clear();
+        m_records.clear();
+        m_strings.Clear();
+        m_idSlots.clear();
+        m_idIndexStale = true;
+        m_revision++;
+    }
+
+    // <-- Id Index -->
+    size_t GameLibrary::IndexOf(uint64_t id) const
+    {
+        if (m_idIndexStale)
+            RebuildIdIndex();
+
+        size_t mask = m_idSlots.size() - 1;
+        size_t slot = MixId(id) & mask;
+        while (m_idSlots[slot] != 0)
+        {
+            size_t idx = m_idSlots[slot] - 1;
+            if (m_records[idx].id == id)
+                return idx;
+            slot = (slot + 1) & mask;
+        }
+        return npos;
+    }
+
+    void GameLibrary::SetId(size_t idx, uint64_t id)
+    {
+        m_records[idx].id = id;
+        m_idIndexStale = true;
+        m_revision++;
+    }
+
+    void GameLibrary::RebuildIdIndex() const
+    {
+        // Power of two, load factor at most one half
+        size_t slotCount = 16;
+        while (slotCount < m_records.size() * 2)
+            slotCount *= 2;
+        m_idSlots.assign(slotCount, 0);
+        m_idIndexStale = false;
+
+        for (size_t i = 0; i < m_records.size(); ++i)
+            InsertId(i);
+    }
+
+    void GameLibrary::InsertId(size_t idx) const
+    {
+        if ((idx + 1) * 2 > m_idSlots.size())
+        {
+            RebuildIdIndex(); // Also inserts idx
+            return;
+        }
+
+        size_t mask = m_idSlots.size() - 1;
+        size_t slot = MixId(m_records[idx].id) & mask;
+        while (m_idSlots[slot] != 0)
+            slot = (slot + 1) & mask;
+        m_idSlots[slot] = (uint32_t)(idx + 1);
+    }
+
+    void GameLibrary::EnsureDetails(size_t idx)
+    {
+        GameRecord &rec = m_records[idx];
+        if (rec.detailsLoaded)
+            return;
+
+        rec.detailsLoaded = 1;
+        if (!m_file.IsOpen() || rec.sourceRecord >= m_file.RecordCount())
+            return;
+
+        const LibraryRecord r = m_file.Record(rec.sourceRecord);
+        rec.description = m_strings.Intern(m_file.String(r.description));
+        for (int p = 0; p < (int)GamePath::Count; ++p)
+            rec.paths[p] = InternPath(m_file.String(SourcePath(r, (GamePath)p)));
+    }
+
+    LibraryStringRef GameLibrary::SourcePath(const LibraryRecord &r, GamePath which) const
+    {
+        switch (which)
+        {
+        case GamePath::Exe:
+            return r.exePath;
+        case GamePath::Setup:
+            return r.setupPath;
+        case GamePath::Install:
+            return r.installPath;
+        case GamePath::Iso:
+            return r.isoPath;
+        default:
+            return r.rootPathOverride;
+        }
+    }
+
+    // <-- Paths -->
+    PathRef GameLibrary::InternPath(std::string_view path)
+    {
+        size_t sep = path.find_last_of("\\/");
+        if (sep == std::string_view::npos)
+            return {StringArena::EMPTY, m_strings.Intern(path)};
+        return {m_strings.Intern(path.substr(0, sep + 1)), m_strings.Intern(path.substr(sep + 1))};
+    }
+
+    std::string GameLibrary::JoinPath(const PathRef &ref) const
+    {
+        std::string path(m_strings.Get(ref.dir));
+        path += m_strings.Get(ref.leaf);
+        return path;
+    }
+
+    std::string GameLibrary::Path(size_t idx, GamePath which)
+    {
+        EnsureDetails(idx);
+        return JoinPath(m_records[idx].paths[(int)which]);
+    }
+
+    void GameLibrary::PeekPath(size_t idx, GamePath which, std::string &out) const
+    {
+        const GameRecord &rec = m_records[idx];
+        if (!rec.detailsLoaded)
+        {
+            out.clear();
+            if (m_file.IsOpen() && rec.sourceRecord < m_file.RecordCount())
+                out.assign(m_file.String(SourcePath(m_file.Record(rec.sourceRecord), which)));
+            return;
+        }
+        const PathRef &ref = rec.paths[(int)which];
+        out.assign(m_strings.Get(ref.dir));
+        out += m_strings.Get(ref.leaf);
+    }
+
+    std::string GameLibrary::SearchText(size_t idx) const
+    {
+        std::string text;
+        PeekSearchText(idx, text);
+        return text;
+    }
+
+    // Reads games.bin directly for lazy entries, so indexing doesn't decode the library
+    void GameLibrary::PeekSearchText(size_t idx, std::string &text) const
+    {
+        const GameRecord &rec = m_records[idx];
+
+        text.assign(Name(idx));
+        text += '\n';
+        if (!rec.detailsLoaded)
+        {
+            if (m_file.IsOpen() && rec.sourceRecord < m_file.RecordCount())
+            {
+                const LibraryRecord r = m_file.Record(rec.sourceRecord);
+                text += m_file.String(r.description);
+                text += '\n';
+                text += m_file.String(r.exePath);
+                text += '\n';
+                text += m_file.String(r.installPath);
+            }
+            text += '\n';
+            text += m_strings.Get(rec.tags);
+            return;
+        }
+
+        const PathRef &exe = rec.paths[(int)GamePath::Exe];
+        const PathRef &install = rec.paths[(int)GamePath::Install];
+        text += m_strings.Get(rec.description);
+        text += '\n';
+        text += m_strings.Get(exe.dir);
+        text += m_strings.Get(exe.leaf);
+        text += '\n';
+        text += m_strings.Get(install.dir);
+        text += m_strings.Get(install.leaf);
+        text += '\n';
+        text += m_strings.Get(rec.tags);
+    }
+
+    bool GameLibrary::PathEquals(size_t idx, GamePath which, std::string_view path) const
+    {
+        const GameRecord &rec = m_records[idx];
+        if (!rec.detailsLoaded)
+        {
+            if (!m_file.IsOpen())
+                return path.empty();
+            return m_file.String(SourcePath(m_file.Record(rec.sourceRecord), which)) == path;
+        }
+
+        const PathRef &ref = rec.paths[(int)which];
+        std::string_view dir = m_strings.Get(ref.dir);
+        std::string_view leaf = m_strings.Get(ref.leaf);
+        return path.size() == dir.size() + leaf.size() &&
+               path.substr(0, dir.size()) == dir &&
+               path.substr(dir.size()) == leaf;
+    }
+
+    // <-- Entries -->
+    GameEntry GameLibrary::Get(size_t idx)
+    {
+        EnsureDetails(idx);
+        GameEntry g;
+        Peek(idx, g);
+        return g;
+    }
+
+    void GameLibrary::Peek(size_t idx, GameEntry &out) const
+    {
+        const GameListItem &item = m_items[idx];
+        const GameRecord &rec = m_records[idx];
+
+        out.id = rec.id;
+        out.name.assign(m_strings.Get(item.name));
+        out.platform = (GamePlatform)item.platform;
+        out.status = (GameStatus)item.status;
+        out.tags = SplitTags(m_strings.Get(rec.tags));
+
+        out.description.clear();
+        if (rec.detailsLoaded)
+            out.description.assign(m_strings.Get(rec.description));
+        else if (m_file.IsOpen() && rec.sourceRecord < m_file.RecordCount())
+            out.description.assign(m_file.String(m_file.Record(rec.sourceRecord).description));
+
+        PeekPath(idx, GamePath::Exe, out.exePath);
+        PeekPath(idx, GamePath::Setup, out.setupPath);
+        PeekPath(idx, GamePath::Install, out.installPath);
+        PeekPath(idx, GamePath::Iso, out.isoPath);
+        PeekPath(idx, GamePath::RootOverride, out.rootPathOverride);
+
+        out.forceWindowed = (rec.windowFlags & 1) != 0;
+        out.forceMaximized = (rec.windowFlags & 2) != 0;
+        out.forceFullscreen = (rec.windowFlags & 4) != 0;
+
+        out.ramKB = rec.ramKB;
+        out.mips = rec.mips;
+        out.machine = (MachineType)rec.machine;
+        for (int i = 0; i < 6; i++)
+            out.audioFlags[i] = (rec.audioMask & (1 << i)) != 0;
+        out.videoHwIdx = rec.videoHwIdx;
+
+        out.width = rec.width;
+        out.height = rec.height;
+        out.depth = rec.depth;
+    }
+
+    void GameLibrary::Set(size_t idx, const GameEntry &game)
+    {
+        GameListItem &item = m_items[idx];
+        GameRecord &rec = m_records[idx];
+        const GameListItem before = item;
+        const int32_t ramBefore = rec.ramKB;
+        const int32_t mipsBefore = rec.mips;
+        const uint32_t machineBefore = rec.machine;
+        const uint32_t videoHwBefore = rec.videoHwIdx;
+        const StringArena::Ref tagsBefore = rec.tags;
+        const PathRef exeBefore = rec.paths[(int)GamePath::Exe];
+        const PathRef installBefore = rec.paths[(int)GamePath::Install];
+
+        item.name = m_strings.Intern(game.name);
+        item.collation = Collate(game.name);
+        item.platform = (uint8_t)game.platform;
+        item.status = (uint8_t)game.status;
+
+        if (rec.id != game.id)
+        {
+            rec.id = game.id;
+            m_idIndexStale = true;
+            m_revision++;
+        }
+        rec.tags = m_strings.Intern(JoinTags(game.tags));
+        rec.description = m_strings.Intern(game.description);
+        rec.paths[(int)GamePath::Exe] = InternPath(game.exePath);
+        rec.paths[(int)GamePath::Setup] = InternPath(game.setupPath);
+        rec.paths[(int)GamePath::Install] = InternPath(game.installPath);
+        rec.paths[(int)GamePath::Iso] = InternPath(game.isoPath);
+        rec.paths[(int)GamePath::RootOverride] = InternPath(game.rootPathOverride);
+
+        rec.windowFlags = (game.forceWindowed ? 1 : 0) | (game.forceMaximized ? 2 : 0) | (game.forceFullscreen ? 4 : 0);
+        rec.ramKB = game.ramKB;
+        rec.mips = game.mips;
+        rec.machine = (game.machine == MachineType::Tandy) ? 1 : 0;
+
+        uint32_t audioMask = 0;
+        for (int i = 0; i < 6; i++)
+        {
+            if (game.audioFlags[i])
+                audioMask |= (1 << i);
+        }
+        rec.audioMask = audioMask;
+        rec.videoHwIdx = (game.videoHwIdx >= 0 && game.videoHwIdx < 6) ? game.videoHwIdx : 5;
+
+        rec.width = ClampU16(game.width);
+        rec.height = ClampU16(game.height);
+        rec.depth = ClampU8(game.depth);
+        rec.detailsLoaded = 1;
+
+        // Interned, so equal text means equal refs; editing a description doesn't invalidate the orders.
+        // So do exe and install path changes, for what is keyed by them (franchises by the DREAMM folder id)
+        if (item.name != before.name || item.platform != before.platform || item.status != before.status ||
+            rec.ramKB != ramBefore || rec.mips != mipsBefore || rec.machine != machineBefore ||
+            rec.videoHwIdx != videoHwBefore || rec.tags != tagsBefore ||
+            !SamePath(rec.paths[(int)GamePath::Exe], exeBefore) ||
+            !SamePath(rec.paths[(int)GamePath::Install], installBefore))
+            m_revision++;
+    }
+
+    void GameLibrary::Append(const GameEntry &game)
+    {
+        m_items.push_back(GameListItem{});
+        m_records.push_back(GameRecord{});
+        m_records.back().id = game.id;
+        Set(m_items.size() - 1, game);
+        m_revision++;
+
+        if (!m_idIndexStale)
+            InsertId(m_items.size() - 1);
+    }
+
+    // Shifts every later position, so the id index is rebuilt on next lookup
+    void GameLibrary::Remove(size_t idx)
+    {
+        m_items.erase(m_items.begin() + idx);
+        m_records.erase(m_records.begin() + idx);
+        m_idIndexStale = true;
+        m_revision++;
+    }
+
+    void GameLibrary::Reserve(size_t count)
+    {
+        m_items.reserve(count);
+        m_records.reserve(count);
+    }
+
+    // <-- Ordering -->
+    bool GameLibrary::NameLess(std::string_view a, std::string_view b)
+    {
+        size_t n = std::min(a.size(), b.size());
+        for (size_t i = 0; i < n; ++i)
+        {
+            unsigned char c1 = (unsigned char)FoldAscii(a[i]);
+            unsigned char c2 = (unsigned char)FoldAscii(b[i]);
+            if (c1 != c2)
+                return c1 < c2;
+        }
+        return a.size() < b.size();
+    }
+
+    StringArena::Ref GameLibrary::Collate(std::string_view name)
+    {
+        std::string folded(name);
+        for (char &c : folded)
+            c = FoldAscii(c);
+        return m_strings.Intern(folded);
+    }
+
+    bool GameLibrary::IsSortedByName() const
+    {
+        for (size_t i = 1; i < m_items.size(); ++i)
+        {
+            if (KeyLess(i, i - 1))
+                return false;
+        }
+        return true;
+    }
+
+    // Bulk path (load, migration): a linear check first, since the library is usually already in order
+    void GameLibrary::SortByName()
+    {
+        if (IsSortedByName())
+            return;
+
+        std::vector<uint32_t> order(m_items.size());
+        std::iota(order.begin(), order.end(), 0);
+        ParallelStableSort(order, [this](uint32_t a, uint32_t b)
+                           { return KeyLess(a, b); });
+        Permute(order);
+    }
+
+    // [0, first) and [first, Size()) must each already be sorted
+    void GameLibrary::MergeSortedTail(size_t first)
+    {
+        std::vector<uint32_t> order(m_items.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::inplace_merge(order.begin(), order.begin() + first, order.end(), [this](uint32_t a, uint32_t b)
+                           { return KeyLess(a, b); });
+        Permute(order);
+    }
+
+    // The library must already be sorted; equal names go after existing ones
+    size_t GameLibrary::InsertSorted(const GameEntry &game)
+    {
+        Append(game);
+
+        size_t last = m_items.size() - 1;
+        std::string_view key = CollationKey(last);
+        size_t lo = 0, hi = last;
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if (key < CollationKey(mid))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+
+        if (lo != last)
+        {
+            std::rotate(m_items.begin() + lo, m_items.begin() + last, m_items.end());
+            std::rotate(m_records.begin() + lo, m_records.begin() + last, m_records.end());
+            m_idIndexStale = true;
+            m_revision++;
+        }
+        return lo;
+    }
+
+    // Moves one entry whose name changed back into place; a no-op when its neighbours still agree
+    size_t GameLibrary::Reposition(size_t idx)
+    {
+        std::string_view key = CollationKey(idx);
+        size_t target = idx;
+
+        if (idx > 0 && key < CollationKey(idx - 1))
+        {
+            // Moves up: first position in [0, idx) whose key is greater
+            size_t lo = 0, hi = idx;
+            while (lo < hi)
+            {
+                size_t mid = lo + (hi - lo) / 2;
+                if (key < CollationKey(mid))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            target = lo;
+            std::rotate(m_items.begin() + target, m_items.begin() + idx, m_items.begin() + idx + 1);
+            std::rotate(m_records.begin() + target, m_records.begin() + idx, m_records.begin() + idx + 1);
+        }
+        else if (idx + 1 < m_items.size() && CollationKey(idx + 1) < key)
+        {
+            // Moves down: lands before the first key in (idx, end) that is greater
+            size_t lo = idx + 1, hi = m_items.size();
+            while (lo < hi)
+            {
+                size_t mid = lo + (hi - lo) / 2;
+                if (key < CollationKey(mid))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            target = lo - 1;
+            std::rotate(m_items.begin() + idx, m_items.begin() + idx + 1, m_items.begin() + lo);
+            std::rotate(m_records.begin() + idx, m_records.begin() + idx + 1, m_records.begin() + lo);
+        }
+
+        if (target != idx)
+        {
+            m_idIndexStale = true;
+            m_revision++;
+        }
+        return target;
+    }
+
+    const std::vector<uint32_t> &GameLibrary::Order(SortColumn column) const
+    {
+        std::vector<uint32_t> &order = m_orders[(int)column];
+        if (m_orderRevision[(int)column] == m_revision)
+            return order;
+
+        order.resize(m_items.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        // Storage order is name order, so a stable sort on the column keeps ties alphabetical
+        switch (column)
+        {
+        case SortColumn::Name:
+            if (!IsSortedByName())
+                ParallelStableSort(order, [this](uint32_t a, uint32_t b)
+                                   { return KeyLess(a, b); });
+            break;
+        case SortColumn::Platform:
+            std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                             { return m_items[a].platform < m_items[b].platform; });
+            break;
+        case SortColumn::Status:
+            std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                             { return m_items[a].status < m_items[b].status; });
+            break;
+        case SortColumn::RamKB:
+            std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                             { return m_records[a].ramKB < m_records[b].ramKB; });
+            break;
+        case SortColumn::Mips:
+            std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                             { return m_records[a].mips < m_records[b].mips; });
+            break;
+        default:
+            break;
+        }
+
+        m_orderRevision[(int)column] = m_revision;
+        return order;
+    }
+
+    // <-- Bitmaps -->
+    size_t LibraryBitmaps::MemoryBytes() const
+    {
+        size_t bytes = all.MemoryBytes();
+        for (const RowBitmap &rows : platform)
+            bytes += rows.MemoryBytes();
+        for (const RowBitmap &rows : status)
+            bytes += rows.MemoryBytes();
+        for (const RowBitmap &rows : machine)
+            bytes += rows.MemoryBytes();
+        for (const RowBitmap &rows : videoHw)
+            bytes += rows.MemoryBytes();
+        for (size_t i = 0; i < tags.size(); ++i)
+            bytes += HeapBytes(tags[i].size()) + tagRows[i].MemoryBytes();
+        return bytes;
+    }
+
+    const LibraryBitmaps &GameLibrary::Bitmaps() const
+    {
+        if (m_bitmapsRevision == m_revision)
+            return m_bitmaps;
+
+        LibraryBitmaps &b = m_bitmaps;
+        b = LibraryBitmaps();
+        b.all = RowBitmap::All((uint32_t)m_items.size());
+
+        // Rows arrive in increasing order, so every Add is an append. Tag lists are
+        // interned, so each distinct list is split and folded only once.
+        std::unordered_map<std::string, uint32_t> tagOf;                     // Folded tag -> slot
+        std::unordered_map<StringArena::Ref, std::vector<uint32_t>> slotsOf; // Tag list -> slots
+        std::string folded;
+        for (uint32_t i = 0; i < (uint32_t)m_items.size(); ++i)
+        {
+            const GameListItem &item = m_items[i];
+            const GameRecord &rec = m_records[i];
+            if (item.platform < 3)
+                b.platform[item.platform].Add(i);
+            if (item.status < 2)
+                b.status[item.status].Add(i);
+            b.machine[rec.machine].Add(i);
+            if (rec.videoHwIdx < 6)
+                b.videoHw[rec.videoHwIdx].Add(i);
+
+            if (rec.tags == StringArena::EMPTY)
+                continue;
+            auto cached = slotsOf.emplace(rec.tags, std::vector<uint32_t>());
+            std::vector<uint32_t> &slots = cached.first->second;
+            if (cached.second)
+            {
+                std::string_view tags = m_strings.Get(rec.tags);
+                size_t pos = 0;
+                while (pos < tags.size())
+                {
+                    size_t end = tags.find('\n', pos);
+                    if (end == std::string_view::npos)
+                        end = tags.size();
+                    std::string_view tag = tags.substr(pos, end - pos);
+                    pos = end + 1;
+
+                    folded.assign(tag);
+                    for (char &c : folded)
+                        c = FoldAscii(c);
+                    auto inserted = tagOf.emplace(folded, (uint32_t)b.tags.size());
+                    if (inserted.second)
+                    {
+                        b.tags.emplace_back(tag);
+                        b.tagRows.emplace_back();
+                    }
+                    slots.push_back(inserted.first->second);
+                }
+            }
+            for (uint32_t slot : slots)
+                b.tagRows[slot].Add(i);
+        }
+
+        // Sort the tag list for the UI, carrying the bitmaps along
+        std::vector<uint32_t> order(b.tags.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&b](uint32_t x, uint32_t y)
+                  { return NameLess(b.tags[x], b.tags[y]); });
+        std::vector<std::string> tagsSorted;
+        std::vector<RowBitmap> rowsSorted;
+        tagsSorted.reserve(order.size());
+        rowsSorted.reserve(order.size());
+        for (uint32_t slot : order)
+        {
+            tagsSorted.push_back(std::move(b.tags[slot]));
+            rowsSorted.push_back(std::move(b.tagRows[slot]));
+        }
+        b.tags.swap(tagsSorted);
+        b.tagRows.swap(rowsSorted);
+
+        m_bitmapsRevision = m_revision;
+        return m_bitmaps;
+    }
+
+    void GameLibrary::Permute(const std::vector<uint32_t> &order)
+    {
+        std::vector<GameListItem> items;
+        std::vector<GameRecord> records;
+        items.reserve(order.size());
+        records.reserve(order.size());
+        for (uint32_t idx : order)
+        {
+            items.push_back(m_items[idx]);
+            records.push_back(m_records[idx]);
+        }
+        m_items.swap(items);
+        m_records.swap(records);
+        m_idIndexStale = true;
+        m_revision++;
+    }
+
+    // <-- Maintenance -->
+    void GameLibrary::Repack()
+    {
+        StringArena fresh;
+        for (size_t i = 0; i < m_items.size(); ++i)
+        {
+            m_items[i].name = fresh.Intern(m_strings.Get(m_items[i].name));
+            m_items[i].collation = fresh.Intern(m_strings.Get(m_items[i].collation));
+
+            GameRecord &rec = m_records[i];
+            rec.tags = fresh.Intern(m_strings.Get(rec.tags));
+            if (!rec.detailsLoaded)
+                continue;
+            rec.description = fresh.Intern(m_strings.Get(rec.description));
+            for (PathRef &path : rec.paths)
+            {
+                path.dir = fresh.Intern(m_strings.Get(path.dir));
+                path.leaf = fresh.Intern(m_strings.Get(path.leaf));
+            }
+        }
+        m_strings = std::move(fresh);
+    }
+
+    GameLibrary::MemoryStats GameLibrary::Memory() const
+    {
+        MemoryStats stats;
+        stats.games = m_items.size();
+        stats.hotBytes = m_items.capacity() * sizeof(GameListItem);
+        stats.recordBytes = m_records.capacity() * sizeof(GameRecord);
+        stats.arenaBytes = m_strings.ReservedBytes();
+        stats.arenaStrings = m_strings.Count();
+        stats.indexBytes = m_idSlots.capacity() * sizeof(uint32_t);
+        for (const auto &order : m_orders)
+            stats.indexBytes += order.capacity() * sizeof(uint32_t);
+        stats.indexBytes += m_bitmaps.MemoryBytes();
+
+        stats.expandedBytes = m_items.size() * sizeof(GameEntry);
+        for (size_t i = 0; i < m_items.size(); ++i)
+        {
+            const GameRecord &rec = m_records[i];
+            stats.expandedBytes += HeapBytes(Name(i).size());
+
+            if (!rec.detailsLoaded)
+            {
+                // Not decoded yet, but it would be in the expanded form
+                if (!m_file.IsOpen())
+                    continue;
+                const LibraryRecord r = m_file.Record(rec.sourceRecord);
+                stats.expandedBytes += HeapBytes(r.description.length);
+                for (int p = 0; p < (int)GamePath::Count; ++p)
+                    stats.expandedBytes += HeapBytes(SourcePath(r, (GamePath)p).length);
+                continue;
+            }
+
+            stats.expandedBytes += HeapBytes(m_strings.Get(rec.description).size());
+            for (const PathRef &path : rec.paths)
+                stats.expandedBytes += HeapBytes(m_strings.Get(path.dir).size() + m_strings.Get(path.leaf).size());
+        }
+        return stats;
+    }
+
+} // namespace Core
@@ -0,0 +1,219 @@
+#ifndef GAMELIBRARY_H
+#define GAMELIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/GameEntry.h"
+#include "Core/LibraryFile.h"
+#include "Core/RowBitmap.h"
+#include "Core/StringArena.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    enum class GamePath : uint8_t
+    {
+        Exe,
+        Setup,
+        Install,
+        Iso,
+        RootOverride,
+        Count
+    };
+
+    // Dense per-game row read by the list and the filters every frame
+    struct GameListItem
+    {
+        StringArena::Ref name;
+        StringArena::Ref collation; // Lowercased name; the same string as name when it has no capitals
+        uint8_t platform;
+        uint8_t status;
+        uint16_t reserved;
+    };
+
+    // Paths are split at the last separator so games in one folder share the directory string
+    struct PathRef
+    {
+        StringArena::Ref dir;
+        StringArena::Ref leaf;
+    };
+
+    // Everything else, bit-packed
+    struct GameRecord
+    {
+        uint64_t id;
+        StringArena::Ref tags; // One per line; read eagerly so the bitmaps never touch the mapping
+        StringArena::Ref description;
+        PathRef paths[(int)GamePath::Count];
+        int32_t ramKB;
+        int32_t mips;
+        uint16_t width;
+        uint16_t height;
+        uint32_t machine : 1;
+        uint32_t windowFlags : 3; // bit 0 = windowed, 1 = maximized, 2 = fullscreen
+        uint32_t audioMask : 6;
+        uint32_t videoHwIdx : 3;
+        uint32_t depth : 8;
+        uint32_t detailsLoaded : 1; // 0 = description & paths still in games.bin at sourceRecord
+        uint32_t sourceRecord;
+    };
+
+    // Columns the library table can be ordered by
+    enum class SortColumn : uint8_t
+    {
+        Name,
+        Platform,
+        Status,
+        RamKB,
+        Mips,
+        Count
+    };
+
+    // Row sets over current positions for every enum value and tag, so
+    // filters combine with And/Or instead of testing each entry
+    struct LibraryBitmaps
+    {
+        RowBitmap all;
+        RowBitmap platform[3];
+        RowBitmap status[2];
+        RowBitmap machine[2];
+        RowBitmap videoHw[6];
+        std::vector<std::string> tags;  // Distinct, case-insensitively sorted (first spelling seen)
+        std::vector<RowBitmap> tagRows; // Parallel to tags
+
+        size_t MemoryBytes() const;
+    };
+
+    // <-- In-Memory Library -->
+    // Compact replacement for std::vector<GameEntry>: a hot array for the list,
+    // bit-packed records for the rest, and all text interned in one arena.
+    // GameEntry is only materialised (Get) for the entry being shown, edited,
+    // launched or written out.
+    //
+    // When opened from games.bin, descriptions and paths stay in the file
+    // mapping until an entry is first materialised.
+    class GameLibrary
+    {
+    public:
+        struct MemoryStats
+        {
+            size_t games = 0;
+            size_t hotBytes = 0;       // GameListItem array
+            size_t recordBytes = 0;    // GameRecord array
+            size_t arenaBytes = 0;     // Interned text + lookup table
+            size_t arenaStrings = 0;   // Distinct strings
+            size_t indexBytes = 0;     // Id lookup table, cached column orders and bitmaps
+            size_t expandedBytes = 0;  // Same library as std::vector<GameEntry>, for comparison
+
+            size_t Total() const { return hotBytes + recordBytes + arenaBytes + indexBytes; }
+        };
+
+        // Loading
+        bool Open(const fs::path &libraryFile);
+        int ReplayJournal(const fs::path &journalFile);
+        void ReleaseMapping();
+        uint32_t MappedVersion() const { return m_file.Version(); }
+        void Clear();
+
+        // Hot fields
+        size_t Size() const { return m_items.size(); }
+        bool Empty() const { return m_items.empty(); }
+        const GameListItem &Item(size_t idx) const { return m_items[idx]; }
+        std::string_view Name(size_t idx) const { return m_strings.Get(m_items[idx].name); }
+        const char *NameCStr(size_t idx) const { return m_strings.CStr(m_items[idx].name); }
+        GamePlatform Platform(size_t idx) const { return (GamePlatform)m_items[idx].platform; }
+        GameStatus Status(size_t idx) const { return (GameStatus)m_items[idx].status; }
+        int RamKB(size_t idx) const { return m_records[idx].ramKB; }
+        int Mips(size_t idx) const { return m_records[idx].mips; }
+        MachineType Machine(size_t idx) const { return (MachineType)m_records[idx].machine; }
+        int VideoHwIdx(size_t idx) const { return m_records[idx].videoHwIdx; }
+        std::string_view Tags(size_t idx) const { return m_strings.Get(m_records[idx].tags); }
+        uint64_t Id(size_t idx) const { return m_records[idx].id; }
+        void SetId(size_t idx, uint64_t id);
+
+        // Id -> current position, O(1); npos if the id isn't in the library
+        static constexpr size_t npos = (size_t)-1;
+        size_t IndexOf(uint64_t id) const;
+
+        // Full entries
+        GameEntry Get(size_t idx);
+        // As Get(), but reads games.bin for lazy entries instead of loading their details,
+        // and fills `out` in place so a loop over the library reuses its strings
+        void Peek(size_t idx, GameEntry &out) const;
+        void Set(size_t idx, const GameEntry &game);
+        void Append(const GameEntry &game);
+        void Remove(size_t idx);
+        void Reserve(size_t count);
+
+        // Compares without decoding or allocating
+        bool PathEquals(size_t idx, GamePath which, std::string_view path) const;
+        std::string Path(size_t idx, GamePath which);
+        // As Path(), but reads games.bin for lazy entries instead of loading their details;
+        // `out` is reused, so a loop over the library doesn't allocate per row
+        void PeekPath(size_t idx, GamePath which, std::string &out) const;
+
+        // Name, description, exe and install path (which holds the DREAMM folder id), then tags, one per line
+        std::string SearchText(size_t idx) const;
+        void PeekSearchText(size_t idx, std::string &text) const; // Reuses `text`
+
+        // Ordering (case-insensitive by name, compared on the cached collation keys)
+        static bool NameLess(std::string_view a, std::string_view b);
+        std::string_view CollationKey(size_t idx) const { return m_strings.Get(m_items[idx].collation); }
+        bool IsSortedByName() const;
+        void SortByName();
+        void MergeSortedTail(size_t first);
+        size_t InsertSorted(const GameEntry &game); // Binary search + one shift; returns the new position
+        size_t Reposition(size_t idx);              // After a rename; returns the new position
+
+        // Positions ordered by a column (ties in name order), cached until the next change
+        const std::vector<uint32_t> &Order(SortColumn column) const;
+
+        // Bumped whenever ids, order or any list, sort or filter field changes
+        uint64_t Revision() const { return m_revision; }
+
+        // Rebuilt in one pass on first use after a Revision() change
+        const LibraryBitmaps &Bitmaps() const;
+
+        // Drops strings no longer referenced (edits leave old values behind)
+        void Repack();
+
+        MemoryStats Memory() const;
+
+    private:
+        void EnsureDetails(size_t idx);
+        void Permute(const std::vector<uint32_t> &order);
+        PathRef InternPath(std::string_view path);
+        std::string JoinPath(const PathRef &ref) const;
+        LibraryStringRef SourcePath(const LibraryRecord &r, GamePath which) const;
+        void RebuildIdIndex() const;
+        void InsertId(size_t idx) const;
+        StringArena::Ref Collate(std::string_view name);
+        bool KeyLess(size_t a, size_t b) const { return CollationKey(a) < CollationKey(b); }
+
+        std::vector<GameListItem> m_items;
+        std::vector<GameRecord> m_records;
+        StringArena m_strings;
+
+        // Open-addressed id index: slot holds position + 1, 0 = free. Reordering
+        // marks it stale and the next lookup rebuilds it in one pass.
+        mutable std::vector<uint32_t> m_idSlots;
+        mutable bool m_idIndexStale = true;
+
+        uint64_t m_revision = 1;
+        mutable std::vector<uint32_t> m_orders[(int)SortColumn::Count];
+        mutable uint64_t m_orderRevision[(int)SortColumn::Count] = {};
+        mutable LibraryBitmaps m_bitmaps;
+        mutable uint64_t m_bitmapsRevision = 0;
+
+        LibraryFile m_file; // Stays mapped while any record has detailsLoaded == 0
+    };
+
+} // namespace Core
+
+#endif // GAMELIBRARY_H
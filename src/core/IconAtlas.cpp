@@ -0,0 +1,351 @@
+#include "pch.h"
+#include "Core/IconAtlas.h"
+#include "Core/ExecutableInfo.h"
+#include "Core/MappedFile.h"
+#include "Core/TextFold.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Core
+{
+
+    static const char ICON_CACHE_MAGIC[8] = {'M', 'O', 'R', 'T', 'I', 'C', 'O', '\0'};
+
+    // FNV-1a, to spot icons shared between executables
+    static uint64_t HashPixels(const std::vector<uint8_t> &pixels)
+    {
+        uint64_t hash = 1469598103934665603ull;
+        for (uint8_t byte : pixels)
+            hash = (hash ^ byte) * 1099511628211ull;
+        return hash;
+    }
+
+    IconAtlas::~IconAtlas()
+    {
+        Stop();
+    }
+
+    // <-- Cache File -->
+    bool IconAtlas::Load(const fs::path &cacheFile)
+    {
+        MappedFile file;
+        if (!file.Open(cacheFile) || file.Size() < sizeof(IconCacheHeader))
+            return false;
+
+        const uint8_t *base = file.Data();
+        IconCacheHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, ICON_CACHE_MAGIC, sizeof(ICON_CACHE_MAGIC)) != 0 ||
+            header.version != VERSION || header.iconSize != ICON_SIZE)
+            return false;
+
+        size_t pixelsEnd = sizeof(header) + (size_t)header.iconCount * ICON_BYTES;
+        if (header.iconCount > (uint32_t)(MAX_PAGES * CELLS_PER_PAGE) || pixelsEnd > file.Size() ||
+            header.recordsOffset < pixelsEnd || header.recordsOffset > file.Size())
+            return false;
+
+        m_pixels.reserve(header.iconCount);
+        for (uint32_t i = 0; i < header.iconCount; ++i)
+        {
+            const uint8_t *icon = base + sizeof(header) + i * ICON_BYTES;
+            m_pixels.emplace_back(icon, icon + ICON_BYTES);
+            m_iconByHash.emplace(HashPixels(m_pixels.back()), (int32_t)i);
+        }
+
+        size_t offset = header.recordsOffset;
+        m_entries.reserve(header.recordCount);
+        m_entryByPath.reserve(header.recordCount);
+        for (uint32_t i = 0; i < header.recordCount; ++i)
+        {
+            IconCacheRecord record;
+            if (file.Size() - offset < sizeof(record))
+                break;
+            std::memcpy(&record, base + offset, sizeof(record));
+            offset += sizeof(record);
+            if (file.Size() - offset < record.pathLength)
+                break;
+
+            Entry entry;
+            entry.fileSize = record.fileSize;
+            entry.writeTime = record.writeTime;
+            entry.icon = (record.icon >= 0 && (uint32_t)record.icon < header.iconCount) ? record.icon : -1;
+            entry.cached = true;
+            auto inserted = m_entryByPath.emplace(std::string(reinterpret_cast<const char *>(base + offset), record.pathLength),
+                                                  (int32_t)m_entries.size());
+            if (inserted.second)
+                m_entries.push_back(entry);
+            offset += record.pathLength;
+        }
+
+        SDL_Log("Loaded %d cached icons for %d executables.", (int)m_pixels.size(), (int)m_entries.size());
+        return true;
+    }
+
+    // Only what a worker has actually looked at, for executables still in the
+    // library; icons nothing refers to any more are dropped and the rest renumbered
+    std::string IconAtlas::Serialize(const GameLibrary &library)
+    {
+        MarkLive(library);
+
+        std::vector<int32_t> savedIcon(m_pixels.size(), -1);
+        int32_t iconCount = 0;
+        uint32_t recordCount = 0;
+        for (const auto &it : m_entryByPath)
+        {
+            const Entry &entry = m_entries[it.second];
+            if (!entry.cached || !m_live[it.second])
+                continue;
+            recordCount++;
+            if (entry.icon >= 0 && savedIcon[entry.icon] < 0)
+                savedIcon[entry.icon] = iconCount++;
+        }
+
+        IconCacheHeader header = {};
+        std::memcpy(header.magic, ICON_CACHE_MAGIC, sizeof(ICON_CACHE_MAGIC));
+        header.version = VERSION;
+        header.iconSize = ICON_SIZE;
+        header.iconCount = (uint32_t)iconCount;
+        header.recordCount = recordCount;
+        header.recordsOffset = sizeof(header) + (size_t)iconCount * ICON_BYTES;
+
+        std::string contents;
+        contents.reserve(header.recordsOffset + recordCount * (sizeof(IconCacheRecord) + 64));
+        contents.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (size_t icon = 0; icon < m_pixels.size(); ++icon)
+        {
+            // Renumbering keeps the order, so the saved icons go out in it
+            if (savedIcon[icon] >= 0)
+                contents.append(reinterpret_cast<const char *>(m_pixels[icon].data()), m_pixels[icon].size());
+        }
+
+        for (const auto &it : m_entryByPath)
+        {
+            const Entry &entry = m_entries[it.second];
+            if (!entry.cached || !m_live[it.second])
+                continue;
+
+            IconCacheRecord record;
+            record.fileSize = entry.fileSize;
+            record.writeTime = entry.writeTime;
+            record.icon = entry.icon >= 0 ? savedIcon[entry.icon] : -1;
+            record.pathLength = (uint32_t)it.first.size();
+            contents.append(reinterpret_cast<const char *>(&record), sizeof(record));
+            contents.append(it.first);
+        }
+        return contents;
+    }
+
+    // Rebuilt once per library revision, not on every save
+    void IconAtlas::MarkLive(const GameLibrary &library)
+    {
+        if (m_liveRevision != library.Revision())
+        {
+            m_liveRevision = library.Revision();
+            m_live.assign(m_entries.size(), 0);
+            for (size_t i = 0; i < library.Size(); ++i)
+            {
+                library.PeekPath(i, GamePath::Exe, m_path);
+                if (m_path.empty())
+                    continue;
+                FoldPathInto(m_path, m_key);
+                auto it = m_entryByPath.find(m_key);
+                if (it != m_entryByPath.end())
+                    m_live[it->second] = 1;
+            }
+        }
+
+        // Entries added since came from Lookup(), so from the library as it is
+        m_live.resize(m_entries.size(), 1);
+    }
+
+    bool IconAtlas::TakeDirty()
+    {
+        bool dirty = m_dirty;
+        m_dirty = false;
+        return dirty;
+    }
+
+    // <-- UI Thread -->
+    // Folds and hashes the path once per position and library revision
+    int32_t IconAtlas::EntryFor(const GameLibrary &library, size_t idx)
+    {
+        library.PeekPath(idx, GamePath::Exe, m_path);
+        if (m_path.empty())
+            return -1;
+
+        FoldPathInto(m_path, m_key);
+        auto it = m_entryByPath.find(m_key);
+        if (it == m_entryByPath.end())
+        {
+            it = m_entryByPath.emplace(m_key, (int32_t)m_entries.size()).first;
+            m_entries.emplace_back();
+        }
+
+        Entry &entry = m_entries[it->second];
+        if (!entry.checked)
+        {
+            entry.checked = true;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_jobs.push_back(Job{it->second, m_path, entry.fileSize, entry.writeTime, entry.cached});
+            }
+            m_wake.notify_one();
+
+            if (m_workers.empty())
+            {
+                size_t workers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+                for (size_t i = 0; i < workers; ++i)
+                    m_workers.emplace_back(&IconAtlas::WorkerMain, this);
+            }
+        }
+        return it->second;
+    }
+
+    bool IconAtlas::Lookup(const GameLibrary &library, size_t idx, IconRef &out)
+    {
+        if (m_rowsRevision != library.Revision())
+        {
+            m_rowsRevision = library.Revision();
+            m_entryOfRow.assign(library.Size(), ROW_UNRESOLVED);
+        }
+
+        int32_t &row = m_entryOfRow[idx];
+        if (row == ROW_UNRESOLVED)
+            row = EntryFor(library, idx);
+        if (row < 0)
+            return false;
+
+        const Entry &entry = m_entries[row];
+        if (entry.icon < 0 || entry.icon >= m_uploaded)
+            return false;
+
+        // Half a texel in from the cell edges, so filtering never samples a neighbour
+        const float texels = (float)(PAGE_CELLS * ICON_SIZE);
+        int cell = entry.icon % CELLS_PER_PAGE;
+        float x = (float)((cell % PAGE_CELLS) * ICON_SIZE);
+        float y = (float)((cell / PAGE_CELLS) * ICON_SIZE);
+        out.texture = (ImTextureID)(intptr_t)m_pages[entry.icon / CELLS_PER_PAGE];
+        out.uv0 = ImVec2((x + 0.5f) / texels, (y + 0.5f) / texels);
+        out.uv1 = ImVec2((x + ICON_SIZE - 0.5f) / texels, (y + ICON_SIZE - 0.5f) / texels);
+        return true;
+    }
+
+    int32_t IconAtlas::AddIcon(std::vector<uint8_t> pixels)
+    {
+        uint64_t hash = HashPixels(pixels);
+        auto existing = m_iconByHash.find(hash);
+        if (existing != m_iconByHash.end() && m_pixels[existing->second] == pixels)
+            return existing->second;
+
+        if (m_pixels.size() >= (size_t)(MAX_PAGES * CELLS_PER_PAGE))
+            return -1;
+
+        int32_t icon = (int32_t)m_pixels.size();
+        m_pixels.push_back(std::move(pixels));
+        m_iconByHash.emplace(hash, icon);
+        return icon;
+    }
+
+    void IconAtlas::Update()
+    {
+        std::vector<Result> results;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            results.swap(m_results);
+        }
+
+        for (Result &result : results)
+        {
+            if (result.unchanged)
+                continue;
+
+            Entry &entry = m_entries[result.entry];
+            entry.fileSize = result.fileSize;
+            entry.writeTime = result.writeTime;
+            entry.icon = result.hasIcon ? AddIcon(std::move(result.pixels)) : -1;
+            entry.cached = true;
+            m_dirty = true;
+        }
+
+        if (m_uploaded >= (int32_t)m_pixels.size())
+            return;
+
+        GLint previous = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+        for (; m_uploaded < (int32_t)m_pixels.size(); ++m_uploaded)
+        {
+            size_t page = m_uploaded / CELLS_PER_PAGE;
+            if (page >= m_pages.size())
+            {
+                GLuint texture = 0;
+                glGenTextures(1, &texture);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PAGE_CELLS * ICON_SIZE, PAGE_CELLS * ICON_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+                m_pages.push_back(texture);
+            }
+
+            int cell = m_uploaded % CELLS_PER_PAGE;
+            glBindTexture(GL_TEXTURE_2D, m_pages[page]);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, (cell % PAGE_CELLS) * ICON_SIZE, (cell / PAGE_CELLS) * ICON_SIZE,
+                            ICON_SIZE, ICON_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, m_pixels[m_uploaded].data());
+        }
+        glBindTexture(GL_TEXTURE_2D, (GLuint)previous);
+    }
+
+    void IconAtlas::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread &worker : m_workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+        m_workers.clear();
+    }
+
+    // <-- Workers -->
+    void IconAtlas::WorkerMain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_stop || !m_jobs.empty(); });
+            if (m_stop)
+                return;
+
+            Job job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            lock.unlock();
+
+            Result result;
+            result.entry = job.entry;
+
+            // A matching size and write time means the cached icon still holds
+            std::error_code ec;
+            uint64_t fileSize = fs::file_size(job.path, ec);
+            auto writeTime = ec ? fs::file_time_type() : fs::last_write_time(job.path, ec);
+            if (!ec)
+            {
+                result.fileSize = fileSize;
+                result.writeTime = (int64_t)writeTime.time_since_epoch().count();
+                result.unchanged = job.cached && job.fileSize == result.fileSize && job.writeTime == result.writeTime;
+                if (!result.unchanged)
+                    result.hasIcon = ExecutableInfo::ReadIcon(job.path, ICON_SIZE, result.pixels);
+            }
+
+            lock.lock();
+            m_results.push_back(std::move(result));
+        }
+    }
+
+} // namespace Core
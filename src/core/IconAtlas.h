@@ -0,0 +1,155 @@
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+#include "Core/GameLibrary.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // <-- On-Disk Layout (icons.cache, little-endian) -->
+    // [Header][Icon pixels: iconCount x ICON_SIZE^2 RGBA][Records: record + path bytes]
+    struct IconCacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t iconSize;
+        uint32_t iconCount;
+        uint32_t recordCount;
+        uint64_t recordsOffset;
+    };
+
+    struct IconCacheRecord
+    {
+        uint64_t fileSize;
+        int64_t writeTime;
+        int32_t icon;        // Index into the icon pixels, -1 = the exe has none
+        uint32_t pathLength; // Folded path bytes follow the record
+    };
+
+    static_assert(sizeof(IconCacheHeader) == 32, "IconCacheHeader layout changed");
+    static_assert(sizeof(IconCacheRecord) == 24, "IconCacheRecord layout changed");
+
+    // Where an icon sits in the atlas
+    struct IconRef
+    {
+        ImTextureID texture;
+        ImVec2 uv0;
+        ImVec2 uv1;
+    };
+
+    // <-- Game Icon Atlas -->
+    // Icons of the games' executables, packed into shared OpenGL textures
+    // (pages of PAGE_CELLS^2 cells of ICON_SIZE texels) so the list draws
+    // them without a texture per row. Identical icons share a cell.
+    //
+    // Lookup() answers from the atlas right away. The first time a path is
+    // seen, a worker pool stats the exe and, unless its size and write time
+    // match the cache, pulls the icon out of its resources. The cache keeps
+    // the decoded pixels, so startup draws every icon without parsing a PE.
+    // Each library position remembers its entry until the library revision
+    // changes, so drawing a row neither folds nor hashes its path; saving
+    // leaves out executables no game points at any more.
+    //
+    // UI thread only, except for the workers; GL calls happen in Update().
+    // The textures go away with the GL context.
+    class IconAtlas
+    {
+    public:
+        static constexpr int ICON_SIZE = 32;
+        static constexpr int PAGE_CELLS = 32;  // 1024 x 1024 texels per page
+        static constexpr int MAX_PAGES = 8;    // 8192 distinct icons
+        static constexpr uint32_t VERSION = 1;
+
+        IconAtlas() = default;
+        ~IconAtlas();
+
+        IconAtlas(const IconAtlas &) = delete;
+        IconAtlas &operator=(const IconAtlas &) = delete;
+
+        bool Load(const fs::path &cacheFile);
+        std::string Serialize(const GameLibrary &library);
+        bool TakeDirty();
+
+        // Uploads new icons and merges worker results; needs the GL context
+        void Update();
+        bool Lookup(const GameLibrary &library, size_t idx, IconRef &out);
+        void Stop();
+
+    private:
+        struct Entry
+        {
+            uint64_t fileSize = 0;
+            int64_t writeTime = 0;
+            int32_t icon = -1;
+            bool cached = false;  // Size & time came from the cache file
+            bool checked = false; // Stat'ed (or queued to be) this session
+        };
+
+        struct Job
+        {
+            int32_t entry;
+            std::string path;
+            uint64_t fileSize;
+            int64_t writeTime;
+            bool cached;
+        };
+
+        struct Result
+        {
+            int32_t entry = -1;
+            uint64_t fileSize = 0;
+            int64_t writeTime = 0;
+            bool unchanged = false;
+            bool hasIcon = false;
+            std::vector<uint8_t> pixels;
+        };
+
+        void WorkerMain();
+        int32_t AddIcon(std::vector<uint8_t> pixels);
+        int32_t EntryFor(const GameLibrary &library, size_t idx);
+        void MarkLive(const GameLibrary &library);
+
+        static constexpr size_t ICON_BYTES = (size_t)ICON_SIZE * ICON_SIZE * 4;
+        static constexpr int CELLS_PER_PAGE = PAGE_CELLS * PAGE_CELLS;
+        static constexpr int32_t ROW_UNRESOLVED = -2; // -1 = the row has no exe
+
+        // UI thread
+        std::vector<Entry> m_entries;
+        std::unordered_map<std::string, int32_t> m_entryByPath; // Folded exe path -> entry
+        std::vector<int32_t> m_entryOfRow; // Per library position, as of m_rowsRevision
+        uint64_t m_rowsRevision = 0;
+        std::vector<uint8_t> m_live; // Per entry: some game's exe, as of m_liveRevision
+        uint64_t m_liveRevision = 0;
+        std::string m_path; // Scratch for resolving a row...
+        std::string m_key;  // ...and its folded path
+        std::vector<std::vector<uint8_t>> m_pixels; // Per icon
+        std::unordered_map<uint64_t, int32_t> m_iconByHash;
+        std::vector<GLuint> m_pages;
+        int32_t m_uploaded = 0; // Icons [0, m_uploaded) are on the GPU
+        bool m_dirty = false;
+
+        // Shared with the workers, under m_mutex
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Job> m_jobs;
+        std::vector<Result> m_results;
+        bool m_stop = false;
+        std::vector<std::thread> m_workers;
+    };
+
+} // namespace Core
+
+#endif // ICONATLAS_H
@@ -0,0 +1,948 @@
+#include "pch.h"
+#include "Core/LibraryExchange.h"
+#include "Core/TextFold.h"
+
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+
+    static const size_t READ_BUFFER_SIZE = 1 << 20;
+
+    // <-- Field Table -->
+    enum ExchangeField
+    {
+        FieldName,
+        FieldDescription,
+        FieldPlatform,
+        FieldStatus,
+        FieldExePath,
+        FieldSetupPath,
+        FieldInstallPath,
+        FieldIsoPath,
+        FieldRootPath,
+        FieldWindowed,
+        FieldMaximized,
+        FieldFullscreen,
+        FieldMachine,
+        FieldRamKB,
+        FieldMips,
+        FieldAudio,
+        FieldVideo,
+        FieldWidth,
+        FieldHeight,
+        FieldDepth,
+        FieldTags,
+        FieldCount
+    };
+
+    enum FieldKind
+    {
+        KindText,
+        KindInt,
+        KindBool,
+        KindAudio,
+        KindTags
+    };
+
+    static const char *FIELD_NAMES[FieldCount] = {
+        "name", "description", "platform", "status", "exe_path", "setup_path", "install_path",
+        "iso_path", "root_path", "windowed", "maximized", "fullscreen", "machine", "ram_kb",
+        "mips", "audio", "video", "width", "height", "depth", "tags"};
+
+    static const FieldKind FIELD_KINDS[FieldCount] = {
+        KindText, KindText, KindText, KindText, KindText, KindText, KindText,
+        KindText, KindText, KindBool, KindBool, KindBool, KindText, KindInt,
+        KindInt, KindAudio, KindText, KindInt, KindInt, KindInt, KindTags};
+
+    static const char *PLATFORM_NAMES[] = {"dos", "windows", "dreamm"};
+    static const char *STATUS_NAMES[] = {"unplayable", "playable"};
+    static const char *MACHINE_NAMES[] = {"pc", "tandy"};
+    static const char *AUDIO_NAMES[6] = {"speaker", "cms", "adlib", "sb16", "mt32", "gmidi"};
+    static const char *VIDEO_NAMES[6] = {"hercules", "cga", "ega", "mcga", "vga", "svga"};
+
+    // <-- Value Parsing -->
+    static std::string_view TrimSpace(std::string_view str)
+    {
+        size_t first = str.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+            return std::string_view();
+        size_t last = str.find_last_not_of(" \t\r\n");
+        return str.substr(first, last - first + 1);
+    }
+
+    static int FieldFromName(std::string_view key)
+    {
+        key = TrimSpace(key);
+        for (int i = 0; i < FieldCount; ++i)
+        {
+            if (EqualsNoCase(key, FIELD_NAMES[i]))
+                return i;
+        }
+        return -1;
+    }
+
+    static bool ParseInt(std::string_view value, int &out)
+    {
+        int parsed = 0;
+        auto result = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (value.empty() || result.ec != std::errc() || result.ptr != value.data() + value.size())
+            return false;
+        out = parsed;
+        return true;
+    }
+
+    // Accepts either a name from `names` or its index
+    static bool ParseEnum(std::string_view value, const char *const *names, int count, int &out)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (EqualsNoCase(value, names[i]))
+            {
+                out = i;
+                return true;
+            }
+        }
+        int idx = 0;
+        if (!ParseInt(value, idx) || idx < 0 || idx >= count)
+            return false;
+        out = idx;
+        return true;
+    }
+
+    static bool ParseBool(std::string_view value, bool &out)
+    {
+        if (value == "1" || EqualsNoCase(value, "true") || EqualsNoCase(value, "yes"))
+            out = true;
+        else if (value == "0" || EqualsNoCase(value, "false") || EqualsNoCase(value, "no"))
+            out = false;
+        else
+            return false;
+        return true;
+    }
+
+    // Device names separated by spaces, commas, semicolons or newlines (JSON arrays)
+    static bool ParseAudio(std::string_view value, bool (&flags)[6])
+    {
+        bool parsed[6] = {false, false, false, false, false, false};
+        size_t pos = 0;
+        while (pos < value.size())
+        {
+            size_t end = value.find_first_of(" ,;\n", pos);
+            if (end == std::string_view::npos)
+                end = value.size();
+
+            std::string_view token = value.substr(pos, end - pos);
+            pos = end + 1;
+            if (token.empty())
+                continue;
+
+            int device = 0;
+            if (!ParseEnum(token, AUDIO_NAMES, 6, device))
+                return false;
+            parsed[device] = true;
+        }
+
+        for (int i = 0; i < 6; i++)
+            flags[i] = parsed[i];
+        return true;
+    }
+
+    // Empty values keep the GameEntry default, except for free text and the
+    // audio list, where empty genuinely means "none"
+    static void ApplyField(GameEntry &g, int field, std::string_view value)
+    {
+        std::string_view trimmed = TrimSpace(value);
+        if ((FIELD_KINDS[field] == KindInt || FIELD_KINDS[field] == KindBool) && trimmed.empty())
+            return;
+
+        int num = 0;
+        switch (field)
+        {
+        case FieldName:
+            g.name.assign(value);
+            break;
+        case FieldDescription:
+            g.description.assign(value);
+            break;
+        case FieldExePath:
+            g.exePath.assign(trimmed);
+            break;
+        case FieldSetupPath:
+            g.setupPath.assign(trimmed);
+            break;
+        case FieldInstallPath:
+            g.installPath.assign(trimmed);
+            break;
+        case FieldIsoPath:
+            g.isoPath.assign(trimmed);
+            break;
+        case FieldRootPath:
+            g.rootPathOverride.assign(trimmed);
+            break;
+        case FieldPlatform:
+            if (ParseEnum(trimmed, PLATFORM_NAMES, 3, num))
+                g.platform = (GamePlatform)num;
+            break;
+        case FieldStatus:
+            if (ParseEnum(trimmed, STATUS_NAMES, 2, num))
+                g.status = (GameStatus)num;
+            break;
+        case FieldMachine:
+            if (ParseEnum(trimmed, MACHINE_NAMES, 2, num))
+                g.machine = (MachineType)num;
+            break;
+        case FieldVideo:
+            if (ParseEnum(trimmed, VIDEO_NAMES, 6, num))
+                g.videoHwIdx = num;
+            break;
+        case FieldWindowed:
+            ParseBool(trimmed, g.forceWindowed);
+            break;
+        case FieldMaximized:
+            ParseBool(trimmed, g.forceMaximized);
+            break;
+        case FieldFullscreen:
+            ParseBool(trimmed, g.forceFullscreen);
+            break;
+        case FieldRamKB:
+            ParseInt(trimmed, g.ramKB);
+            break;
+        case FieldMips:
+            ParseInt(trimmed, g.mips);
+            break;
+        case FieldWidth:
+            ParseInt(trimmed, g.width);
+            break;
+        case FieldHeight:
+            ParseInt(trimmed, g.height);
+            break;
+        case FieldDepth:
+            ParseInt(trimmed, g.depth);
+            break;
+        case FieldAudio:
+            ParseAudio(trimmed, g.audioFlags);
+            break;
+        case FieldTags:
+            g.tags = SplitTags(value);
+            break;
+        }
+    }
+
+    // <-- Value Formatting -->
+    static void AppendFieldText(std::string &out, const GameEntry &g, int field)
+    {
+        switch (field)
+        {
+        case FieldName:
+            out += g.name;
+            break;
+        case FieldDescription:
+            out += g.description;
+            break;
+        case FieldExePath:
+            out += g.exePath;
+            break;
+        case FieldSetupPath:
+            out += g.setupPath;
+            break;
+        case FieldInstallPath:
+            out += g.installPath;
+            break;
+        case FieldIsoPath:
+            out += g.isoPath;
+            break;
+        case FieldRootPath:
+            out += g.rootPathOverride;
+            break;
+        case FieldPlatform:
+            out += PLATFORM_NAMES[(int)g.platform < 3 ? (int)g.platform : 0];
+            break;
+        case FieldStatus:
+            out += STATUS_NAMES[g.status == GameStatus::Playable ? 1 : 0];
+            break;
+        case FieldMachine:
+            out += MACHINE_NAMES[g.machine == MachineType::Tandy ? 1 : 0];
+            break;
+        case FieldVideo:
+            out += VIDEO_NAMES[(g.videoHwIdx >= 0 && g.videoHwIdx < 6) ? g.videoHwIdx : 5];
+            break;
+        case FieldWindowed:
+            out += g.forceWindowed ? '1' : '0';
+            break;
+        case FieldMaximized:
+            out += g.forceMaximized ? '1' : '0';
+            break;
+        case FieldFullscreen:
+            out += g.forceFullscreen ? '1' : '0';
+            break;
+        case FieldRamKB:
+            out += std::to_string(g.ramKB);
+            break;
+        case FieldMips:
+            out += std::to_string(g.mips);
+            break;
+        case FieldWidth:
+            out += std::to_string(g.width);
+            break;
+        case FieldHeight:
+            out += std::to_string(g.height);
+            break;
+        case FieldDepth:
+            out += std::to_string(g.depth);
+            break;
+        case FieldTags:
+            out += JoinTags(g.tags, "; ");
+            break;
+        case FieldAudio:
+            for (int i = 0, n = 0; i < 6; i++)
+            {
+                if (!g.audioFlags[i])
+                    continue;
+                if (n++ > 0)
+                    out += ' ';
+                out += AUDIO_NAMES[i];
+            }
+            break;
+        }
+    }
+
+    // <-- CSV -->
+    static void AppendCsvField(std::string &out, std::string_view value)
+    {
+        bool needsQuotes = value.find_first_of(",\"\r\n") != std::string_view::npos ||
+                           (!value.empty() && (value.front() == ' ' || value.back() == ' '));
+        if (!needsQuotes)
+        {
+            out += value;
+            return;
+        }
+
+        out += '"';
+        for (char c : value)
+        {
+            if (c == '"')
+                out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+    // RFC 4180 reader fed in arbitrary slices; quoted fields may span reads and lines
+    class CsvReader
+    {
+    public:
+        using RecordHandler = std::function<void(std::vector<std::string> &record)>;
+
+        explicit CsvReader(RecordHandler onRecord) : m_onRecord(std::move(onRecord)) {}
+
+        void Feed(const char *data, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                char c = data[i];
+                if (m_inQuotes)
+                {
+                    if (c == '"')
+                    {
+                        m_inQuotes = false;
+                        m_afterQuote = true;
+                    }
+                    else
+                    {
+                        m_field += c;
+                    }
+                    continue;
+                }
+
+                if (m_afterQuote && c == '"')
+                {
+                    // Doubled quote inside a quoted field
+                    m_field += '"';
+                    m_inQuotes = true;
+                    m_afterQuote = false;
+                    continue;
+                }
+                m_afterQuote = false;
+
+                if (c == ',')
+                    EndField();
+                else if (c == '\n')
+                    EndRecord();
+                else if (c == '"' && m_field.empty())
+                    m_inQuotes = true;
+                else if (c != '\r')
+                    m_field += c;
+            }
+        }
+
+        // Returns false if the input ended inside a quoted field
+        bool Finish()
+        {
+            bool ok = !m_inQuotes;
+            if (ok && (!m_field.empty() || !m_record.empty()))
+                EndRecord();
+            m_field.clear();
+            m_record.clear();
+            m_inQuotes = false;
+            return ok;
+        }
+
+    private:
+        void EndField()
+        {
+            m_record.push_back(std::move(m_field));
+            m_field.clear();
+        }
+
+        void EndRecord()
+        {
+            EndField();
+            // Blank lines are not records
+            if (m_record.size() > 1 || !m_record[0].empty())
+                m_onRecord(m_record);
+            m_record.clear();
+        }
+
+        RecordHandler m_onRecord;
+        std::vector<std::string> m_record;
+        std::string m_field;
+        bool m_inQuotes = false;
+        bool m_afterQuote = false;
+    };
+
+    // <-- JSON Lines -->
+    static void AppendJsonString(std::string &out, std::string_view value)
+    {
+        static const char HEX[] = "0123456789abcdef";
+        out += '"';
+        for (char c : value)
+        {
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if ((unsigned char)c < 0x20)
+                {
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0xF];
+                    out += HEX[c & 0xF];
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+        out += '"';
+    }
+
+    static void AppendUtf8(std::string &out, uint32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out += (char)cp;
+        }
+        else if (cp < 0x800)
+        {
+            out += (char)(0xC0 | (cp >> 6));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            out += (char)(0xE0 | (cp >> 12));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            out += (char)(0xF0 | (cp >> 18));
+            out += (char)(0x80 | ((cp >> 12) & 0x3F));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // Parses one flat JSON object. Scalars are reported as text (true/false as
+    // 1/0, null as empty), arrays of scalars are joined with spaces and nested
+    // objects come through empty.
+    class JsonLineParser
+    {
+    public:
+        explicit JsonLineParser(std::string_view text) : m_text(text) {}
+
+        template <typename Fn>
+        bool ParseObject(Fn &&onMember)
+        {
+            SkipSpace();
+            if (!Consume('{'))
+                return false;
+
+            std::string key, value;
+            SkipSpace();
+            if (Consume('}'))
+                return AtEnd();
+
+            for (;;)
+            {
+                SkipSpace();
+                if (!ParseString(key))
+                    return false;
+                SkipSpace();
+                if (!Consume(':'))
+                    return false;
+                SkipSpace();
+                if (!ParseValue(value))
+                    return false;
+                onMember(key, value);
+
+                SkipSpace();
+                if (Consume(','))
+                    continue;
+                if (Consume('}'))
+                    return AtEnd();
+                return false;
+            }
+        }
+
+    private:
+        void SkipSpace()
+        {
+            while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\r'))
+                m_pos++;
+        }
+
+        bool Consume(char c)
+        {
+            if (m_pos < m_text.size() && m_text[m_pos] == c)
+            {
+                m_pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool AtEnd()
+        {
+            SkipSpace();
+            return m_pos == m_text.size();
+        }
+
+        bool ParseHex4(uint32_t &out)
+        {
+            if (m_text.size() - m_pos < 4)
+                return false;
+            out = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                char c = m_text[m_pos++];
+                out <<= 4;
+                if (c >= '0' && c <= '9')
+                    out |= c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    out |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    out |= c - 'A' + 10;
+                else
+                    return false;
+            }
+            return true;
+        }
+
+        bool ParseString(std::string &out)
+        {
+            out.clear();
+            if (!Consume('"'))
+                return false;
+
+            while (m_pos < m_text.size())
+            {
+                char c = m_text[m_pos++];
+                if (c == '"')
+                    return true;
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+
+                if (m_pos >= m_text.size())
+                    return false;
+                char esc = m_text[m_pos++];
+                switch (esc)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    out += esc;
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u':
+                {
+                    uint32_t cp = 0;
+                    if (!ParseHex4(cp))
+                        return false;
+                    if (cp >= 0xD800 && cp <= 0xDBFF)
+                    {
+                        // Surrogate pair
+                        uint32_t low = 0;
+                        if (!Consume('\\') || !Consume('u') || !ParseHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                            return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    AppendUtf8(out, cp);
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        bool ParseScalar(std::string &out)
+        {
+            out.clear();
+            if (m_pos < m_text.size() && m_text[m_pos] == '"')
+                return ParseString(out);
+
+            size_t start = m_pos;
+            while (m_pos < m_text.size() && std::string_view(",}] \t\r").find(m_text[m_pos]) == std::string_view::npos)
+                m_pos++;
+
+            std::string_view token = m_text.substr(start, m_pos - start);
+            if (token == "true")
+                out = "1";
+            else if (token == "false")
+                out = "0";
+            else if (token == "null")
+                out.clear();
+            else if (!token.empty() && (token[0] == '-' || (token[0] >= '0' && token[0] <= '9')))
+                out.assign(token);
+            else
+                return false;
+            return true;
+        }
+
+        // Nested objects are not part of the format; skip them so extra metadata doesn't reject the line
+        bool SkipObject()
+        {
+            std::string ignored;
+            int depth = 0;
+            while (m_pos < m_text.size())
+            {
+                char c = m_text[m_pos];
+                if (c == '"')
+                {
+                    if (!ParseString(ignored))
+                        return false;
+                    continue;
+                }
+                m_pos++;
+                if (c == '{' || c == '[')
+                    depth++;
+                else if ((c == '}' || c == ']') && --depth == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        bool ParseValue(std::string &out)
+        {
+            if (m_pos < m_text.size() && m_text[m_pos] == '{')
+            {
+                out.clear();
+                return SkipObject();
+            }
+            if (!Consume('['))
+                return ParseScalar(out);
+
+            out.clear();
+            std::string item;
+            SkipSpace();
+            if (Consume(']'))
+                return true;
+
+            for (;;)
+            {
+                SkipSpace();
+                if (!ParseScalar(item))
+                    return false;
+                if (!out.empty())
+                    out += '\n'; // Items may contain spaces (tags)
+                out += item;
+
+                SkipSpace();
+                if (Consume(','))
+                    continue;
+                return Consume(']');
+            }
+        }
+
+        std::string_view m_text;
+        size_t m_pos = 0;
+    };
+
+    // <-- Import -->
+    // Collects parsed entries and hands them over BATCH_SIZE at a time
+    class BatchSink
+    {
+    public:
+        BatchSink(const LibraryExchange::BatchHandler &onBatch) : m_onBatch(onBatch)
+        {
+            m_batch.reserve(LibraryExchange::BATCH_SIZE);
+        }
+
+        void Push(GameEntry &&game)
+        {
+            m_batch.push_back(std::move(game));
+            if (m_batch.size() >= LibraryExchange::BATCH_SIZE)
+                Flush();
+        }
+
+        void Flush()
+        {
+            if (m_batch.empty())
+                return;
+            m_onBatch(m_batch);
+            m_batch.clear();
+        }
+
+    private:
+        const LibraryExchange::BatchHandler &m_onBatch;
+        std::vector<GameEntry> m_batch;
+    };
+
+    bool LibraryExchange::Import(const fs::path &path, ExchangeFormat format, const BatchHandler &onBatch, ImportStats *stats)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        ImportStats local;
+        BatchSink sink(onBatch);
+
+        // CSV: the first record is the header and decides the column order
+        std::vector<int> columns;
+        bool haveHeader = false;
+        CsvReader csv([&](std::vector<std::string> &record)
+                      {
+            if (!haveHeader)
+            {
+                for (const auto &name : record)
+                    columns.push_back(FieldFromName(name));
+                haveHeader = true;
+                return;
+            }
+
+            GameEntry g;
+            for (size_t i = 0; i < record.size() && i < columns.size(); ++i)
+            {
+                if (columns[i] >= 0)
+                    ApplyField(g, columns[i], record[i]);
+            }
+            sink.Push(std::move(g));
+            local.records++; });
+
+        // JSON Lines: one object per line; lines may straddle read buffers
+        std::string pendingLine;
+        auto processJsonLine = [&](std::string_view line)
+        {
+            if (TrimSpace(line).empty())
+                return;
+
+            GameEntry g;
+            JsonLineParser parser(line);
+            bool ok = parser.ParseObject([&](const std::string &key, const std::string &value)
+                                         {
+                int field = FieldFromName(key);
+                if (field >= 0)
+                    ApplyField(g, field, value); });
+            if (!ok)
+            {
+                local.skipped++;
+                return;
+            }
+            sink.Push(std::move(g));
+            local.records++;
+        };
+
+        std::vector<char> buffer(READ_BUFFER_SIZE);
+        bool firstRead = true;
+        while (file)
+        {
+            file.read(buffer.data(), buffer.size());
+            size_t got = (size_t)file.gcount();
+            if (got == 0)
+                break;
+
+            const char *data = buffer.data();
+            if (firstRead && got >= 3 && std::string_view(data, 3) == "\xEF\xBB\xBF")
+            {
+                // UTF-8 BOM
+                data += 3;
+                got -= 3;
+            }
+            firstRead = false;
+
+            if (format == ExchangeFormat::Csv)
+            {
+                csv.Feed(data, got);
+                continue;
+            }
+
+            std::string_view chunk(data, got);
+            size_t start = 0;
+            for (size_t nl = chunk.find('\n'); nl != std::string_view::npos; nl = chunk.find('\n', start))
+            {
+                if (pendingLine.empty())
+                {
+                    processJsonLine(chunk.substr(start, nl - start));
+                }
+                else
+                {
+                    pendingLine.append(chunk.substr(start, nl - start));
+                    processJsonLine(pendingLine);
+                    pendingLine.clear();
+                }
+                start = nl + 1;
+            }
+            pendingLine.append(chunk.substr(start));
+        }
+
+        if (format == ExchangeFormat::Csv)
+        {
+            if (!csv.Finish())
+                local.skipped++;
+        }
+        else
+        {
+            processJsonLine(pendingLine);
+        }
+        sink.Flush();
+
+        if (stats)
+            *stats = local;
+        return true;
+    }
+
+    // <-- Export -->
+    void LibraryExchange::AppendHeader(std::string &out, ExchangeFormat format)
+    {
+        if (format != ExchangeFormat::Csv)
+            return;
+
+        for (int f = 0; f < FieldCount; ++f)
+        {
+            if (f > 0)
+                out += ',';
+            out += FIELD_NAMES[f];
+        }
+        out += "\r\n";
+    }
+
+    void LibraryExchange::AppendRecord(std::string &out, ExchangeFormat format, const GameEntry &g)
+    {
+        std::string value;
+
+        if (format == ExchangeFormat::Csv)
+        {
+            for (int f = 0; f < FieldCount; ++f)
+            {
+                if (f > 0)
+                    out += ',';
+                value.clear();
+                AppendFieldText(value, g, f);
+                AppendCsvField(out, value);
+            }
+            out += "\r\n";
+            return;
+        }
+
+        out += '{';
+        for (int f = 0; f < FieldCount; ++f)
+        {
+            if (f > 0)
+                out += ',';
+            out += '"';
+            out += FIELD_NAMES[f];
+            out += "\":";
+
+            value.clear();
+            AppendFieldText(value, g, f);
+            switch (FIELD_KINDS[f])
+            {
+            case KindInt:
+                out += value;
+                break;
+            case KindBool:
+                out += (value == "1") ? "true" : "false";
+                break;
+            case KindTags:
+            {
+                out += '[';
+                for (size_t t = 0; t < g.tags.size(); ++t)
+                {
+                    if (t > 0)
+                        out += ',';
+                    AppendJsonString(out, g.tags[t]);
+                }
+                out += ']';
+                break;
+            }
+            case KindAudio:
+            {
+                out += '[';
+                size_t pos = 0;
+                while (pos < value.size())
+                {
+                    size_t end = value.find(' ', pos);
+                    if (end == std::string::npos)
+                        end = value.size();
+                    if (pos > 0)
+                        out += ',';
+                    AppendJsonString(out, std::string_view(value).substr(pos, end - pos));
+                    pos = end + 1;
+                }
+                out += ']';
+                break;
+            }
+            default:
+                AppendJsonString(out, value);
+            }
+        }
+        out += "}\n";
+    }
+
+} // namespace Core
@@ -0,0 +1,56 @@
+#ifndef LIBRARYEXCHANGE_H
+#define LIBRARYEXCHANGE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Core/GameEntry.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    enum class ExchangeFormat
+    {
+        Csv,
+        JsonLines
+    };
+
+    // <-- Bulk Import / Export (CSV, JSON Lines) -->
+    // Both formats use the same column / key names:
+    //   name, description, platform, status, exe_path, setup_path, install_path,
+    //   iso_path, root_path, windowed, maximized, fullscreen, machine, ram_kb,
+    //   mips, audio, video, width, height, depth, tags
+    // Enums are written by name ("dos", "playable", "tandy", "svga"), audio as a
+    // space-separated device list and tags as a "; "-separated list (both string
+    // arrays in JSON). Missing columns keep
+    // GameEntry defaults and unknown ones are ignored.
+    //
+    // Import streams the file through a fixed read buffer and hands records to
+    // the caller in batches, so memory stays bounded by BATCH_SIZE, not file size.
+    // Export is the caller's loop: a header, then records appended a batch at a
+    // time, so only one batch of text is ever held.
+    class LibraryExchange
+    {
+    public:
+        static constexpr size_t BATCH_SIZE = 4096;
+
+        struct ImportStats
+        {
+            int records = 0;
+            int skipped = 0; // Malformed records (bad JSON, unterminated quotes)
+        };
+
+        using BatchHandler = std::function<void(std::vector<GameEntry> &batch)>;
+
+        static bool Import(const fs::path &path, ExchangeFormat format, const BatchHandler &onBatch, ImportStats *stats = nullptr);
+        static void AppendHeader(std::string &out, ExchangeFormat format); // CSV column names; nothing for JSON Lines
+        static void AppendRecord(std::string &out, ExchangeFormat format, const GameEntry &game);
+    };
+
+} // namespace Core
+
+#endif // LIBRARYEXCHANGE_H
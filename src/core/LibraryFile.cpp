@@ -0,0 +1,237 @@
+#include "pch.h"
+#include "Core/LibraryFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace Core
+{
+
+    static const char LIBRARY_MAGIC[8] = {'M', 'O', 'R', 'T', 'L', 'I', 'B', '\0'};
+
+    // <-- String Pool Builder -->
+    // Identical strings (empty paths, shared descriptions) are stored once.
+    class StringPoolBuilder
+    {
+    public:
+        StringPoolBuilder()
+        {
+            m_pool.push_back('\0'); // Offset 0 is always the empty string
+        }
+
+        LibraryStringRef Add(const std::string &str)
+        {
+            if (str.empty())
+                return {0, 0};
+
+            auto it = m_offsets.find(str);
+            if (it != m_offsets.end())
+                return {it->second, (uint32_t)str.size()};
+
+            uint32_t offset = (uint32_t)m_pool.size();
+            m_pool.insert(m_pool.end(), str.begin(), str.end());
+            m_pool.push_back('\0');
+            m_offsets.emplace(str, offset);
+            return {offset, (uint32_t)str.size()};
+        }
+
+        const std::vector<char> &Data() const { return m_pool; }
+
+    private:
+        std::vector<char> m_pool;
+        std::unordered_map<std::string, uint32_t> m_offsets;
+    };
+
+    // <-- Reading -->
+    bool LibraryFile::Open(const fs::path &path)
+    {
+        Close();
+
+        if (!m_file.Open(path))
+            return false;
+
+        if (!Validate())
+        {
+            SDL_Log("Library file '%s' is invalid or from an unknown version.", path.string().c_str());
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void LibraryFile::Close()
+    {
+        m_file.Close();
+        m_records = nullptr;
+        m_version = 0;
+        m_recordSize = 0;
+        m_recordCount = 0;
+        m_strings = nullptr;
+        m_stringsSize = 0;
+    }
+
+    bool LibraryFile::Validate()
+    {
+        const uint8_t *base = m_file.Data();
+        const uint64_t size = m_file.Size();
+
+        if (size < sizeof(LibraryFileHeader))
+            return false;
+
+        LibraryFileHeader header;
+        std::memcpy(&header, base, sizeof(header));
+
+        if (std::memcmp(header.magic, LIBRARY_MAGIC, sizeof(LIBRARY_MAGIC)) != 0)
+            return false;
+        if (header.version < 1 || header.version > VERSION)
+            return false;
+
+        uint32_t minRecordSize = (header.version == 1)   ? LIBRARY_RECORD_SIZE_V1
+                                 : (header.version == 2) ? LIBRARY_RECORD_SIZE_V2
+                                                         : (uint32_t)sizeof(LibraryRecord);
+        if (header.headerSize < sizeof(LibraryFileHeader) || header.recordSize < minRecordSize)
+            return false;
+
+        // Bounds, by subtraction so a corrupt offset or size can't wrap the sum past the check
+        uint64_t tableSize = (uint64_t)header.recordSize * header.recordCount;
+        if (header.recordsOffset < header.headerSize || header.recordsOffset > size || tableSize > size - header.recordsOffset)
+            return false;
+        if (header.stringsOffset > size || header.stringsSize > size - header.stringsOffset || header.stringsSize == 0)
+            return false;
+
+        const char *strings = reinterpret_cast<const char *>(base + header.stringsOffset);
+        if (strings[header.stringsSize - 1] != '\0')
+            return false;
+
+        m_records = base + header.recordsOffset;
+        m_version = header.version;
+        m_recordSize = header.recordSize;
+        m_recordCount = header.recordCount;
+        m_strings = strings;
+        m_stringsSize = header.stringsSize;
+
+        // Every string must lie inside the pool and be terminated
+        for (uint32_t i = 0; i < m_recordCount; ++i)
+        {
+            const LibraryRecord r = Record(i);
+            const LibraryStringRef *refs[] = {&r.name, &r.description, &r.exePath, &r.setupPath,
+                                              &r.installPath, &r.isoPath, &r.rootPathOverride, &r.tags};
+            for (const LibraryStringRef *ref : refs)
+            {
+                if ((uint64_t)ref->offset + ref->length >= m_stringsSize || m_strings[(uint64_t)ref->offset + ref->length] != '\0')
+                {
+                    m_records = nullptr;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    LibraryRecord LibraryFile::Record(uint32_t idx) const
+    {
+        // Copy out so older (shorter) and newer (longer) record layouts read the same way
+        LibraryRecord r = {};
+        std::memcpy(&r, m_records + (size_t)idx * m_recordSize, std::min<size_t>(m_recordSize, sizeof(LibraryRecord)));
+        return r;
+    }
+
+    std::string_view LibraryFile::String(const LibraryStringRef &ref) const
+    {
+        return std::string_view(m_strings + ref.offset, ref.length);
+    }
+
+    void LibraryFile::Decode(uint32_t idx, GameEntry &out) const
+    {
+        const LibraryRecord r = Record(idx);
+
+        out.id = r.id;
+        out.name.assign(String(r.name));
+        out.description.assign(String(r.description));
+        out.exePath.assign(String(r.exePath));
+        out.setupPath.assign(String(r.setupPath));
+        out.installPath.assign(String(r.installPath));
+        out.isoPath.assign(String(r.isoPath));
+        out.rootPathOverride.assign(String(r.rootPathOverride));
+        out.tags = SplitTags(String(r.tags));
+
+        out.platform = (GamePlatform)r.platform;
+        out.status = (GameStatus)r.status;
+        out.machine = (MachineType)r.machine;
+        out.forceWindowed = (r.windowFlags & 1) != 0;
+        out.forceMaximized = (r.windowFlags & 2) != 0;
+        out.forceFullscreen = (r.windowFlags & 4) != 0;
+        for (int i = 0; i < 6; i++)
+            out.audioFlags[i] = (r.audioMask & (1 << i)) != 0;
+        out.videoHwIdx = (r.videoHwIdx < 6) ? r.videoHwIdx : 5;
+
+        out.ramKB = r.ramKB;
+        out.mips = r.mips;
+        out.width = r.width;
+        out.height = r.height;
+        out.depth = r.depth;
+    }
+
+    // <-- Writing -->
+    std::string LibraryFile::Serialize(size_t count, const EntrySource &fetch)
+    {
+        StringPoolBuilder pool;
+        std::vector<LibraryRecord> records;
+        records.reserve(count);
+
+        GameEntry game;
+        for (size_t i = 0; i < count; ++i)
+        {
+            fetch(i, game);
+
+            LibraryRecord r = {};
+            r.id = game.id;
+            r.name = pool.Add(game.name);
+            r.description = pool.Add(game.description);
+            r.exePath = pool.Add(game.exePath);
+            r.setupPath = pool.Add(game.setupPath);
+            r.installPath = pool.Add(game.installPath);
+            r.isoPath = pool.Add(game.isoPath);
+            r.rootPathOverride = pool.Add(game.rootPathOverride);
+            r.tags = pool.Add(JoinTags(game.tags));
+
+            r.platform = (uint8_t)game.platform;
+            r.status = (uint8_t)game.status;
+            r.machine = (uint8_t)game.machine;
+            r.windowFlags = (game.forceWindowed ? 1 : 0) | (game.forceMaximized ? 2 : 0) | (game.forceFullscreen ? 4 : 0);
+            for (int device = 0; device < 6; device++)
+            {
+                if (game.audioFlags[device])
+                    r.audioMask |= (1 << device);
+            }
+            r.videoHwIdx = (uint8_t)game.videoHwIdx;
+
+            r.ramKB = game.ramKB;
+            r.mips = game.mips;
+            r.width = game.width;
+            r.height = game.height;
+            r.depth = game.depth;
+            records.push_back(r);
+        }
+
+        LibraryFileHeader header = {};
+        std::memcpy(header.magic, LIBRARY_MAGIC, sizeof(LIBRARY_MAGIC));
+        header.version = VERSION;
+        header.headerSize = sizeof(LibraryFileHeader);
+        header.recordSize = sizeof(LibraryRecord);
+        header.recordCount = (uint32_t)records.size();
+        header.recordsOffset = sizeof(LibraryFileHeader);
+        header.stringsOffset = header.recordsOffset + (uint64_t)records.size() * sizeof(LibraryRecord);
+        header.stringsSize = pool.Data().size();
+
+        std::string out;
+        out.reserve(header.stringsOffset + header.stringsSize);
+        out.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.append(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(LibraryRecord));
+        out.append(pool.Data().data(), pool.Data().size());
+        return out;
+    }
+
+} // namespace Core
@@ -0,0 +1,117 @@
+#ifndef LIBRARYFILE_H
+#define LIBRARYFILE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/GameEntry.h"
+#include "Core/MappedFile.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // <-- On-Disk Layout (games.bin, little-endian) -->
+    // [Header][Record Table][String Pool]
+    // Strings are NUL-terminated inside the pool so they can be used in place.
+
+    struct LibraryStringRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct LibraryFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint32_t recordSize;
+        uint32_t recordCount;
+        uint64_t recordsOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    struct LibraryRecord
+    {
+        // Strings
+        LibraryStringRef name;
+        LibraryStringRef description;
+        LibraryStringRef exePath;
+        LibraryStringRef setupPath;
+        LibraryStringRef installPath;
+        LibraryStringRef isoPath;
+        LibraryStringRef rootPathOverride;
+
+        // Enums & Flags
+        uint8_t platform;
+        uint8_t status;
+        uint8_t machine;
+        uint8_t windowFlags; // bit 0 = windowed, 1 = maximized, 2 = fullscreen
+        uint8_t audioMask;
+        uint8_t videoHwIdx;
+        uint16_t reserved;
+
+        // Hardware & Display
+        int32_t ramKB;
+        int32_t mips;
+        int32_t width;
+        int32_t height;
+        int32_t depth;
+        uint32_t reserved2;
+
+        // Version 2+
+        uint64_t id;
+
+        // Version 3+
+        LibraryStringRef tags; // One per line
+    };
+
+    static_assert(sizeof(LibraryFileHeader) == 48, "LibraryFileHeader layout changed");
+    static_assert(sizeof(LibraryRecord) == 104, "LibraryRecord layout changed");
+
+    // Version 1 records stop before `reserved2` and carry no id; version 2 stops before `tags`
+    static constexpr uint32_t LIBRARY_RECORD_SIZE_V1 = 84;
+    static constexpr uint32_t LIBRARY_RECORD_SIZE_V2 = 96;
+
+    // Versioned binary library, read in place through a file mapping
+    class LibraryFile
+    {
+    public:
+        static constexpr uint32_t VERSION = 3;
+
+        bool Open(const fs::path &path);
+        void Close();
+        bool IsOpen() const { return m_records != nullptr; }
+
+        uint32_t Version() const { return m_version; }
+        uint32_t RecordCount() const { return m_recordCount; }
+        LibraryRecord Record(uint32_t idx) const;
+        std::string_view String(const LibraryStringRef &ref) const;
+
+        void Decode(uint32_t idx, GameEntry &out) const;
+
+        // Builds a complete file image; `fetch` fills in entry `idx`
+        using EntrySource = std::function<void(size_t idx, GameEntry &out)>;
+        static std::string Serialize(size_t count, const EntrySource &fetch);
+
+    private:
+        bool Validate();
+
+        MappedFile m_file;
+        const uint8_t *m_records = nullptr;
+        uint32_t m_version = 0;
+        uint32_t m_recordSize = 0;
+        uint32_t m_recordCount = 0;
+        const char *m_strings = nullptr;
+        uint64_t m_stringsSize = 0;
+    };
+
+} // namespace Core
+
+#endif // LIBRARYFILE_H
@@ -0,0 +1,261 @@
+#include "pch.h"
+#include "Core/LibraryJournal.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace Core
+{
+
+    static const char JOURNAL_MAGIC[8] = {'M', 'O', 'R', 'T', 'J', 'R', 'N', '\0'};
+    static const size_t JOURNAL_HEADER_SIZE = sizeof(JOURNAL_MAGIC) + sizeof(uint32_t);
+
+    // <-- Helpers -->
+    static uint32_t Checksum(const char *data, size_t size)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= (uint8_t)data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    static void Put(std::string &out, T value)
+    {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    static void PutString(std::string &out, const std::string &str)
+    {
+        Put<uint32_t>(out, (uint32_t)str.size());
+        out.append(str);
+    }
+
+    // Bounds-checked reader over one record payload
+    struct PayloadReader
+    {
+        const char *cur;
+        const char *end;
+        bool ok = true;
+
+        template <typename T>
+        T Get()
+        {
+            T value = {};
+            if (end - cur < (ptrdiff_t)sizeof(T))
+            {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, cur, sizeof(T));
+            cur += sizeof(T);
+            return value;
+        }
+
+        std::string GetString()
+        {
+            uint32_t len = Get<uint32_t>();
+            if (!ok || (uint64_t)(end - cur) < len)
+            {
+                ok = false;
+                return std::string();
+            }
+            std::string str(cur, len);
+            cur += len;
+            return str;
+        }
+    };
+
+    // <-- Encoding -->
+    static void EncodeEntry(std::string &out, const GameEntry &game)
+    {
+        PutString(out, game.name);
+        PutString(out, game.description);
+        PutString(out, game.exePath);
+        PutString(out, game.setupPath);
+        PutString(out, game.installPath);
+        PutString(out, game.isoPath);
+        PutString(out, game.rootPathOverride);
+
+        uint8_t audioMask = 0;
+        for (int i = 0; i < 6; i++)
+        {
+            if (game.audioFlags[i])
+                audioMask |= (1 << i);
+        }
+
+        Put<uint8_t>(out, (uint8_t)game.platform);
+        Put<uint8_t>(out, (uint8_t)game.status);
+        Put<uint8_t>(out, (uint8_t)game.machine);
+        Put<uint8_t>(out, (game.forceWindowed ? 1 : 0) | (game.forceMaximized ? 2 : 0) | (game.forceFullscreen ? 4 : 0));
+        Put<uint8_t>(out, audioMask);
+        Put<uint8_t>(out, (uint8_t)game.videoHwIdx);
+
+        Put<int32_t>(out, game.ramKB);
+        Put<int32_t>(out, game.mips);
+        Put<int32_t>(out, game.width);
+        Put<int32_t>(out, game.height);
+        Put<int32_t>(out, game.depth);
+
+        // Appended later; older records simply end here
+        PutString(out, JoinTags(game.tags));
+    }
+
+    static bool DecodeEntry(PayloadReader &in, GameEntry &game)
+    {
+        game.name = in.GetString();
+        game.description = in.GetString();
+        game.exePath = in.GetString();
+        game.setupPath = in.GetString();
+        game.installPath = in.GetString();
+        game.isoPath = in.GetString();
+        game.rootPathOverride = in.GetString();
+
+        game.platform = (GamePlatform)in.Get<uint8_t>();
+        game.status = (GameStatus)in.Get<uint8_t>();
+        game.machine = (MachineType)in.Get<uint8_t>();
+        uint8_t windowFlags = in.Get<uint8_t>();
+        uint8_t audioMask = in.Get<uint8_t>();
+        uint8_t videoHwIdx = in.Get<uint8_t>();
+
+        game.forceWindowed = (windowFlags & 1) != 0;
+        game.forceMaximized = (windowFlags & 2) != 0;
+        game.forceFullscreen = (windowFlags & 4) != 0;
+        for (int i = 0; i < 6; i++)
+            game.audioFlags[i] = (audioMask & (1 << i)) != 0;
+        game.videoHwIdx = (videoHwIdx < 6) ? videoHwIdx : 5;
+
+        game.ramKB = in.Get<int32_t>();
+        game.mips = in.Get<int32_t>();
+        game.width = in.Get<int32_t>();
+        game.height = in.Get<int32_t>();
+        game.depth = in.Get<int32_t>();
+        if (in.ok && in.cur != in.end)
+            game.tags = SplitTags(in.GetString());
+        return in.ok;
+    }
+
+    std::string LibraryJournal::Encode(const std::vector<JournalMutation> &mutations)
+    {
+        std::string out;
+        std::string payload;
+
+        for (const auto &m : mutations)
+        {
+            payload.clear();
+            Put<uint8_t>(payload, (uint8_t)m.op);
+            Put<uint64_t>(payload, m.id);
+            if (m.op != JournalOp::Delete && m.game)
+                EncodeEntry(payload, *m.game);
+
+            Put<uint32_t>(out, (uint32_t)payload.size());
+            Put<uint32_t>(out, Checksum(payload.data(), payload.size()));
+            out.append(payload);
+        }
+        return out;
+    }
+
+    // <-- File Operations -->
+    bool LibraryJournal::Append(const fs::path &path, const std::string &encoded)
+    {
+        if (encoded.empty())
+            return true;
+
+        std::error_code ec;
+        bool needsHeader = !fs::exists(path, ec) || fs::file_size(path, ec) < JOURNAL_HEADER_SIZE;
+
+        std::ofstream file(path, std::ios::binary | (needsHeader ? std::ios::trunc : std::ios::app));
+        if (!file.is_open())
+            return false;
+
+        if (needsHeader)
+        {
+            uint32_t version = VERSION;
+            file.write(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+            file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        }
+
+        file.write(encoded.data(), encoded.size());
+        file.flush();
+        return file.good();
+    }
+
+    int LibraryJournal::Replay(const fs::path &path, const ReplayHandler &apply)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return 0;
+
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        file.close();
+
+        if (data.size() < JOURNAL_HEADER_SIZE || std::memcmp(data.data(), JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0)
+            return 0;
+
+        uint32_t version = 0;
+        std::memcpy(&version, data.data() + sizeof(JOURNAL_MAGIC), sizeof(version));
+        if (version != VERSION)
+        {
+            SDL_Log("Ignoring journal '%s' with unknown version %u.", path.string().c_str(), version);
+            return 0;
+        }
+
+        int applied = 0;
+
+        const char *cur = data.data() + JOURNAL_HEADER_SIZE;
+        const char *end = data.data() + data.size();
+        while (end - cur >= 8)
+        {
+            uint32_t size, checksum;
+            std::memcpy(&size, cur, 4);
+            std::memcpy(&checksum, cur + 4, 4);
+            if ((uint64_t)(end - cur - 8) < size || Checksum(cur + 8, size) != checksum)
+                break;
+
+            PayloadReader in{cur + 8, cur + 8 + size};
+            cur += 8 + size;
+
+            JournalOp op = (JournalOp)in.Get<uint8_t>();
+            uint64_t id = in.Get<uint64_t>();
+            if (!in.ok || id == 0)
+                continue;
+
+            if (op == JournalOp::Delete)
+            {
+                apply(op, id, nullptr);
+                applied++;
+                continue;
+            }
+
+            GameEntry game;
+            if (!DecodeEntry(in, game))
+                continue;
+            game.id = id;
+
+            apply(op, id, &game);
+            applied++;
+        }
+
+        if (cur != end)
+        {
+            // Drop the torn tail (crash mid-append) so later appends stay reachable
+            SDL_Log("Journal '%s' has a torn record; discarding the tail.", path.string().c_str());
+            std::error_code ec;
+            fs::resize_file(path, (uintmax_t)(cur - data.data()), ec);
+        }
+
+        return applied;
+    }
+
+    void LibraryJournal::Reset(const fs::path &path)
+    {
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+
+} // namespace Core
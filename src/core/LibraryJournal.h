@@ -0,0 +1,49 @@
+#ifndef LIBRARYJOURNAL_H
+#define LIBRARYJOURNAL_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Core/GameEntry.h"
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    enum class JournalOp : uint8_t
+    {
+        Add = 1,
+        Edit = 2,
+        Delete = 3
+    };
+
+    struct JournalMutation
+    {
+        JournalOp op;
+        uint64_t id;
+        const GameEntry *game; // null for Delete
+    };
+
+    // <-- Write-Ahead Journal (games.journal) -->
+    // Append-only log of per-entry mutations applied on top of games.bin.
+    // Each record is [u32 payload size][u32 checksum][payload]; a torn or
+    // corrupt tail (crash mid-append) ends replay without losing earlier records.
+    class LibraryJournal
+    {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        static std::string Encode(const std::vector<JournalMutation> &mutations);
+        static bool Append(const fs::path &path, const std::string &encoded);
+        // Calls `apply` for each intact record in order; `game` is null for Delete
+        using ReplayHandler = std::function<void(JournalOp op, uint64_t id, const GameEntry *game)>;
+        static int Replay(const fs::path &path, const ReplayHandler &apply);
+        static void Reset(const fs::path &path);
+    };
+
+} // namespace Core
+
+#endif // LIBRARYJOURNAL_H
@@ -0,0 +1,181 @@
+#include "pch.h"
+#include "Core/LibrarySearch.h"
+
+#include <chrono>
+
+namespace Core
+{
+
+    LibrarySearch::LibrarySearch()
+    {
+        m_thread = std::thread(&LibrarySearch::ThreadMain, this);
+    }
+
+    LibrarySearch::~LibrarySearch()
+    {
+        Stop();
+    }
+
+    // <-- UI Thread -->
+    void LibrarySearch::Reset(std::vector<Document> docs)
+    {
+        Op op;
+        op.kind = OpKind::Reset;
+        op.docs = std::move(docs);
+        Push(std::move(op));
+    }
+
+    void LibrarySearch::Upsert(uint64_t id, std::string text)
+    {
+        Op op;
+        op.kind = OpKind::Upsert;
+        op.id = id;
+        op.text = std::move(text);
+        Push(std::move(op));
+    }
+
+    void LibrarySearch::Remove(uint64_t id)
+    {
+        Op op;
+        op.kind = OpKind::Remove;
+        op.id = id;
+        Push(std::move(op));
+    }
+
+    void LibrarySearch::SetNames(std::shared_ptr<const NameList> names)
+    {
+        Op op;
+        op.kind = OpKind::Names;
+        op.names = std::move(names);
+        Push(std::move(op));
+    }
+
+    void LibrarySearch::Push(Op op)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ops.push_back(std::move(op));
+        }
+        m_wake.notify_one();
+    }
+
+    void LibrarySearch::Query(const std::string &query)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (query == m_query && !m_queryDirty)
+                return;
+            m_query = query;
+            m_queryDirty = true;
+        }
+        m_wake.notify_one();
+    }
+
+    // Takes the newest published results, if any; returns true when they changed
+    bool LibrarySearch::Poll()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_readyFresh)
+            return false;
+        std::swap(m_front, m_ready);
+        m_readyFresh = false;
+        return true;
+    }
+
+    void LibrarySearch::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                return;
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    // <-- Worker -->
+    void LibrarySearch::ThreadMain()
+    {
+        std::string query;
+        uint64_t generation = 0;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_stop || !m_ops.empty() || m_queryDirty; });
+            if (m_stop)
+                return;
+
+            std::deque<Op> ops;
+            ops.swap(m_ops);
+            bool queryChanged = m_queryDirty;
+            if (m_queryDirty)
+            {
+                query = m_query;
+                m_queryDirty = false;
+            }
+            lock.unlock();
+
+            bool indexChanged = false;
+            for (Op &op : ops)
+            {
+                switch (op.kind)
+                {
+                case OpKind::Reset:
+                {
+                    auto startTime = std::chrono::steady_clock::now();
+                    m_index.Clear();
+                    m_index.Reserve(op.docs.size());
+                    for (const Document &doc : op.docs)
+                        m_index.Upsert(doc.first, doc.second);
+                    m_index.ShrinkToFit();
+                    indexChanged = true;
+
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+                    SDL_Log("Indexed %d games for search in %.1f ms (%.1f MB).",
+                            (int)m_index.Size(), seconds * 1000.0, m_index.MemoryBytes() / (1024.0 * 1024.0));
+                    break;
+                }
+                case OpKind::Upsert:
+                    indexChanged |= m_index.Upsert(op.id, op.text);
+                    break;
+                case OpKind::Remove:
+                    indexChanged |= m_index.Remove(op.id);
+                    break;
+                case OpKind::Names:
+                    m_names = std::move(op.names);
+                    indexChanged = true;
+                    break;
+                }
+            }
+
+            // Nothing to publish if the visible answer can't have changed
+            bool publish = queryChanged || (indexChanged && !query.empty());
+            if (publish)
+            {
+                m_back.query = query;
+                m_back.ids.clear();
+                m_back.ranked.clear();
+                m_back.revision = m_names ? m_names->revision : 0;
+                if (!query.empty())
+                {
+                    m_index.Search(query, m_back.ids);
+                    if (m_names)
+                        m_back.ranked = m_fuzzy.Rank(*m_names, query);
+                }
+                m_back.generation = ++generation;
+            }
+
+            lock.lock();
+            if (publish)
+            {
+                std::swap(m_ready, m_back);
+                m_readyFresh = true;
+            }
+        }
+    }
+
+} // namespace Core
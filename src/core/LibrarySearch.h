@@ -0,0 +1,101 @@
+#ifndef LIBRARYSEARCH_H
+#define LIBRARYSEARCH_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Core/FuzzyMatcher.h"
+#include "Core/TrigramIndex.h"
+
+namespace Core
+{
+    // <-- Background Library Search -->
+    // Owns a TrigramIndex and the fuzzy name ranking on a worker thread. The
+    // UI thread queues index updates, name lists and the latest query; only
+    // the newest query is ever run, and it is re-run after updates so results
+    // stay current. Results are double buffered: the worker fills its back
+    // buffer and swaps it in under the lock, and Poll() swaps it out to the
+    // UI, so neither side waits on a search.
+    class LibrarySearch
+    {
+    public:
+        struct Results
+        {
+            std::string query;         // Query these hits answer ("" = none yet)
+            std::vector<uint64_t> ids; // Full-text hits, sorted
+            std::vector<FuzzyMatch> ranked; // Name matches, best first, as positions in...
+            uint64_t revision = 0;          // ...the NameList of this revision
+            uint64_t generation = 0;        // Bumped on every publish
+        };
+
+        using Document = std::pair<uint64_t, std::string>;
+
+        LibrarySearch();
+        ~LibrarySearch();
+
+        LibrarySearch(const LibrarySearch &) = delete;
+        LibrarySearch &operator=(const LibrarySearch &) = delete;
+
+        // UI thread
+        void Reset(std::vector<Document> docs);
+        void Upsert(uint64_t id, std::string text);
+        void Remove(uint64_t id);
+        void SetNames(std::shared_ptr<const NameList> names); // Whenever positions or names change
+        void Query(const std::string &query);
+        bool Poll();
+        const Results &Current() const { return m_front; }
+        void Stop();
+
+    private:
+        enum class OpKind
+        {
+            Reset,
+            Upsert,
+            Remove,
+            Names
+        };
+
+        struct Op
+        {
+            OpKind kind;
+            uint64_t id = 0;
+            std::string text;
+            std::vector<Document> docs; // Reset only
+            std::shared_ptr<const NameList> names; // Names only
+        };
+
+        void Push(Op op);
+        void ThreadMain();
+
+        // Worker only
+        TrigramIndex m_index;
+        std::shared_ptr<const NameList> m_names;
+        FuzzySearch m_fuzzy;
+        Results m_back;
+
+        // Shared, under m_mutex
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Op> m_ops;
+        std::string m_query;
+        bool m_queryDirty = false;
+        Results m_ready;
+        bool m_readyFresh = false;
+        bool m_stop = false;
+
+        // UI only
+        Results m_front;
+
+        std::thread m_thread;
+    };
+
+} // namespace Core
+
+#endif // LIBRARYSEARCH_H
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "Core/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core
+{
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const fs::path &path)
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_fileHandle = file;
+        m_mappingHandle = mapping;
+        m_data = static_cast<const uint8_t *>(view);
+        m_size = (size_t)size.QuadPart;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void *view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+
+        m_fd = fd;
+        m_data = static_cast<const uint8_t *>(view);
+        m_size = (size_t)st.st_size;
+#endif
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mappingHandle)
+            CloseHandle((HANDLE)m_mappingHandle);
+        if (m_fileHandle)
+            CloseHandle((HANDLE)m_fileHandle);
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        if (m_data)
+            munmap((void *)m_data, m_size);
+        if (m_fd >= 0)
+            close(m_fd);
+        m_fd = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+} // namespace Core
@@ -0,0 +1,43 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // Read-only memory mapping of a whole file
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        bool Open(const fs::path &path);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        const uint8_t *Data() const { return m_data; }
+        size_t Size() const { return m_size; }
+
+    private:
+        const uint8_t *m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef _WIN32
+        void *m_fileHandle = nullptr;
+        void *m_mappingHandle = nullptr;
+#else
+        int m_fd = -1;
+#endif
+    };
+
+} // namespace Core
+
+#endif // MAPPEDFILE_H
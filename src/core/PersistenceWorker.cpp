@@ -0,0 +1,159 @@
+#include "pch.h"
+#include "Core/PersistenceWorker.h"
+
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace Core
+{
+
+    PersistenceWorker::PersistenceWorker()
+    {
+        m_thread = std::thread(&PersistenceWorker::ThreadMain, this);
+    }
+
+    PersistenceWorker::~PersistenceWorker()
+    {
+        Stop();
+    }
+
+    // <-- Dirty Tracking -->
+    void PersistenceWorker::MarkDirty(uint32_t targets)
+    {
+        m_dirty |= targets;
+        m_lastDirty = std::chrono::steady_clock::now();
+    }
+
+    uint32_t PersistenceWorker::TakeDue()
+    {
+        if (m_dirty == 0 || std::chrono::steady_clock::now() - m_lastDirty < DEBOUNCE)
+            return 0;
+        return TakeAll();
+    }
+
+    uint32_t PersistenceWorker::TakeAll()
+    {
+        uint32_t due = m_dirty;
+        m_dirty = 0;
+        return due;
+    }
+
+    // <-- Job Queue -->
+    void PersistenceWorker::Submit(Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+            {
+                // Late submissions during shutdown still get written
+                job();
+                return;
+            }
+            m_jobs.push_back(std::move(job));
+        }
+        m_wake.notify_one();
+    }
+
+    void PersistenceWorker::WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]
+                    { return m_jobs.empty() && !m_busy; });
+    }
+
+    void PersistenceWorker::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                return;
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void PersistenceWorker::ThreadMain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_stop || !m_jobs.empty(); });
+
+            // Drain everything, even when stopping, so nothing queued is lost
+            while (!m_jobs.empty())
+            {
+                Job job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+                m_busy = true;
+
+                lock.unlock();
+                job();
+                lock.lock();
+
+                m_busy = false;
+            }
+            m_idle.notify_all();
+
+            if (m_stop)
+                return;
+        }
+    }
+
+    // <-- Atomic File Replacement -->
+    bool PersistenceWorker::WriteFileAtomic(const fs::path &path, const std::string &contents)
+    {
+        return WriteStreamAtomic(path, [&contents](std::ostream &out)
+                                 {
+            out.write(contents.data(), contents.size());
+            return out.good(); });
+    }
+
+    bool PersistenceWorker::WriteStreamAtomic(const fs::path &path, const std::function<bool(std::ostream &)> &writer)
+    {
+        fs::path tempPath = TempPathFor(path);
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                return false;
+            bool written = writer(file);
+            file.flush();
+            if (!written || !file.good())
+                return false;
+        }
+        return ReplaceFile(tempPath, path);
+    }
+
+    fs::path PersistenceWorker::TempPathFor(const fs::path &path)
+    {
+        fs::path tempPath = path;
+        tempPath += ".tmp";
+        return tempPath;
+    }
+
+    bool PersistenceWorker::ReplaceFile(const fs::path &tempPath, const fs::path &path)
+    {
+#ifdef _WIN32
+        if (!MoveFileExW(tempPath.wstring().c_str(), path.wstring().c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        {
+            SDL_Log("Failed to replace %s (error %lu)", path.string().c_str(), GetLastError());
+            return false;
+        }
+#else
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+        {
+            SDL_Log("Failed to replace %s: %s", path.string().c_str(), ec.message().c_str());
+            return false;
+        }
+#endif
+        return true;
+    }
+
+} // namespace Core
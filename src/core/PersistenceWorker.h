@@ -0,0 +1,83 @@
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace Core
+{
+    namespace fs = std::filesystem;
+
+    // Things that can be marked dirty
+    enum PersistTarget : uint32_t
+    {
+        PersistConfig = 1 << 0,
+        PersistLibrary = 1 << 1,
+        PersistIcons = 1 << 2,
+        PersistFingerprints = 1 << 3
+    };
+
+    // <-- Background Persistence -->
+    // The UI thread marks targets dirty; once a target has been quiet for the
+    // debounce interval, TakeDue() hands it back so a single snapshot can be
+    // built for the whole burst. Snapshots are written on the worker thread in
+    // submission order.
+    class PersistenceWorker
+    {
+    public:
+        using Job = std::function<void()>;
+
+        PersistenceWorker();
+        ~PersistenceWorker();
+
+        PersistenceWorker(const PersistenceWorker &) = delete;
+        PersistenceWorker &operator=(const PersistenceWorker &) = delete;
+
+        // UI thread
+        void MarkDirty(uint32_t targets);
+        uint32_t TakeDue();
+        uint32_t TakeAll();
+
+        // Any thread
+        void Submit(Job job);
+        void WaitIdle();
+        void Stop();
+
+        // Writes to a temp file next to `path` and renames it over the original
+        static bool WriteFileAtomic(const fs::path &path, const std::string &contents);
+        static bool WriteStreamAtomic(const fs::path &path, const std::function<bool(std::ostream &)> &writer);
+
+        // The two halves of the above, for a file written over several jobs
+        static fs::path TempPathFor(const fs::path &path);
+        static bool ReplaceFile(const fs::path &tempPath, const fs::path &path);
+
+    private:
+        void ThreadMain();
+
+        static constexpr std::chrono::milliseconds DEBOUNCE{750};
+
+        // Dirty state (UI thread only)
+        uint32_t m_dirty = 0;
+        std::chrono::steady_clock::time_point m_lastDirty;
+
+        // Job queue
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        std::deque<Job> m_jobs;
+        bool m_busy = false;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+} // namespace Core
+
+#endif // PERSISTENCEWORKER_H
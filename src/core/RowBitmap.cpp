@@ -0,0 +1,368 @@
+#include "pch.h"
+#include "Core/RowBitmap.h"
+
+#include <algorithm>
+#include <iterator>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Core
+{
+
+    static const size_t BITSET_WORDS = 65536 / 64;
+
+    // <-- Bit Helpers -->
+    int RowBitmap::TrailingZeros(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return (int)index;
+#else
+        int n = 0;
+        while (!(word & 1))
+        {
+            word >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+
+    uint32_t RowBitmap::PopCount(uint64_t word)
+    {
+        // SWAR; the compiler turns this into popcnt where it can
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return (uint32_t)((word * 0x0101010101010101ull) >> 56);
+    }
+
+    // <-- Groups -->
+    bool RowBitmap::Group::Contains(uint16_t low) const
+    {
+        if (IsBitset())
+            return (bits[low >> 6] >> (low & 63)) & 1;
+        return std::binary_search(values.begin(), values.end(), low);
+    }
+
+    void RowBitmap::Group::ToBitset()
+    {
+        if (IsBitset())
+            return;
+        bits.assign(BITSET_WORDS, 0);
+        for (uint16_t low : values)
+            bits[low >> 6] |= 1ull << (low & 63);
+        values.clear();
+        values.shrink_to_fit();
+    }
+
+    // Picks the smaller form for the current count
+    void RowBitmap::Group::Normalise()
+    {
+        if (IsBitset() && count <= ARRAY_MAX)
+        {
+            values.clear();
+            values.reserve(count);
+            for (size_t w = 0; w < BITSET_WORDS; ++w)
+            {
+                uint64_t word = bits[w];
+                while (word)
+                {
+                    values.push_back((uint16_t)(w * 64 + TrailingZeros(word)));
+                    word &= word - 1;
+                }
+            }
+            bits.clear();
+            bits.shrink_to_fit();
+        }
+        else if (!IsBitset() && count > ARRAY_MAX)
+        {
+            ToBitset();
+        }
+    }
+
+    RowBitmap::Group *RowBitmap::FindGroup(uint16_t key)
+    {
+        auto it = std::lower_bound(m_groups.begin(), m_groups.end(), key, [](const Group &g, uint16_t k)
+                                   { return g.key < k; });
+        return (it != m_groups.end() && it->key == key) ? &*it : nullptr;
+    }
+
+    const RowBitmap::Group *RowBitmap::FindGroup(uint16_t key) const
+    {
+        return const_cast<RowBitmap *>(this)->FindGroup(key);
+    }
+
+    // <-- Rows -->
+    void RowBitmap::Add(uint32_t row)
+    {
+        uint16_t key = (uint16_t)(row >> 16);
+        uint16_t low = (uint16_t)row;
+
+        Group *group = nullptr;
+        if (!m_groups.empty() && m_groups.back().key == key)
+            group = &m_groups.back();
+        else if (m_groups.empty() || m_groups.back().key < key)
+        {
+            m_groups.emplace_back();
+            group = &m_groups.back();
+            group->key = key;
+        }
+        else
+        {
+            auto it = std::lower_bound(m_groups.begin(), m_groups.end(), key, [](const Group &g, uint16_t k)
+                                       { return g.key < k; });
+            if (it == m_groups.end() || it->key != key)
+            {
+                it = m_groups.insert(it, Group{});
+                it->key = key;
+            }
+            group = &*it;
+        }
+
+        if (group->IsBitset())
+        {
+            uint64_t &word = group->bits[low >> 6];
+            uint64_t bit = 1ull << (low & 63);
+            if (!(word & bit))
+            {
+                word |= bit;
+                group->count++;
+            }
+            return;
+        }
+
+        std::vector<uint16_t> &values = group->values;
+        if (values.empty() || values.back() < low)
+            values.push_back(low);
+        else
+        {
+            auto it = std::lower_bound(values.begin(), values.end(), low);
+            if (*it == low)
+                return;
+            values.insert(it, low);
+        }
+        group->count++;
+        if (group->count > ARRAY_MAX)
+            group->ToBitset();
+    }
+
+    bool RowBitmap::Contains(uint32_t row) const
+    {
+        // Libraries rarely span more than a few groups, so scan before searching
+        uint16_t key = (uint16_t)(row >> 16);
+        if (m_groups.size() <= 4)
+        {
+            for (const Group &group : m_groups)
+            {
+                if (group.key == key)
+                    return group.Contains((uint16_t)row);
+            }
+            return false;
+        }
+        const Group *group = FindGroup(key);
+        return group && group->Contains((uint16_t)row);
+    }
+
+    size_t RowBitmap::Count() const
+    {
+        size_t total = 0;
+        for (const Group &group : m_groups)
+            total += group.count;
+        return total;
+    }
+
+    RowBitmap RowBitmap::All(uint32_t rows)
+    {
+        RowBitmap all;
+        for (uint32_t first = 0; first < rows; first += 65536)
+        {
+            uint32_t n = std::min<uint32_t>(rows - first, 65536);
+            Group group;
+            group.key = (uint16_t)(first >> 16);
+            group.count = n;
+            group.bits.assign(BITSET_WORDS, 0);
+            for (uint32_t w = 0; w < n / 64; ++w)
+                group.bits[w] = ~0ull;
+            if (n % 64)
+                group.bits[n / 64] = (1ull << (n % 64)) - 1;
+            group.Normalise();
+            all.m_groups.push_back(std::move(group));
+        }
+        return all;
+    }
+
+    size_t RowBitmap::MemoryBytes() const
+    {
+        size_t bytes = m_groups.capacity() * sizeof(Group);
+        for (const Group &group : m_groups)
+            bytes += group.values.capacity() * sizeof(uint16_t) + group.bits.capacity() * sizeof(uint64_t);
+        return bytes;
+    }
+
+    // <-- Set Operations -->
+    void RowBitmap::AndGroups(Group &a, const Group &b)
+    {
+        if (a.IsBitset() && b.IsBitset())
+        {
+            a.count = 0;
+            for (size_t w = 0; w < BITSET_WORDS; ++w)
+            {
+                a.bits[w] &= b.bits[w];
+                a.count += PopCount(a.bits[w]);
+            }
+        }
+        else if (!a.IsBitset() && !b.IsBitset())
+        {
+            std::vector<uint16_t> out;
+            out.reserve(std::min(a.values.size(), b.values.size()));
+            std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out));
+            a.values.swap(out);
+            a.count = (uint32_t)a.values.size();
+        }
+        else if (a.IsBitset())
+        {
+            // Result fits the array form: b's rows that a also has
+            std::vector<uint16_t> out;
+            out.reserve(b.values.size());
+            for (uint16_t low : b.values)
+            {
+                if (a.Contains(low))
+                    out.push_back(low);
+            }
+            a.bits.clear();
+            a.bits.shrink_to_fit();
+            a.values.swap(out);
+            a.count = (uint32_t)a.values.size();
+        }
+        else
+        {
+            auto end = std::remove_if(a.values.begin(), a.values.end(), [&b](uint16_t low)
+                                      { return !b.Contains(low); });
+            a.values.erase(end, a.values.end());
+            a.count = (uint32_t)a.values.size();
+        }
+        a.Normalise();
+    }
+
+    void RowBitmap::OrGroups(Group &a, const Group &b)
+    {
+        if (!a.IsBitset() && !b.IsBitset() && a.values.size() + b.values.size() <= ARRAY_MAX)
+        {
+            std::vector<uint16_t> out;
+            out.reserve(a.values.size() + b.values.size());
+            std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out));
+            a.values.swap(out);
+            a.count = (uint32_t)a.values.size();
+            return;
+        }
+
+        a.ToBitset();
+        if (b.IsBitset())
+        {
+            a.count = 0;
+            for (size_t w = 0; w < BITSET_WORDS; ++w)
+            {
+                a.bits[w] |= b.bits[w];
+                a.count += PopCount(a.bits[w]);
+            }
+        }
+        else
+        {
+            for (uint16_t low : b.values)
+            {
+                uint64_t &word = a.bits[low >> 6];
+                uint64_t bit = 1ull << (low & 63);
+                a.count += (word & bit) ? 0 : 1;
+                word |= bit;
+            }
+        }
+        a.Normalise();
+    }
+
+    void RowBitmap::AndNotGroups(Group &a, const Group &b)
+    {
+        if (a.IsBitset())
+        {
+            if (b.IsBitset())
+            {
+                a.count = 0;
+                for (size_t w = 0; w < BITSET_WORDS; ++w)
+                {
+                    a.bits[w] &= ~b.bits[w];
+                    a.count += PopCount(a.bits[w]);
+                }
+            }
+            else
+            {
+                for (uint16_t low : b.values)
+                {
+                    uint64_t &word = a.bits[low >> 6];
+                    uint64_t bit = 1ull << (low & 63);
+                    a.count -= (word & bit) ? 1 : 0;
+                    word &= ~bit;
+                }
+            }
+        }
+        else
+        {
+            auto end = std::remove_if(a.values.begin(), a.values.end(), [&b](uint16_t low)
+                                      { return b.Contains(low); });
+            a.values.erase(end, a.values.end());
+            a.count = (uint32_t)a.values.size();
+        }
+        a.Normalise();
+    }
+
+    void RowBitmap::And(const RowBitmap &other)
+    {
+        std::vector<Group> out;
+        out.reserve(std::min(m_groups.size(), other.m_groups.size()));
+        for (Group &group : m_groups)
+        {
+            const Group *match = other.FindGroup(group.key);
+            if (!match)
+                continue;
+            AndGroups(group, *match);
+            if (group.count > 0)
+                out.push_back(std::move(group));
+        }
+        m_groups.swap(out);
+    }
+
+    void RowBitmap::Or(const RowBitmap &other)
+    {
+        for (const Group &group : other.m_groups)
+        {
+            Group *match = FindGroup(group.key);
+            if (match)
+            {
+                OrGroups(*match, group);
+                continue;
+            }
+            auto it = std::lower_bound(m_groups.begin(), m_groups.end(), group.key, [](const Group &g, uint16_t k)
+                                       { return g.key < k; });
+            m_groups.insert(it, group);
+        }
+    }
+
+    void RowBitmap::AndNot(const RowBitmap &other)
+    {
+        std::vector<Group> out;
+        out.reserve(m_groups.size());
+        for (Group &group : m_groups)
+        {
+            if (const Group *match = other.FindGroup(group.key))
+                AndNotGroups(group, *match);
+            if (group.count > 0)
+                out.push_back(std::move(group));
+        }
+        m_groups.swap(out);
+    }
+
+} // namespace Core
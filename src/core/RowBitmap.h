@@ -0,0 +1,93 @@
+#ifndef ROWBITMAP_H
+#define ROWBITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+    // <-- Compressed Row Bitmap -->
+    // A set of library positions in the Roaring layout: rows are grouped by
+    // their high 16 bits, and each group is stored as a sorted uint16_t array
+    // while it holds at most ARRAY_MAX rows, or as a 65536-bit bitset once it
+    // is denser. A tag on a handful of games costs a few bytes; "every DOS
+    // game" costs 8 KB per 65536 rows. And/Or/AndNot work group by group.
+    class RowBitmap
+    {
+    public:
+        static constexpr uint32_t ARRAY_MAX = 4096;
+
+        void Clear() { m_groups.clear(); }
+        void Add(uint32_t row); // Cheapest in increasing row order
+        bool Contains(uint32_t row) const;
+        size_t Count() const;
+        bool Empty() const { return m_groups.empty(); }
+
+        // In place; the result of each is normalised (empty groups dropped)
+        void And(const RowBitmap &other);
+        void Or(const RowBitmap &other);
+        void AndNot(const RowBitmap &other);
+
+        // Rows [0, rows)
+        static RowBitmap All(uint32_t rows);
+
+        // Calls f(row) in increasing order
+        template <typename F>
+        void ForEach(F &&f) const;
+
+        size_t MemoryBytes() const;
+
+    private:
+        struct Group
+        {
+            uint16_t key = 0;
+            uint32_t count = 0;
+            std::vector<uint16_t> values; // Array form, sorted
+            std::vector<uint64_t> bits;   // Bitset form (1024 words) when non-empty
+
+            bool IsBitset() const { return !bits.empty(); }
+            bool Contains(uint16_t low) const;
+            void ToBitset();
+            void Normalise();
+        };
+
+        Group *FindGroup(uint16_t key);
+        const Group *FindGroup(uint16_t key) const;
+
+        static void AndGroups(Group &a, const Group &b);
+        static void OrGroups(Group &a, const Group &b);
+        static void AndNotGroups(Group &a, const Group &b);
+        static int TrailingZeros(uint64_t word);
+        static uint32_t PopCount(uint64_t word);
+
+        std::vector<Group> m_groups; // Sorted by key
+    };
+
+    template <typename F>
+    void RowBitmap::ForEach(F &&f) const
+    {
+        for (const Group &group : m_groups)
+        {
+            uint32_t base = (uint32_t)group.key << 16;
+            if (!group.IsBitset())
+            {
+                for (uint16_t low : group.values)
+                    f(base | low);
+                continue;
+            }
+            for (size_t w = 0; w < group.bits.size(); ++w)
+            {
+                uint64_t word = group.bits[w];
+                while (word)
+                {
+                    f(base | (uint32_t)(w * 64 + TrailingZeros(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+} // namespace Core
+
+#endif // ROWBITMAP_H
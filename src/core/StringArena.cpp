@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "Core/StringArena.h"
+
+#include <string>
+
+namespace Core
+{
+
+    static const size_t INITIAL_SLOTS = 1024;
+
+    StringArena::StringArena()
+    {
+        Clear();
+    }
+
+    void StringArena::Clear()
+    {
+        // Offset 0 is the empty string: zero length, then its terminator
+        m_data.assign(2, '\0');
+        m_slots.assign(INITIAL_SLOTS, 0);
+        m_count = 0;
+    }
+
+    uint64_t StringArena::Hash(std::string_view str)
+    {
+        // FNV-1a
+        uint64_t hash = 1469598103934665603ull;
+        for (char c : str)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string_view StringArena::Get(Ref ref) const
+    {
+        const char *p = m_data.data() + ref;
+
+        // LEB128 length prefix
+        uint32_t length = 0;
+        int shift = 0;
+        uint8_t byte;
+        do
+        {
+            byte = (uint8_t)*p++;
+            length |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        return std::string_view(p, length);
+    }
+
+    StringArena::Ref StringArena::Intern(std::string_view str)
+    {
+        if (str.empty())
+            return EMPTY;
+
+        // A view into our own buffer would dangle once the buffer grows
+        if (str.data() >= m_data.data() && str.data() < m_data.data() + m_data.size())
+        {
+            std::string copy(str);
+            return Intern(copy);
+        }
+
+        size_t mask = m_slots.size() - 1;
+        size_t slot = (size_t)Hash(str) & mask;
+        while (m_slots[slot] != 0)
+        {
+            if (Get(m_slots[slot]) == str)
+                return m_slots[slot];
+            slot = (slot + 1) & mask;
+        }
+
+        Ref ref = (Ref)m_data.size();
+        uint32_t length = (uint32_t)str.size();
+        do
+        {
+            uint8_t byte = length & 0x7F;
+            length >>= 7;
+            m_data.push_back((char)(byte | (length ? 0x80 : 0)));
+        } while (length);
+        m_data.insert(m_data.end(), str.begin(), str.end());
+        m_data.push_back('\0');
+
+        m_slots[slot] = ref;
+        m_count++;
+
+        // Keep the load factor under one half
+        if (m_count * 2 > m_slots.size())
+            Rehash(m_slots.size() * 2);
+        return ref;
+    }
+
+    void StringArena::Rehash(size_t slotCount)
+    {
+        std::vector<Ref> old;
+        old.swap(m_slots);
+        m_slots.assign(slotCount, 0);
+
+        size_t mask = slotCount - 1;
+        for (Ref ref : old)
+        {
+            if (ref == 0)
+                continue;
+            size_t slot = (size_t)Hash(Get(ref)) & mask;
+            while (m_slots[slot] != 0)
+                slot = (slot + 1) & mask;
+            m_slots[slot] = ref;
+        }
+    }
+
+} // namespace Core
@@ -0,0 +1,47 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+    // <-- Interned String Arena -->
+    // Every distinct string is stored once in a single growable buffer as
+    // [varint length][bytes][NUL] and addressed by its byte offset. Lookups go
+    // through an open-addressed table of offsets (4 bytes per slot), so the
+    // per-string overhead is a few bytes instead of a std::string each.
+    //
+    // Views returned by Get() are invalidated by the next Intern().
+    class StringArena
+    {
+    public:
+        using Ref = uint32_t;
+        static constexpr Ref EMPTY = 0;
+
+        StringArena();
+
+        Ref Intern(std::string_view str);
+        std::string_view Get(Ref ref) const;
+        const char *CStr(Ref ref) const { return Get(ref).data(); }
+
+        void Clear();
+
+        size_t Count() const { return m_count; }
+        size_t DataBytes() const { return m_data.size(); }
+        size_t ReservedBytes() const { return m_data.capacity() + m_slots.capacity() * sizeof(Ref); }
+
+    private:
+        void Rehash(size_t slotCount);
+        static uint64_t Hash(std::string_view str);
+
+        std::vector<char> m_data;
+        std::vector<Ref> m_slots; // Power-of-two sized; 0 = free (the empty string is never stored in it)
+        size_t m_count = 0;
+    };
+
+} // namespace Core
+
+#endif // STRINGARENA_H
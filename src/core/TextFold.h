@@ -0,0 +1,55 @@
+#ifndef TEXTFOLD_H
+#define TEXTFOLD_H
+
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+    // <-- ASCII Case Folding -->
+    // Locale-independent: only A-Z change, so UTF-8 bytes pass through intact.
+    constexpr char FoldAscii(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+    }
+
+    constexpr bool EqualsNoCase(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (FoldAscii(a[i]) != FoldAscii(b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    constexpr bool StartsWithNoCase(std::string_view text, std::string_view prefix)
+    {
+        return text.size() >= prefix.size() && EqualsNoCase(text.substr(0, prefix.size()), prefix);
+    }
+
+    // <-- Path Keys -->
+    // The one key for every path-keyed map and set: case-folded, '\\' for
+    // either slash, no trailing separator (except a drive root's, "c:\").
+    // The Into form reuses `out`'s capacity, for loops over many paths.
+    inline void FoldPathInto(std::string_view path, std::string &out)
+    {
+        out.assign(path.data(), path.size());
+        for (char &c : out)
+            c = (c == '/') ? '\\' : FoldAscii(c);
+        while (out.size() > 1 && out.back() == '\\' && out[out.size() - 2] != ':')
+            out.pop_back();
+    }
+
+    inline std::string FoldPath(std::string_view path)
+    {
+        std::string folded;
+        FoldPathInto(path, folded);
+        return folded;
+    }
+
+} // namespace Core
+
+#endif // TEXTFOLD_H
@@ -0,0 +1,189 @@
+#ifndef TEXTTOKENIZER_H
+#define TEXTTOKENIZER_H
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+    // <-- Line Reader -->
+    // Walks a text buffer line by line without copying; handles \n and \r\n.
+    class TextLineReader
+    {
+    public:
+        explicit TextLineReader(std::string_view text) : m_text(text) {}
+
+        bool Next(std::string_view &line)
+        {
+            if (m_pos >= m_text.size())
+                return false;
+
+            size_t end = m_text.find('\n', m_pos);
+            if (end == std::string_view::npos)
+                end = m_text.size();
+
+            line = m_text.substr(m_pos, end - m_pos);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            m_pos = end + 1;
+            m_lineNumber++;
+            return true;
+        }
+
+        int LineNumber() const { return m_lineNumber; }
+
+        // Byte offset of the next unread line
+        size_t Offset() const { return m_pos < m_text.size() ? m_pos : m_text.size(); }
+
+    private:
+        std::string_view m_text;
+        size_t m_pos = 0;
+        int m_lineNumber = 0;
+    };
+
+    // <-- Field Tokenizer -->
+    // Splits one delimited line into string_views in a single pass. Numeric
+    // accessors use std::from_chars and record failures in a per-field error
+    // mask instead of throwing.
+    class FieldTokenizer
+    {
+    public:
+        static constexpr int MAX_FIELDS = 32;
+
+        FieldTokenizer(std::string_view line, char delimiter = '|')
+        {
+            size_t start = 0;
+            while (m_count < MAX_FIELDS)
+            {
+                size_t end = line.find(delimiter, start);
+                if (end == std::string_view::npos)
+                {
+                    m_fields[m_count++] = line.substr(start);
+                    break;
+                }
+                m_fields[m_count++] = line.substr(start, end - start);
+                start = end + 1;
+            }
+        }
+
+        int Count() const { return m_count; }
+        bool Has(int idx) const { return idx < m_count; }
+        std::string_view Field(int idx) const { return idx < m_count ? m_fields[idx] : std::string_view(); }
+
+        // Leaves `out` untouched when the field is missing or malformed
+        template <typename T>
+        bool Int(int idx, T &out)
+        {
+            if (idx >= m_count)
+                return false;
+
+            std::string_view field = Trimmed(m_fields[idx]);
+            int value = 0;
+            auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+            if (field.empty() || result.ec != std::errc() || result.ptr != field.data() + field.size())
+            {
+                m_errorMask |= (1u << idx);
+                return false;
+            }
+            out = static_cast<T>(value);
+            return true;
+        }
+
+        bool Flag(int idx, bool &out) const
+        {
+            if (idx >= m_count)
+                return false;
+            out = (Trimmed(m_fields[idx]) == "1");
+            return true;
+        }
+
+        // Bit N set = field N failed to parse
+        uint32_t ErrorMask() const { return m_errorMask; }
+
+        static std::string_view Trimmed(std::string_view str)
+        {
+            size_t first = str.find_first_not_of(" \t\r\n");
+            if (first == std::string_view::npos)
+                return std::string_view();
+            size_t last = str.find_last_not_of(" \t\r\n");
+            return str.substr(first, last - first + 1);
+        }
+
+    private:
+        std::array<std::string_view, MAX_FIELDS> m_fields;
+        int m_count = 0;
+        uint32_t m_errorMask = 0;
+    };
+
+    // <-- games.db Field Escaping -->
+    // '%', '|' and line breaks are stored as %25, %7C, %0A and %0D so free text
+    // survives a round trip. Only those four sequences are decoded, so older
+    // unescaped files read back unchanged unless they contain one literally.
+    inline void AppendEscapedField(std::string &out, std::string_view field)
+    {
+        for (char c : field)
+        {
+            switch (c)
+            {
+            case '%':
+                out += "%25";
+                break;
+            case '|':
+                out += "%7C";
+                break;
+            case '\n':
+                out += "%0A";
+                break;
+            case '\r':
+                out += "%0D";
+                break;
+            default:
+                out += c;
+            }
+        }
+    }
+
+    inline void AssignUnescapedField(std::string &out, std::string_view field)
+    {
+        size_t pct = field.find('%');
+        if (pct == std::string_view::npos)
+        {
+            out.assign(field);
+            return;
+        }
+
+        out.assign(field.substr(0, pct));
+        for (size_t i = pct; i < field.size(); ++i)
+        {
+            if (field[i] == '%' && i + 2 < field.size())
+            {
+                char hi = field[i + 1];
+                char lo = (char)(field[i + 2] | 0x20); // lowercase hex letter
+                char decoded = 0;
+                if (hi == '2' && lo == '5')
+                    decoded = '%';
+                else if (hi == '7' && lo == 'c')
+                    decoded = '|';
+                else if (hi == '0' && lo == 'a')
+                    decoded = '\n';
+                else if (hi == '0' && lo == 'd')
+                    decoded = '\r';
+
+                if (decoded)
+                {
+                    out += decoded;
+                    i += 2;
+                    continue;
+                }
+            }
+            out += field[i];
+        }
+    }
+
+} // namespace Core
+
+#endif // TEXTTOKENIZER_H
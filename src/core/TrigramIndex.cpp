@@ -0,0 +1,277 @@
+#include "pch.h"
+#include "Core/TrigramIndex.h"
+#include "Core/TextFold.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Core
+{
+
+    static uint32_t PackTrigram(const char *p)
+    {
+        return ((uint32_t)(uint8_t)p[0] << 16) | ((uint32_t)(uint8_t)p[1] << 8) | (uint32_t)(uint8_t)p[2];
+    }
+
+    // <-- Helpers -->
+    void TrigramIndex::Fold(std::string_view in, std::string &out)
+    {
+        out.resize(in.size());
+        for (size_t i = 0; i < in.size(); ++i)
+            out[i] = FoldAscii(in[i]);
+    }
+
+    // Distinct trigrams, sorted; windows that cross a field separator are skipped
+    void TrigramIndex::CollectTrigrams(std::string_view folded, std::vector<uint32_t> &out)
+    {
+        out.clear();
+        for (size_t i = 0; i + 3 <= folded.size(); ++i)
+        {
+            const char *p = folded.data() + i;
+            if (p[0] == '\n' || p[1] == '\n' || p[2] == '\n')
+                continue;
+            out.push_back(PackTrigram(p));
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    void TrigramIndex::AddPostings(uint32_t doc)
+    {
+        CollectTrigrams(m_docs[doc].text, m_scratch);
+        for (uint32_t trigram : m_scratch)
+        {
+            std::vector<uint32_t> &list = m_postings[trigram];
+            // New documents usually get the highest number, so this is nearly always an append
+            if (list.empty() || list.back() < doc)
+                list.push_back(doc);
+            else
+                list.insert(std::lower_bound(list.begin(), list.end(), doc), doc);
+        }
+    }
+
+    void TrigramIndex::RemovePostings(uint32_t doc)
+    {
+        CollectTrigrams(m_docs[doc].text, m_scratch);
+        for (uint32_t trigram : m_scratch)
+        {
+            auto found = m_postings.find(trigram);
+            if (found == m_postings.end())
+                continue;
+
+            std::vector<uint32_t> &list = found->second;
+            auto it = std::lower_bound(list.begin(), list.end(), doc);
+            if (it != list.end() && *it == doc)
+                list.erase(it);
+            if (list.empty())
+                m_postings.erase(found);
+        }
+    }
+
+    // <-- Updates -->
+    bool TrigramIndex::Upsert(uint64_t id, std::string_view text)
+    {
+        std::string folded;
+        Fold(text, folded);
+
+        auto existing = m_docOf.find(id);
+        if (existing != m_docOf.end())
+        {
+            Document &doc = m_docs[existing->second];
+            if (doc.text == folded)
+                return false;
+
+            RemovePostings(existing->second);
+            doc.text = std::move(folded);
+            AddPostings(existing->second);
+            return true;
+        }
+
+        uint32_t docNum;
+        if (!m_freeDocs.empty())
+        {
+            docNum = m_freeDocs.back();
+            m_freeDocs.pop_back();
+        }
+        else
+        {
+            docNum = (uint32_t)m_docs.size();
+            m_docs.emplace_back();
+        }
+
+        Document &doc = m_docs[docNum];
+        doc.id = id;
+        doc.text = std::move(folded);
+        doc.live = true;
+        m_docOf[id] = docNum;
+        AddPostings(docNum);
+        return true;
+    }
+
+    bool TrigramIndex::Remove(uint64_t id)
+    {
+        auto existing = m_docOf.find(id);
+        if (existing == m_docOf.end())
+            return false;
+
+        uint32_t docNum = existing->second;
+        RemovePostings(docNum);
+        m_docOf.erase(existing);
+
+        Document &doc = m_docs[docNum];
+        doc.live = false;
+        doc.text = std::string();
+        m_freeDocs.push_back(docNum);
+        return true;
+    }
+
+    void TrigramIndex::Clear()
+    {
+        m_docs.clear();
+        m_freeDocs.clear();
+        m_docOf.clear();
+        m_postings.clear();
+    }
+
+    void TrigramIndex::Reserve(size_t docs)
+    {
+        m_docs.reserve(docs);
+        m_docOf.reserve(docs);
+    }
+
+    void TrigramIndex::ShrinkToFit()
+    {
+        for (auto &entry : m_postings)
+            entry.second.shrink_to_fit();
+    }
+
+    // <-- Queries -->
+    void TrigramIndex::Search(std::string_view query, std::vector<uint64_t> &outIds) const
+    {
+        outIds.clear();
+
+        std::string folded;
+        Fold(query, folded);
+
+        std::vector<std::string_view> terms;
+        size_t pos = 0;
+        while (pos < folded.size())
+        {
+            size_t start = folded.find_first_not_of(" \t", pos);
+            if (start == std::string::npos)
+                break;
+            size_t end = folded.find_first_of(" \t", start);
+            if (end == std::string::npos)
+                end = folded.size();
+            terms.push_back(std::string_view(folded).substr(start, end - start));
+            pos = end;
+        }
+        if (terms.empty())
+            return;
+
+        // Posting lists for every trigram of every long-enough term
+        std::vector<const std::vector<uint32_t> *> lists;
+        for (std::string_view term : terms)
+        {
+            if (term.size() < 3)
+                continue;
+            CollectTrigrams(term, m_scratch);
+            for (uint32_t trigram : m_scratch)
+            {
+                auto found = m_postings.find(trigram);
+                if (found == m_postings.end())
+                    return; // A trigram nobody has: no matches
+                lists.push_back(&found->second);
+            }
+        }
+
+        auto matches = [&terms](const Document &doc)
+        {
+            for (std::string_view term : terms)
+            {
+                if (doc.text.find(term) == std::string::npos)
+                    return false;
+            }
+            return true;
+        };
+
+        if (lists.empty())
+        {
+            // Only one- and two-character terms
+            for (const Document &doc : m_docs)
+            {
+                if (doc.live && matches(doc))
+                    outIds.push_back(doc.id);
+            }
+            std::sort(outIds.begin(), outIds.end());
+            return;
+        }
+
+        // Intersect shortest first so the candidate set shrinks as fast as possible
+        std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t> *a, const std::vector<uint32_t> *b)
+                  { return a->size() < b->size(); });
+
+        std::vector<uint32_t> candidates(*lists[0]);
+        std::vector<uint32_t> next;
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+        {
+            const std::vector<uint32_t> &list = *lists[i];
+            next.clear();
+            if (candidates.size() * 16 < list.size())
+            {
+                // Much longer list: probe it instead of walking it
+                for (uint32_t doc : candidates)
+                {
+                    if (std::binary_search(list.begin(), list.end(), doc))
+                        next.push_back(doc);
+                }
+            }
+            else
+            {
+                std::set_intersection(candidates.begin(), candidates.end(), list.begin(), list.end(), std::back_inserter(next));
+            }
+            candidates.swap(next);
+        }
+
+        // Trigrams can match out of order, so confirm against the text
+        for (uint32_t doc : candidates)
+        {
+            if (matches(m_docs[doc]))
+                outIds.push_back(m_docs[doc].id);
+        }
+        std::sort(outIds.begin(), outIds.end());
+    }
+
+    bool TrigramIndex::Matches(std::string_view foldedText, std::string_view foldedQuery)
+    {
+        size_t pos = 0;
+        while (pos < foldedQuery.size())
+        {
+            size_t start = foldedQuery.find_first_not_of(" \t", pos);
+            if (start == std::string_view::npos)
+                break;
+            size_t end = foldedQuery.find_first_of(" \t", start);
+            if (end == std::string_view::npos)
+                end = foldedQuery.size();
+            if (foldedText.find(foldedQuery.substr(start, end - start)) == std::string_view::npos)
+                return false;
+            pos = end;
+        }
+        return true;
+    }
+
+    size_t TrigramIndex::MemoryBytes() const
+    {
+        size_t bytes = m_docs.capacity() * sizeof(Document) + m_freeDocs.capacity() * sizeof(uint32_t);
+        for (const Document &doc : m_docs)
+            bytes += doc.text.capacity() > 15 ? doc.text.capacity() + 1 : 0;
+
+        // Node + bucket estimate for the hash maps
+        bytes += m_docOf.size() * (sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(void *));
+        bytes += m_postings.size() * (sizeof(uint32_t) + sizeof(std::vector<uint32_t>) + 2 * sizeof(void *));
+        for (const auto &entry : m_postings)
+            bytes += entry.second.capacity() * sizeof(uint32_t);
+        return bytes;
+    }
+
+} // namespace Core
@@ -0,0 +1,63 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+    // <-- Trigram Index -->
+    // Full-text index over one text blob per game (fields separated by '\n').
+    // Every case-folded 3-byte window maps to a sorted posting list of document
+    // numbers. A query term of three or more characters is answered by
+    // intersecting the lists of its trigrams, shortest first, then checking the
+    // few survivors against the stored text; shorter terms fall back to a scan.
+    //
+    // Not thread-safe: LibrarySearch owns it on its worker thread.
+    class TrigramIndex
+    {
+    public:
+        // Returns false if the game was already indexed with this exact text
+        bool Upsert(uint64_t id, std::string_view text);
+        bool Remove(uint64_t id);
+        void Clear();
+        void Reserve(size_t docs);
+        void ShrinkToFit(); // After a bulk build; growth leaves lists up to half empty
+
+        // All whitespace-separated terms must occur (case-insensitive); ids come back sorted
+        void Search(std::string_view query, std::vector<uint64_t> &outIds) const;
+
+        // The same test for one text outside the index; both sides already Fold()ed
+        static bool Matches(std::string_view foldedText, std::string_view foldedQuery);
+        static void Fold(std::string_view in, std::string &out);
+
+        size_t Size() const { return m_docOf.size(); }
+        size_t MemoryBytes() const;
+
+    private:
+        struct Document
+        {
+            uint64_t id = 0;
+            std::string text; // Folded
+            bool live = false;
+        };
+
+        static void CollectTrigrams(std::string_view folded, std::vector<uint32_t> &out);
+        void AddPostings(uint32_t doc);
+        void RemovePostings(uint32_t doc);
+
+        std::vector<Document> m_docs;
+        std::vector<uint32_t> m_freeDocs;
+        std::unordered_map<uint64_t, uint32_t> m_docOf;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;
+
+        mutable std::vector<uint32_t> m_scratch; // Trigram buffer reused across calls
+    };
+
+} // namespace Core
+
+#endif // TRIGRAMINDEX_H
@@ -4,9 +4,6 @@
 #include "UI/Theme.h"
 #include "Core/GameLauncher.h"
 
-static Core::GameLauncher g_Launcher;
-static bool g_LauncherInitialized = false;
-
 constexpr int kTitleBarH = 0;
 constexpr int kRightPad = 8;
 
@@ -201,12 +198,6 @@ namespace UI
     {
         const ImGuiIO &io = ImGui::GetIO();
 
-        if (!g_LauncherInitialized)
-        {
-            g_Launcher.Initialize();
-            g_LauncherInitialized = true;
-        }
-
         ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
         ImGui::SetNextWindowSize(ImVec2(io.DisplaySize.x, io.DisplaySize.y));
 
@@ -219,7 +210,8 @@ namespace UI
                          ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse |
                          ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoBringToFrontOnFocus);
 
-        g_Launcher.RenderUI();
+        if (m_gameLauncher)
+            m_gameLauncher->RenderUI();
 
         ImGui::End();
         ImGui::PopStyleColor();
@@ -5,6 +5,7 @@ struct SDL_Window;
 typedef union SDL_Event SDL_Event;
 typedef void* SDL_GLContext;
 namespace Game { class GameState; }
+namespace Core { class GameLauncher; }
 
 #include <imgui.h>
 
@@ -27,6 +28,8 @@ public:
     void Render();
     void EndFrame();
 
+    void SetGameLauncher(Core::GameLauncher* launcher) { m_gameLauncher = launcher; }
+
 private:
 
     void RenderTitleBar(SDL_Window* window);
@@ -36,6 +39,8 @@ private:
     int m_titleBarSpacing = 0; 
 
     ImFont* m_titleFont = nullptr;
+
+    Core::GameLauncher* m_gameLauncher = nullptr;
 };
 
 } // namespace UI
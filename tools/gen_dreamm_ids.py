@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Builds DreammIdTable.h from data/dreamm_ids.txt.
+
+The table is a displacement ("hash and displace") perfect hash: a key's
+first hash picks a bucket, the bucket's seed picks its slot, and every
+slot holds at most one key. Lookups in GameDatabase.h are one seed read,
+one hash and one compare, all constexpr, so the table costs nothing at
+startup. HashDreammId below must match GameDatabase::HashDreammId.
+
+usage: gen_dreamm_ids.py <dreamm_ids.txt> <DreammIdTable.h>
+"""
+
+import sys
+
+MASK = 0xFFFFFFFF
+
+
+def hash_dreamm_id(key, seed):
+    h = (2166136261 ^ seed) & MASK
+    for byte in key.encode('utf-8'):
+        h = ((h ^ byte) * 16777619) & MASK
+    h ^= h >> 15
+    h = (h * 0x2C1B3C6D) & MASK
+    h ^= h >> 12
+    return h
+
+
+def read_entries(path):
+    entries = []
+    seen = set()
+    with open(path, encoding='utf-8') as source:
+        for number, line in enumerate(source, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            key, sep, title = line.partition('|')
+            key, title = key.strip(), title.strip()
+            if not sep or not key or not title:
+                sys.exit(f'{path}:{number}: expected id|title')
+            if key in seen:
+                sys.exit(f'{path}:{number}: duplicate id {key}')
+            seen.add(key)
+            entries.append((key, title))
+    return entries
+
+
+def build(entries):
+    slots = 1
+    while slots < len(entries):
+        slots *= 2
+    buckets = max(1, slots // 4)
+
+    grouped = [[] for _ in range(buckets)]
+    for key, title in entries:
+        grouped[hash_dreamm_id(key, 0) % buckets].append((key, title))
+
+    seeds = [0] * buckets
+    table = [None] * slots
+    # Biggest buckets first, while the table is emptiest
+    for bucket in sorted(range(buckets), key=lambda b: -len(grouped[b])):
+        members = grouped[bucket]
+        if not members:
+            continue
+        for seed in range(1, 1 << 20):
+            chosen = [hash_dreamm_id(key, seed) % slots for key, _ in members]
+            if len(set(chosen)) == len(chosen) and all(table[s] is None for s in chosen):
+                break
+        else:
+            sys.exit('no displacement found; grow the table')
+        seeds[bucket] = seed
+        for slot, entry in zip(chosen, members):
+            table[slot] = entry
+    return seeds, table
+
+
+def literal(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    entries = read_entries(sys.argv[1])
+    seeds, table = build(entries)
+
+    lines = [
+        '// Generated by tools/gen_dreamm_ids.py from data/dreamm_ids.txt; do not edit.',
+        '#ifndef DREAMMIDTABLE_H',
+        '#define DREAMMIDTABLE_H',
+        '',
+        '#include <cstdint>',
+        '#include <string_view>',
+        '',
+        'namespace Core',
+        '{',
+        '    struct DreammIdSlot',
+        '    {',
+        '        std::string_view id; // Empty for an unused slot',
+        '        std::string_view title;',
+        '    };',
+        '',
+        f'    inline constexpr uint32_t DREAMM_ID_COUNT = {len(entries)};',
+        f'    inline constexpr uint32_t DREAMM_ID_BUCKETS = {len(seeds)};',
+        f'    inline constexpr uint32_t DREAMM_ID_SLOTS = {len(table)};',
+        '',
+        '    inline constexpr uint32_t DREAMM_ID_SEEDS[DREAMM_ID_BUCKETS] = {',
+    ]
+    for start in range(0, len(seeds), 12):
+        lines.append('        ' + ', '.join(str(s) for s in seeds[start:start + 12]) + ',')
+    lines.append('    };')
+    lines.append('')
+    lines.append('    inline constexpr DreammIdSlot DREAMM_ID_TABLE[DREAMM_ID_SLOTS] = {')
+    for entry in table:
+        if entry is None:
+            lines.append('        {},')
+        else:
+            lines.append(f'        {{{literal(entry[0])}, {literal(entry[1])}}},')
+    lines += [
+        '    };',
+        '',
+        '} // namespace Core',
+        '',
+        '#endif // DREAMMIDTABLE_H',
+        '',
+    ]
+
+    with open(sys.argv[2], 'w', encoding='utf-8', newline='\n') as header:
+        header.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    main()